@@ -0,0 +1,132 @@
+#include "allocationcounter.h"
+
+#if defined(RGD_COUNT_ALLOCATIONS)
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+thread_local quint64 allocationCount = 0;
+}
+
+// glibc 下直接接管 malloc 系列：Qt 容器（QArrayData）绕过 operator new 直接调用 malloc，
+// 只替换 operator new 会漏掉 QVector/QString 的分配。其他平台只统计 operator new
+#if defined(__GLIBC__)
+
+extern "C" {
+
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *p, std::size_t size);
+void __libc_free(void *p);
+
+void *malloc(std::size_t size)
+{
+    ++allocationCount;
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size)
+{
+    ++allocationCount;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, std::size_t size)
+{
+    ++allocationCount;
+    return __libc_realloc(p, size);
+}
+
+void free(void *p)
+{
+    __libc_free(p);
+}
+
+} // extern "C"
+
+#define RGD_COUNT_IN_OPERATOR_NEW 0
+#else
+#define RGD_COUNT_IN_OPERATOR_NEW 1
+#endif
+
+void *operator new(std::size_t size)
+{
+#if RGD_COUNT_IN_OPERATOR_NEW
+    ++allocationCount;
+#endif
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+#if RGD_COUNT_IN_OPERATOR_NEW
+    ++allocationCount;
+#endif
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace AllocationCounter {
+
+bool isEnabled()
+{
+    return true;
+}
+
+quint64 threadAllocations()
+{
+    return allocationCount;
+}
+
+} // namespace AllocationCounter
+
+#else
+
+namespace AllocationCounter {
+
+bool isEnabled()
+{
+    return false;
+}
+
+quint64 threadAllocations()
+{
+    return 0;
+}
+
+} // namespace AllocationCounter
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+// 堆分配计数：CMake 选项 RGD_COUNT_ALLOCATIONS 打开时替换全局 operator new，按线程计数
+// 未打开时 isEnabled() 返回 false，计数恒为 0，不影响正常构建的性能
+namespace AllocationCounter {
+
+bool isEnabled();
+quint64 threadAllocations();        // 当前线程累计的分配次数
+
+} // namespace AllocationCounter
+
+// 统计一段代码内当前线程的分配次数
+class AllocationScope
+{
+public:
+    AllocationScope() : start(AllocationCounter::threadAllocations()) {}
+    quint64 allocations() const { return AllocationCounter::threadAllocations() - start; }
+
+private:
+    quint64 start;
+};
+
+#endif // ALLOCATIONCOUNTER_H
@@ -0,0 +1,78 @@
+#ifndef ANALYSISPLUGIN_H
+#define ANALYSISPLUGIN_H
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QtPlugin>
+
+// 分析插件接口：插件编译为共享库放在程序目录的 plugins 子目录下，启动分析时由 QPluginLoader 加载
+// 插件只看到只读的帧数据、基线和参数，按帧计算若干指标；程序把整段采集切成连续的帧块，
+// 在线程池中并行调用 processFrames，再调用 summarize 得到整段采集的结果
+//
+// 编写插件：
+//     class MyPlugin : public QObject, public AnalysisPlugin
+//     {
+//         Q_OBJECT
+//         Q_PLUGIN_METADATA(IID AnalysisPlugin_iid)
+//         Q_INTERFACES(AnalysisPlugin)
+//     public:
+//         ...
+//     };
+//
+// 接口有不兼容的修改时 IID 中的版本号随之增加，旧插件不会被加载
+
+// 整段分析共用的只读信息
+struct AnalysisContext
+{
+    int rxCount;                     // 每帧按 tx 行、rx 列排列，共 rxCount * txCount 个节点
+    int txCount;
+    int frameCount;                  // 整段采集的帧数
+    const qint16 *baseline;          // 基线（rxCount * txCount 个值），没有读取基线时为 nullptr
+    int signalCalcMode;              // 信号计算方式：0 = base-raw，1 = raw-base（与主界面相同，按 16 位回绕）
+    QJsonObject parameters;          // 主界面当前的参数（与 config.json 中的键相同）
+};
+
+// 一段连续的帧：第 i 帧（0 <= i < frameCount）从 frames + i * frameSize 开始
+struct AnalysisBlock
+{
+    const qint16 *frames;
+    int frameSize;
+    int firstFrame;                  // 第一帧在整段采集中的序号
+    int frameCount;
+};
+
+class AnalysisPlugin
+{
+public:
+    virtual ~AnalysisPlugin() {}
+
+    virtual QString name() const = 0;
+    virtual QString description() const { return QString(); }
+
+    // 每帧输出的指标名称，顺序即 processFrames 中每帧结果的顺序
+    virtual QStringList metricNames() const = 0;
+
+    // 计算一个帧块的指标：results 共 block.frameCount * metricNames().size() 个值，按帧依次存放
+    // 不同的帧块会在多个线程中同时调用，实现不能修改插件自身的状态
+    virtual void processFrames(const AnalysisContext &context, const AnalysisBlock &block, double *results) const = 0;
+
+    // 整段采集的结果：perFrame 为所有帧的结果（排列同 processFrames），summary 每个指标一个值
+    // 默认取每个指标所有帧的平均值
+    virtual void summarize(const AnalysisContext &context, const double *perFrame, double *summary) const
+    {
+        const int metrics = metricNames().size();
+        for (int m = 0; m < metrics; ++m) {
+            double sum = 0.0;
+            for (int i = 0; i < context.frameCount; ++i) {
+                sum += perFrame[qint64(i) * metrics + m];
+            }
+            summary[m] = context.frameCount > 0 ? sum / context.frameCount : 0.0;
+        }
+    }
+};
+
+#define AnalysisPlugin_iid "com.rgd.fae.AnalysisPlugin/1.0"
+Q_DECLARE_INTERFACE(AnalysisPlugin, AnalysisPlugin_iid)
+
+#endif // ANALYSISPLUGIN_H
@@ -0,0 +1,172 @@
+#include "analysispluginhost.h"
+#include "framestore.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QLibrary>
+#include <QPluginLoader>
+#include <QtConcurrent>
+#include <limits>
+
+// 每个帧块最多的帧数：小面板时一个存储块有上千帧，再切小一些让各线程负载均衡
+static const int kMaxBlockFrames = 1024;
+
+namespace {
+
+// 内置插件：每帧的信号最大值、最小值、超过信号阈值的节点数和信号总和
+class SignalStatsPlugin : public AnalysisPlugin
+{
+public:
+    QString name() const override { return QCoreApplication::translate("AnalysisPluginHost", "信号统计（内置）"); }
+
+    QString description() const override
+    {
+        return QCoreApplication::translate("AnalysisPluginHost",
+            "每帧的信号最大值、最小值、超过信号阈值的节点数和信号总和；没有基线时按原始值统计");
+    }
+
+    QStringList metricNames() const override
+    {
+        return QStringList() << QCoreApplication::translate("AnalysisPluginHost", "最大信号")
+                             << QCoreApplication::translate("AnalysisPluginHost", "最小信号")
+                             << QCoreApplication::translate("AnalysisPluginHost", "超阈值节点数")
+                             << QCoreApplication::translate("AnalysisPluginHost", "信号总和");
+    }
+
+    void processFrames(const AnalysisContext &context, const AnalysisBlock &block, double *results) const override
+    {
+        const int threshold = context.parameters.value(QStringLiteral("signal_threshold")).toInt();
+        for (int f = 0; f < block.frameCount; ++f) {
+            const qint16 *frame = block.frames + qint64(f) * block.frameSize;
+            int high = std::numeric_limits<int>::min();
+            int low = std::numeric_limits<int>::max();
+            int above = 0;
+            qint64 sum = 0;
+            for (int i = 0; i < block.frameSize; ++i) {
+                int value = frame[i];
+                if (context.baseline) {
+                    value = (context.signalCalcMode == 0) ? qint16(context.baseline[i] - frame[i])
+                                                          : qint16(frame[i] - context.baseline[i]);
+                }
+                high = qMax(high, value);
+                low = qMin(low, value);
+                above += (value > threshold) ? 1 : 0;
+                sum += value;
+            }
+            double *out = results + qint64(f) * 4;
+            out[0] = high;
+            out[1] = low;
+            out[2] = above;
+            out[3] = double(sum);
+        }
+    }
+
+    // 最大、最小值取整段的最值，其余取平均
+    void summarize(const AnalysisContext &context, const double *perFrame, double *summary) const override
+    {
+        AnalysisPlugin::summarize(context, perFrame, summary);
+        if (context.frameCount <= 0) {
+            return;
+        }
+        summary[0] = perFrame[0];
+        summary[1] = perFrame[1];
+        for (int i = 1; i < context.frameCount; ++i) {
+            summary[0] = qMax(summary[0], perFrame[qint64(i) * 4]);
+            summary[1] = qMin(summary[1], perFrame[qint64(i) * 4 + 1]);
+        }
+    }
+};
+
+} // namespace
+
+AnalysisPluginHost::AnalysisPluginHost()
+    : builtin(new SignalStatsPlugin)
+{
+    plugins.append(builtin.get());
+}
+
+AnalysisPluginHost::~AnalysisPluginHost()
+{
+    // 插件实例归 QPluginLoader 的根组件所有，这里不卸载共享库，避免仍在使用的代码被卸载
+    qDeleteAll(loaders);
+}
+
+QString AnalysisPluginHost::defaultDirectory()
+{
+    return QDir(QCoreApplication::applicationDirPath()).filePath(QStringLiteral("plugins"));
+}
+
+void AnalysisPluginHost::loadPlugins(const QString &directory)
+{
+    QDir dir(directory);
+    if (!dir.exists()) {
+        return;
+    }
+
+    for (const QString &fileName : dir.entryList(QDir::Files, QDir::Name)) {
+        const QString filePath = dir.absoluteFilePath(fileName);
+        if (!QLibrary::isLibrary(filePath) || loadedFiles.contains(filePath)) {
+            continue;
+        }
+        loadedFiles.append(filePath);
+
+        QPluginLoader *loader = new QPluginLoader(filePath);
+        QObject *instance = loader->instance();
+        if (!instance) {
+            loadErrors.append(QCoreApplication::translate("AnalysisPluginHost", "%1: %2")
+                              .arg(fileName, loader->errorString()));
+            delete loader;
+            continue;
+        }
+
+        const AnalysisPlugin *analysis = qobject_cast<AnalysisPlugin *>(instance);
+        if (!analysis) {
+            loadErrors.append(QCoreApplication::translate("AnalysisPluginHost", "%1: 不是分析插件（接口版本 %2）")
+                              .arg(fileName, QStringLiteral(AnalysisPlugin_iid)));
+            loader->unload();
+            delete loader;
+            continue;
+        }
+        loaders.append(loader);
+        plugins.append(analysis);
+    }
+}
+
+AnalysisRunResult AnalysisPluginHost::run(const AnalysisPlugin &plugin, const FrameStore &frames,
+                                          const AnalysisContext &context)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    AnalysisRunResult result;
+    result.pluginName = plugin.name();
+    result.metrics = plugin.metricNames();
+    const int metricCount = result.metrics.size();
+    const int frameSize = frames.frameSize();
+    if (metricCount == 0 || frames.isEmpty() || frameSize != context.rxCount * context.txCount) {
+        return result;
+    }
+
+    AnalysisContext runContext = context;
+    runContext.frameCount = frames.frameCount();
+
+    // 帧块不跨越存储块，块内的帧在内存中连续
+    QVector<AnalysisBlock> blocks;
+    for (int index = 0; index < runContext.frameCount;) {
+        const int count = qMin(frames.contiguousFrames(index), kMaxBlockFrames);
+        blocks.append(AnalysisBlock{frames.frame(index), frameSize, index, count});
+        index += count;
+    }
+
+    result.frameCount = runContext.frameCount;
+    result.perFrame.resize(result.frameCount * metricCount);
+    double *perFrame = result.perFrame.data();
+    QtConcurrent::blockingMap(blocks, [&](const AnalysisBlock &block) {
+        plugin.processFrames(runContext, block, perFrame + qint64(block.firstFrame) * metricCount);
+    });
+
+    result.summary.resize(metricCount);
+    plugin.summarize(runContext, result.perFrame.constData(), result.summary.data());
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
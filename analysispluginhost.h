@@ -0,0 +1,52 @@
+#ifndef ANALYSISPLUGINHOST_H
+#define ANALYSISPLUGINHOST_H
+
+#include <QVector>
+#include <QStringList>
+#include <memory>
+#include "analysisplugin.h"
+
+class FrameStore;
+class QPluginLoader;
+
+// 一次分析的结果
+struct AnalysisRunResult
+{
+    QString pluginName;
+    QStringList metrics;
+    QVector<double> perFrame;        // frameCount * metrics.size() 个值，按帧依次存放
+    QVector<double> summary;         // 每个指标一个值
+    int frameCount = 0;
+    qint64 elapsedMs = 0;
+
+    bool isValid() const { return !metrics.isEmpty() && frameCount > 0; }
+    double value(int frame, int metric) const { return perFrame[qint64(frame) * metrics.size() + metric]; }
+};
+
+// 分析插件的加载和调度：内置插件之外，从插件目录加载实现了 AnalysisPlugin 的共享库
+class AnalysisPluginHost
+{
+public:
+    AnalysisPluginHost();
+    ~AnalysisPluginHost();
+
+    // 加载目录下的所有插件；已加载的文件不会重复加载，无法加载的文件记入 errors()
+    void loadPlugins(const QString &directory);
+    static QString defaultDirectory();   // 程序目录下的 plugins
+
+    int count() const { return plugins.size(); }
+    const AnalysisPlugin *plugin(int index) const { return plugins[index]; }
+    const QStringList &errors() const { return loadErrors; }
+
+    // 按连续的帧块切分整段采集，在全局线程池中并行计算，再汇总为整段的结果（在调用线程中阻塞执行）
+    static AnalysisRunResult run(const AnalysisPlugin &plugin, const FrameStore &frames, const AnalysisContext &context);
+
+private:
+    std::unique_ptr<AnalysisPlugin> builtin;
+    QVector<QPluginLoader *> loaders;
+    QVector<const AnalysisPlugin *> plugins;
+    QStringList loadedFiles;
+    QStringList loadErrors;
+};
+
+#endif // ANALYSISPLUGINHOST_H
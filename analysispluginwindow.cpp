@@ -0,0 +1,256 @@
+#include "analysispluginwindow.h"
+#include "nodeseriesplot.h"
+#include <QComboBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QHideEvent>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QTextStream>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+#include <cmath>
+
+AnalysisPluginWindow::AnalysisPluginWindow(QWidget *parent)
+    : QWidget(parent, Qt::Window)
+    , context()
+    , watcher(nullptr)
+{
+    setWindowTitle(tr("分析插件"));
+    resize(1100, 460);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    QHBoxLayout *toolLayout = new QHBoxLayout;
+    toolLayout->addWidget(new QLabel(tr("插件:"), this));
+    pluginComboBox = new QComboBox(this);
+    pluginComboBox->setMinimumWidth(200);
+    toolLayout->addWidget(pluginComboBox);
+    runButton = new QPushButton(tr("运行"), this);
+    toolLayout->addWidget(runButton);
+    exportButton = new QPushButton(tr("导出每帧结果"), this);
+    exportButton->setEnabled(false);
+    toolLayout->addWidget(exportButton);
+    toolLayout->addStretch();
+    statusLabel = new QLabel(this);
+    toolLayout->addWidget(statusLabel);
+    mainLayout->addLayout(toolLayout);
+
+    descriptionLabel = new QLabel(this);
+    descriptionLabel->setWordWrap(true);
+    mainLayout->addWidget(descriptionLabel);
+
+    QHBoxLayout *viewsLayout = new QHBoxLayout;
+    summaryTable = new QTableWidget(0, 3, this);
+    summaryTable->setHorizontalHeaderLabels(QStringList() << tr("指标") << tr("整段结果") << tr("最大值所在帧"));
+    summaryTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+    summaryTable->setSelectionMode(QAbstractItemView::SingleSelection);
+    summaryTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    summaryTable->verticalHeader()->setVisible(false);
+    summaryTable->horizontalHeader()->setStretchLastSection(true);
+    viewsLayout->addWidget(summaryTable, 2);
+    metricPlot = new NodeSeriesPlot(this);
+    metricPlot->setToolTip(tr("滚轮缩放，拖动平移，双击显示全部帧，单击跳到该帧"));
+    viewsLayout->addWidget(metricPlot, 3);
+    mainLayout->addLayout(viewsLayout, 1);
+
+    connect(pluginComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &AnalysisPluginWindow::onPluginChanged);
+    connect(runButton, &QPushButton::clicked, this, &AnalysisPluginWindow::onRunClicked);
+    connect(exportButton, &QPushButton::clicked, this, &AnalysisPluginWindow::onExportClicked);
+    connect(summaryTable, &QTableWidget::itemSelectionChanged, this, &AnalysisPluginWindow::onMetricSelected);
+    connect(summaryTable, &QTableWidget::cellDoubleClicked, this, &AnalysisPluginWindow::onMetricActivated);
+    connect(metricPlot, &NodeSeriesPlot::frameSelected, this, &AnalysisPluginWindow::frameRequested);
+
+    refreshPlugins();
+}
+
+AnalysisPluginWindow::~AnalysisPluginWindow()
+{
+    if (watcher) {
+        watcher->waitForFinished();
+    }
+}
+
+void AnalysisPluginWindow::setSource(const FrameStore &source, const QVector<qint16> &baseline, int calcMode,
+                                     int rx, int tx, const QJsonObject &parameters)
+{
+    frames = source;
+    baselineData = baseline;
+    context.rxCount = rx;
+    context.txCount = tx;
+    context.frameCount = frames.frameCount();
+    context.baseline = nullptr;
+    context.signalCalcMode = calcMode;
+    context.parameters = parameters;
+    refreshPlugins();
+}
+
+void AnalysisPluginWindow::releaseFrames()
+{
+    frames = FrameStore();
+}
+
+void AnalysisPluginWindow::shareFrames(const FrameStore &source)
+{
+    frames = source;
+}
+
+void AnalysisPluginWindow::hideEvent(QHideEvent *event)
+{
+    // 关闭后不再持有帧数据（后台任务有自己的副本），重新打开时页面会重新设置；最小化时保留
+    if (!event->spontaneous()) {
+        releaseFrames();
+    }
+    QWidget::hideEvent(event);
+}
+
+void AnalysisPluginWindow::refreshPlugins()
+{
+    host.loadPlugins(AnalysisPluginHost::defaultDirectory());
+    for (int i = pluginComboBox->count(); i < host.count(); ++i) {
+        pluginComboBox->addItem(host.plugin(i)->name());
+    }
+
+    // 无法加载的文件在状态栏提示，详细原因放在提示文字中
+    if (!host.errors().isEmpty() && !watcher) {
+        statusLabel->setText(tr("有 %1 个插件无法加载").arg(host.errors().size()));
+        statusLabel->setToolTip(host.errors().join('\n'));
+    }
+}
+
+void AnalysisPluginWindow::onPluginChanged(int index)
+{
+    if (index < 0 || index >= host.count()) {
+        descriptionLabel->clear();
+        return;
+    }
+    const AnalysisPlugin *plugin = host.plugin(index);
+    descriptionLabel->setText(tr("指标: %1%2").arg(plugin->metricNames().join(QStringLiteral("、")),
+        plugin->description().isEmpty() ? QString() : QStringLiteral("\n") + plugin->description()));
+}
+
+void AnalysisPluginWindow::onRunClicked()
+{
+    const int index = pluginComboBox->currentIndex();
+    if (watcher || index < 0 || index >= host.count()) {
+        return;
+    }
+    if (frames.isEmpty() || frames.frameSize() != context.rxCount * context.txCount) {
+        QMessageBox::warning(this, tr("参数错误"), tr("没有数据，或 RX × TX 与数据的节点数不一致！"));
+        return;
+    }
+
+    // 帧存储和基线在后台线程中各保留一份（隐式共享），主界面重新读取数据不影响本次分析
+    const AnalysisPlugin *plugin = host.plugin(index);
+    const FrameStore source = frames;
+    const QVector<qint16> baseline = (baselineData.size() == frames.frameSize()) ? baselineData : QVector<qint16>();
+    const AnalysisContext runContext = context;
+    watcher = new QFutureWatcher<AnalysisRunResult>(this);
+    connect(watcher, &QFutureWatcher<AnalysisRunResult>::finished, this, &AnalysisPluginWindow::onRunFinished);
+    watcher->setFuture(QtConcurrent::run([plugin, source, baseline, runContext]() {
+        AnalysisContext threadContext = runContext;
+        threadContext.baseline = baseline.isEmpty() ? nullptr : baseline.constData();
+        return AnalysisPluginHost::run(*plugin, source, threadContext);
+    }));
+
+    runButton->setEnabled(false);
+    pluginComboBox->setEnabled(false);
+    statusLabel->setText(tr("正在分析..."));
+}
+
+void AnalysisPluginWindow::onRunFinished()
+{
+    result = watcher->result();
+    watcher->deleteLater();
+    watcher = nullptr;
+    runButton->setEnabled(true);
+    pluginComboBox->setEnabled(true);
+    exportButton->setEnabled(result.isValid());
+
+    summaryTable->setRowCount(0);
+    metricPlot->clearSeries();
+    if (!result.isValid()) {
+        statusLabel->setText(tr("分析失败"));
+        return;
+    }
+
+    summaryTable->setRowCount(result.metrics.size());
+    for (int m = 0; m < result.metrics.size(); ++m) {
+        summaryTable->setItem(m, 0, new QTableWidgetItem(result.metrics[m]));
+        summaryTable->setItem(m, 1, new QTableWidgetItem(QString::number(result.summary[m], 'g', 8)));
+        const int frame = peakFrame(m);
+        summaryTable->setItem(m, 2, new QTableWidgetItem(tr("第 %1 帧（%2）").arg(frame + 1)
+                                                         .arg(result.value(frame, m), 0, 'g', 8)));
+    }
+    summaryTable->resizeColumnsToContents();
+    summaryTable->selectRow(0);
+
+    statusLabel->setToolTip(QString());
+    statusLabel->setText(tr("%1: %2 帧，耗时 %3 ms").arg(result.pluginName).arg(result.frameCount).arg(result.elapsedMs));
+}
+
+int AnalysisPluginWindow::peakFrame(int metric) const
+{
+    int best = 0;
+    for (int i = 1; i < result.frameCount; ++i) {
+        if (result.value(i, metric) > result.value(best, metric)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+void AnalysisPluginWindow::onMetricSelected()
+{
+    const QList<QTableWidgetItem *> selected = summaryTable->selectedItems();
+    if (selected.isEmpty() || !result.isValid()) {
+        return;
+    }
+
+    // 曲线以整数绘制，超出 int 范围的值截断
+    const int metric = selected.first()->row();
+    QVector<int> series(result.frameCount);
+    for (int i = 0; i < result.frameCount; ++i) {
+        const double value = result.value(i, metric);
+        series[i] = std::isfinite(value) ? int(qBound(-2147483647.0, std::round(value), 2147483647.0)) : 0;
+    }
+    metricPlot->setSeries(series);
+    metricPlot->setLabel(result.metrics[metric]);
+}
+
+void AnalysisPluginWindow::onMetricActivated(int row)
+{
+    if (result.isValid() && row >= 0 && row < result.metrics.size()) {
+        emit frameRequested(peakFrame(row));
+    }
+}
+
+void AnalysisPluginWindow::onExportClicked()
+{
+    if (!result.isValid()) {
+        return;
+    }
+    const QString fileName = QFileDialog::getSaveFileName(this, tr("导出每帧结果"), QStringLiteral("analysis.csv"),
+                                                          tr("CSV 文件 (*.csv)"));
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::warning(this, tr("导出失败"), tr("无法写入文件: %1").arg(fileName));
+        return;
+    }
+    QTextStream out(&file);
+    out << tr("帧") << ',' << result.metrics.join(',') << '\n';
+    for (int i = 0; i < result.frameCount; ++i) {
+        out << (i + 1);
+        for (int m = 0; m < result.metrics.size(); ++m) {
+            out << ',' << QString::number(result.value(i, m), 'g', 10);
+        }
+        out << '\n';
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef ANALYSISPLUGINWINDOW_H
+#define ANALYSISPLUGINWINDOW_H
+
+#include <QWidget>
+#include <QVector>
+#include <QFutureWatcher>
+#include <QJsonObject>
+#include "analysispluginhost.h"
+#include "framestore.h"
+
+class NodeSeriesPlot;
+class QComboBox;
+class QHideEvent;
+class QLabel;
+class QPushButton;
+class QTableWidget;
+
+// 分析插件窗口：选择内置或插件目录中的分析插件，对整段采集后台并行计算，
+// 左侧列出每个指标的整段结果，选中指标后右侧显示它在每一帧上的曲线；单击曲线或双击指标让主界面跳到对应帧
+class AnalysisPluginWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit AnalysisPluginWindow(QWidget *parent = nullptr);
+    ~AnalysisPluginWindow();
+
+    // 设置分析的数据（帧存储为隐式共享，复制开销很小）；同时重新扫描插件目录中新增的插件
+    void setSource(const FrameStore &frames, const QVector<qint16> &baseline, int calcMode,
+                   int rx, int tx, const QJsonObject &parameters);
+
+    // 页面换出冷数据前放下帧存储的副本，换出后再共享内容相同的帧存储，原来的数据块才能释放
+    void releaseFrames();
+    void shareFrames(const FrameStore &source);
+
+signals:
+    void frameRequested(int frame);
+
+protected:
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void onRunClicked();
+    void onRunFinished();
+    void onExportClicked();
+    void onPluginChanged(int index);
+    void onMetricSelected();
+    void onMetricActivated(int row);
+
+private:
+    void refreshPlugins();
+    int peakFrame(int metric) const;
+
+    AnalysisPluginHost host;
+    FrameStore frames;
+    QVector<qint16> baselineData;
+    AnalysisContext context;
+    AnalysisRunResult result;
+    QFutureWatcher<AnalysisRunResult> *watcher;
+
+    QComboBox *pluginComboBox;
+    QPushButton *runButton;
+    QPushButton *exportButton;
+    QLabel *statusLabel;
+    QLabel *descriptionLabel;
+    QTableWidget *summaryTable;
+    NodeSeriesPlot *metricPlot;
+};
+
+#endif // ANALYSISPLUGINWINDOW_H
@@ -1,7 +1,7 @@
 #include "arona.h"
 #include "./ui_arona.h"
 #include "functionpage.h"
-#include <QPixmap>
+#include "imagescaler.h"
 #include <QPalette>
 #include <QResizeEvent>
 #include <QShowEvent>
@@ -9,6 +9,8 @@
 arona::arona(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::arona)
+    , backgroundScaler(new ImageScaler(this))
+    , appliedBackgroundKey(0)
     , functionPage(nullptr)
     , backgroundImageInitialized(false)
 {
@@ -19,37 +21,46 @@ arona::arona(QWidget *parent)
 
     // 加载背景图片（但不立即设置）
     setBackgroundImage();
+    connect(backgroundScaler, &ImageScaler::scaled, this, &arona::onBackgroundScaled);
 
-    // 创建功能页面并添加到 StackedWidget
-    functionPage = new FunctionPage(this);
-    ui->stackedWidget->addWidget(functionPage);
-
-    // 连接信号槽
+    // 功能页面（加载配置、建立表格和所有信号连接）推迟到第一次点击"开始"时创建，主窗口先显示
     connect(ui->startButton, &QPushButton::clicked, this, &arona::onStartButtonClicked);
-    connect(functionPage, &FunctionPage::backToMainPage, this, &arona::showMainPage);
 }
 
 void arona::setBackgroundImage()
 {
-    // 加载原始背景图片
-    originalBackground = QPixmap(":/images/images/back_1.png");
+    // 加载原始背景图片（保存为 QImage，可以在工作线程中缩放）
+    backgroundScaler->setSource(QImage(":/images/images/back_1.png"));
 }
 
 void arona::updateBackgroundImage()
 {
-    if (originalBackground.isNull() || !ui->mainPage) {
+    if (!backgroundScaler->hasSource() || !ui->mainPage) {
         return;
     }
 
-    // 根据当前窗口大小缩放背景图
-    QPixmap scaledBackground = originalBackground.scaled(
-        ui->mainPage->size(),
-        Qt::IgnoreAspectRatio,
-        Qt::SmoothTransformation);
+    // 已缓存的尺寸直接使用平滑缩放的结果，否则先显示快速预览
+    applyBackground(backgroundScaler->request(ui->mainPage->size()));
+}
 
-    // 创建调色板并设置背景图
-    QPalette palette;
-    palette.setBrush(QPalette::Window, QBrush(scaledBackground));
+void arona::onBackgroundScaled(const QSize &size, const QPixmap &pixmap)
+{
+    // 缩放期间窗口尺寸又变了，新尺寸会由缩放服务重新处理
+    if (ui->mainPage->size() == size) {
+        applyBackground(pixmap);
+    }
+}
+
+void arona::applyBackground(const QPixmap &pixmap)
+{
+    if (pixmap.isNull() || pixmap.cacheKey() == appliedBackgroundKey) {
+        return;
+    }
+    appliedBackgroundKey = pixmap.cacheKey();
+
+    // 在现有调色板上替换背景图
+    QPalette palette = ui->mainPage->palette();
+    palette.setBrush(QPalette::Window, QBrush(pixmap));
 
     // 应用到主页面
     ui->mainPage->setAutoFillBackground(true);
@@ -59,15 +70,17 @@ void arona::updateBackgroundImage()
 void arona::resizeEvent(QResizeEvent *event)
 {
     QMainWindow::resizeEvent(event);
-    // 窗口大小改变时更新背景图
-    updateBackgroundImage();
+    // 窗口大小改变时更新背景图（功能页面显示时主页面不可见，等切换回来再更新）
+    if (ui->stackedWidget->currentIndex() == 0) {
+        updateBackgroundImage();
+    }
 }
 
 void arona::showEvent(QShowEvent *event)
 {
     QMainWindow::showEvent(event);
     // 首次显示时设置背景图
-    if (!backgroundImageInitialized && !originalBackground.isNull()) {
+    if (!backgroundImageInitialized && backgroundScaler->hasSource()) {
         updateBackgroundImage();
         backgroundImageInitialized = true;
     }
@@ -75,6 +88,12 @@ void arona::showEvent(QShowEvent *event)
 
 void arona::onStartButtonClicked()
 {
+    if (!functionPage) {
+        functionPage = new FunctionPage(this);
+        ui->stackedWidget->addWidget(functionPage);
+        connect(functionPage, &FunctionPage::backToMainPage, this, &arona::showMainPage);
+    }
+
     // 切换到功能页面 (索引1)
     ui->stackedWidget->setCurrentIndex(1);
 }
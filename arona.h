@@ -2,6 +2,7 @@
 #define ARONA_H
 
 #include <QMainWindow>
+#include <QPixmap>
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -10,6 +11,7 @@ class arona;
 QT_END_NAMESPACE
 
 class FunctionPage;
+class ImageScaler;
 
 class arona : public QMainWindow
 {
@@ -26,13 +28,16 @@ protected:
 private slots:
     void onStartButtonClicked();
     void showMainPage();
+    void onBackgroundScaled(const QSize &size, const QPixmap &pixmap);
 
 private:
     void setBackgroundImage();
     void updateBackgroundImage();
+    void applyBackground(const QPixmap &pixmap);
     Ui::arona *ui;
-    QPixmap originalBackground;
-    FunctionPage *functionPage;
+    ImageScaler *backgroundScaler;           // 背景图缩放（拖动时快速预览，停下后后台平滑缩放并缓存）
+    qint64 appliedBackgroundKey;             // 当前调色板中背景图的 cacheKey，相同时不重建调色板
+    FunctionPage *functionPage;              // 首次点击"开始"时创建
     bool backgroundImageInitialized;
 };
 #endif // ARONA_H
@@ -0,0 +1,214 @@
+#include "baselinebuilder.h"
+#include "framestore.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QtConcurrent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const int kNodeBlock = 64;             // 每个并行任务处理的节点数
+const double kMadScale = 1.4826;       // 正态分布下 MAD 换算为标准差
+const double kOutlierSigma = 3.5;      // 帧的异常阈值（稳健标准差的倍数）
+const double kBadNodeSigma = 8.0;      // 节点的异常阈值（面板稳健标准差的倍数）
+const double kNoisyFactor = 5.0;       // 噪声超过节点噪声中值的倍数判为噪声异常
+const int kMaxListedNodes = 8;         // 摘要中每类最多列出的节点数
+
+// values 的中值（会打乱 values 的顺序）
+double medianOf(int *values, int count)
+{
+    int *middle = values + count / 2;
+    std::nth_element(values, middle, values + count);
+    if (count % 2 == 1) {
+        return *middle;
+    }
+    const int lower = *std::max_element(values, middle);
+    return (double(lower) + *middle) / 2.0;
+}
+
+// 一块节点：先把各帧中这些节点的值转置为按节点连续，再逐节点统计
+void processNodes(const FrameStore &frames, int firstFrame, int frameCount, BaselineBuilder::Method method,
+                  int nodeBegin, int nodeEnd, qint16 *baseline, float *noise, qint64 *outliers)
+{
+    const int count = nodeEnd - nodeBegin;
+    QVector<int> series(count * frameCount);
+    for (int f = 0; f < frameCount; ++f) {
+        const qint16 *row = frames.frame(firstFrame + f) + nodeBegin;
+        int *column = series.data() + f;
+        for (int j = 0; j < count; ++j) {
+            column[j * frameCount] = quint16(row[j]);
+        }
+    }
+
+    QVector<int> scratch(frameCount);
+    qint64 rejected = 0;
+    for (int j = 0; j < count; ++j) {
+        const int *values = series.constData() + j * frameCount;
+        std::copy(values, values + frameCount, scratch.begin());
+        const double median = medianOf(scratch.data(), frameCount);
+        for (int f = 0; f < frameCount; ++f) {
+            scratch[f] = int(std::lround(std::fabs(values[f] - median) * 2.0));  // 以 0.5 为单位，保留 .5 的中值
+        }
+        const double sigma = kMadScale * medianOf(scratch.data(), frameCount) / 2.0;
+        const double limit = qMax(1.0, kOutlierSigma * sigma);
+
+        double sum = 0.0;
+        double squares = 0.0;
+        int inliers = 0;
+        for (int f = 0; f < frameCount; ++f) {
+            if (std::fabs(values[f] - median) <= limit) {
+                sum += values[f];
+                squares += double(values[f]) * values[f];
+                ++inliers;
+            }
+        }
+        rejected += frameCount - inliers;
+
+        // 至少一半的帧与中值的偏差不超过 MAD，正常情况下 inliers 不会为 0
+        const double mean = inliers > 0 ? sum / inliers : median;
+        noise[nodeBegin + j] = inliers > 0 ? float(std::sqrt(qMax(0.0, squares / inliers - mean * mean))) : 0.0f;
+        const double value = (method == BaselineBuilder::Median) ? median : mean;
+        baseline[nodeBegin + j] = qint16(quint16(qBound(0L, std::lround(value), 65535L)));
+    }
+    *outliers = rejected;
+}
+
+QString nodeList(const QVector<int> &nodes, int rxCount)
+{
+    QStringList names;
+    for (int i = 0; i < nodes.size() && i < kMaxListedNodes; ++i) {
+        names << QStringLiteral("TX%1/RX%2").arg(nodes[i] / rxCount).arg(nodes[i] % rxCount);
+    }
+    if (nodes.size() > kMaxListedNodes) {
+        names << QStringLiteral("...");
+    }
+    return names.join(QStringLiteral(", "));
+}
+
+// 面板级的评估：节点基线值的稳健分布、坏节点和噪声
+void evaluate(BaselineResult &result)
+{
+    const int nodeCount = result.baseline.size();
+    QVector<int> values(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        values[i] = quint16(result.baseline[i]);
+    }
+    QVector<int> scratch = values;
+    const double level = medianOf(scratch.data(), nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        scratch[i] = int(std::lround(std::fabs(values[i] - level)));
+    }
+    const double spread = kMadScale * medianOf(scratch.data(), nodeCount);
+    result.uniformityPercent = level > 0.0 ? spread / level * 100.0 : 0.0;
+
+    // 偏离面板水平超过 8 倍稳健标准差（且至少为面板水平的 1/4）或处于量程两端的节点
+    const double badLimit = qMax(kBadNodeSigma * spread, level / 4.0);
+    for (int i = 0; i < nodeCount; ++i) {
+        if (values[i] == 0 || values[i] < level - badLimit) {
+            result.deadNodes.append(i);
+        } else if (values[i] == 65535 || values[i] > level + badLimit) {
+            result.shortedNodes.append(i);
+        }
+    }
+
+    // 噪声只在多帧时有意义
+    if (result.frameCount > 1) {
+        double total = 0.0;
+        QVector<float> sorted = result.noise;
+        for (float value : result.noise) {
+            total += value;
+            result.maxNoise = qMax(result.maxNoise, double(value));
+        }
+        result.meanNoise = total / nodeCount;
+        std::nth_element(sorted.begin(), sorted.begin() + nodeCount / 2, sorted.end());
+        const double noisyLimit = qMax(2.0, kNoisyFactor * sorted[nodeCount / 2]);
+        for (int i = 0; i < nodeCount; ++i) {
+            if (result.noise[i] > noisyLimit) {
+                result.noisyNodes.append(i);
+            }
+        }
+    }
+
+    // 评分：平均噪声每 1 LSB 扣 4 分（最多 40），不均匀度每 1% 扣 1 分（最多 30），
+    // 坏节点每占 1% 扣 3 分（最多 30）；只用于比较同一块面板的不同基线
+    const int badNodes = result.deadNodes.size() + result.shortedNodes.size() + result.noisyNodes.size();
+    result.score = 100.0 - qMin(40.0, 4.0 * result.meanNoise) - qMin(30.0, result.uniformityPercent)
+                   - qMin(30.0, 300.0 * badNodes / nodeCount);
+    result.score = qMax(0.0, result.score);
+}
+
+} // namespace
+
+QString BaselineResult::summary(int rxCount) const
+{
+    if (!isValid() || rxCount <= 0) {
+        return QString();
+    }
+    QStringList lines;
+    lines << QCoreApplication::translate("BaselineBuilder", "基线质量评分: %1 / 100").arg(score, 0, 'f', 0);
+    lines << QCoreApplication::translate("BaselineBuilder", "使用第 %1 ~ %2 帧（共 %3 帧），剔除异常采样 %4 个，耗时 %5 ms")
+                 .arg(firstFrame + 1).arg(firstFrame + frameCount).arg(frameCount).arg(outlierSamples).arg(elapsedMs);
+    if (frameCount > 1) {
+        lines << QCoreApplication::translate("BaselineBuilder", "噪声: 平均 %1，最大 %2")
+                     .arg(meanNoise, 0, 'f', 2).arg(maxNoise, 0, 'f', 2);
+    } else {
+        lines << QCoreApplication::translate("BaselineBuilder", "噪声: 只有 1 帧，无法评估");
+    }
+    lines << QCoreApplication::translate("BaselineBuilder", "不均匀度: %1%").arg(uniformityPercent, 0, 'f', 2);
+    if (!deadNodes.isEmpty()) {
+        lines << QCoreApplication::translate("BaselineBuilder", "疑似开路/无信号节点 %1 个: %2")
+                     .arg(deadNodes.size()).arg(nodeList(deadNodes, rxCount));
+    }
+    if (!shortedNodes.isEmpty()) {
+        lines << QCoreApplication::translate("BaselineBuilder", "疑似短路/饱和节点 %1 个: %2")
+                     .arg(shortedNodes.size()).arg(nodeList(shortedNodes, rxCount));
+    }
+    if (!noisyNodes.isEmpty()) {
+        lines << QCoreApplication::translate("BaselineBuilder", "噪声异常节点 %1 个: %2")
+                     .arg(noisyNodes.size()).arg(nodeList(noisyNodes, rxCount));
+    }
+    return lines.join('\n');
+}
+
+BaselineResult BaselineBuilder::build(const FrameStore &frames, int firstFrame, int frameCount, Method method)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    BaselineResult result;
+    const int nodeCount = frames.frameSize();
+    firstFrame = qMax(0, firstFrame);
+    frameCount = qMin(frameCount, frames.frameCount() - firstFrame);
+    if (nodeCount <= 0 || frameCount <= 0) {
+        return result;
+    }
+    result.firstFrame = firstFrame;
+    result.frameCount = frameCount;
+    result.baseline.resize(nodeCount);
+    result.noise.resize(nodeCount);
+
+    QVector<int> blockStarts;
+    for (int node = 0; node < nodeCount; node += kNodeBlock) {
+        blockStarts.append(node);
+    }
+    QVector<qint64> blockOutliers(blockStarts.size());
+
+    // 各块写入互不重叠的区域；并行前取出可写指针，避免在工作线程中分离共享数据
+    qint16 *baseline = result.baseline.data();
+    float *noise = result.noise.data();
+    qint64 *outliers = blockOutliers.data();
+    QtConcurrent::blockingMap(blockStarts, [&](int &nodeBegin) {
+        const int nodeEnd = qMin(nodeCount, nodeBegin + kNodeBlock);
+        processNodes(frames, firstFrame, frameCount, method, nodeBegin, nodeEnd, baseline, noise,
+                     outliers + nodeBegin / kNodeBlock);
+    });
+    for (qint64 count : blockOutliers) {
+        result.outlierSamples += count;
+    }
+
+    evaluate(result);
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
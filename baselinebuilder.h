@@ -0,0 +1,46 @@
+#ifndef BASELINEBUILDER_H
+#define BASELINEBUILDER_H
+
+#include <QString>
+#include <QVector>
+
+class FrameStore;
+
+// 多帧基线的计算结果和质量评估
+struct BaselineResult
+{
+    QVector<qint16> baseline;
+    QVector<float> noise;            // 每个节点去掉异常帧后的标准差
+    int firstFrame = 0;
+    int frameCount = 0;              // 参与计算的帧数
+    qint64 outlierSamples = 0;       // 被判为异常而剔除的采样点数
+
+    // 质量评估：节点按 tx 行、rx 列的序号
+    double meanNoise = 0.0;          // 所有节点噪声的平均值
+    double maxNoise = 0.0;
+    double uniformityPercent = 0.0;  // 节点基线值的离散程度（稳健标准差 / 面板中值）
+    QVector<int> deadNodes;          // 基线值远低于面板水平或为 0（开路、无信号）
+    QVector<int> shortedNodes;       // 基线值远高于面板水平或为满量程（短路、饱和）
+    QVector<int> noisyNodes;         // 噪声远大于其他节点
+    double score = 0.0;              // 0 ~ 100，越高越好
+    qint64 elapsedMs = 0;
+
+    bool isValid() const { return !baseline.isEmpty(); }
+    QString summary(int rxCount) const;
+};
+
+// 多帧基线：每个节点取若干帧的中值或去异常均值，代替直接把第一帧作为基线，单帧的毛刺不会进入基线
+// 节点分块在线程池中并行计算；数值按无符号 16 位处理（与原始数据的十六进制显示一致）
+class BaselineBuilder
+{
+public:
+    enum Method {
+        Median,
+        RobustMean       // 去掉偏离中值超过 3.5 倍稳健标准差的帧后取平均
+    };
+
+    // 使用 frames 中 [firstFrame, firstFrame + frameCount) 的帧，超出范围的部分被截掉
+    static BaselineResult build(const FrameStore &frames, int firstFrame, int frameCount, Method method);
+};
+
+#endif // BASELINEBUILDER_H
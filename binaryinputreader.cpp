@@ -0,0 +1,241 @@
+#include "binaryinputreader.h"
+#include "framestore.h"
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+inline void decodeSamples(const uchar *src, int count, bool isBigEndian, qint16 *out)
+{
+    if (isBigEndian) {
+        for (int i = 0; i < count; ++i) {
+            out[i] = qFromBigEndian<qint16>(src + 2 * i);
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            out[i] = qFromLittleEndian<qint16>(src + 2 * i);
+        }
+    }
+}
+
+// 与 TouchDataParser::decodeField 相同的字节组合方式
+inline quint64 decodeValue(const uchar *src, int byteCount, bool isBigEndian)
+{
+    quint64 value = 0;
+    for (int i = 0; i < byteCount; ++i) {
+        if (isBigEndian) {
+            value = (value << 8) | src[i];
+        } else {
+            value |= quint64(src[i]) << (8 * i);
+        }
+    }
+    return value;
+}
+
+// 查找记录起点：帧头位于起点之后 headerPos 字节
+class RecordScanner
+{
+public:
+    RecordScanner(const char *end, int headerPos, const QVector<QByteArray> &headers)
+        : end(end), headerPos(headerPos), headers(headers), firstByte(-1)
+    {
+        // 所有帧头首字节相同时用 memchr 跳过不可能匹配的字节
+        for (const QByteArray &header : headers) {
+            if (header.isEmpty()) {
+                continue;
+            }
+            const int value = uchar(header[0]);
+            if (firstByte == -1) {
+                firstByte = value;
+            } else if (firstByte != value) {
+                firstByte = -2;
+            }
+        }
+    }
+
+    // p 处是一条记录时返回帧头序号，否则返回 -1
+    int matchAt(const char *p) const
+    {
+        const char *header = p + headerPos;
+        for (int i = 0; i < headers.size(); ++i) {
+            const int size = headers[i].size();
+            if (size > 0 && end - header >= size && std::memcmp(header, headers[i].constData(), size_t(size)) == 0) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // 从 p 起找下一个可能的记录起点，找不到时返回 end
+    const char *nextCandidate(const char *p) const
+    {
+        if (firstByte < 0) {
+            return p;
+        }
+        const char *from = p + headerPos;
+        if (from >= end) {
+            return end;
+        }
+        const void *hit = std::memchr(from, firstByte, size_t(end - from));
+        return hit ? static_cast<const char *>(hit) - headerPos : end;
+    }
+
+    // 从 p 起查找下一条记录，p 移到记录起点并返回帧头序号；没有更多记录时返回 -1
+    int find(const char *&p) const
+    {
+        while (p < end) {
+            p = nextCandidate(p);
+            if (p >= end) {
+                break;
+            }
+            const int stream = matchAt(p);
+            if (stream >= 0) {
+                return stream;
+            }
+            ++p;
+        }
+        return -1;
+    }
+
+private:
+    const char *end;
+    int headerPos;
+    const QVector<QByteArray> &headers;
+    int firstByte;       // -1 没有有效帧头，-2 首字节不唯一
+};
+
+} // namespace
+
+bool BinaryInputReader::headerBytes(const QVector<QString> &pattern, QByteArray &bytes)
+{
+    bytes.clear();
+    for (const QByteArray &value : TouchDataParser::normalizePattern(pattern)) {
+        bool ok = false;
+        const uint byte = value.toUInt(&ok, 16);
+        if (!ok || byte > 0xFF) {
+            bytes.clear();
+            return false;
+        }
+        bytes.append(char(byte));
+    }
+    return !bytes.isEmpty();
+}
+
+int BinaryInputReader::recordSize(const ParseSettings &settings, int headerSize)
+{
+    int size = qMax(settings.filterStartPos + headerSize, settings.rawDataPos + settings.frameSize() * 2);
+    if (settings.hasTimestamp()) {
+        size = qMax(size, settings.timestampPos + qBound(1, settings.timestampBytes, 8));
+    }
+    if (settings.hasSequence()) {
+        size = qMax(size, settings.sequencePos + qBound(1, settings.sequenceBytes, 4));
+    }
+    return size;
+}
+
+void BinaryInputReader::readStreams(const char *begin, const char *end, const ParseSettings &settings,
+                                    const QVector<QVector<QString>> &patterns, const QVector<FrameStore *> &stores,
+                                    ParseDiagnostics *diagnostics, const QAtomicInt *cancel) const
+{
+    const int frameSize = settings.frameSize();
+    const int streamCount = qMin(patterns.size(), stores.size());
+    if (frameSize <= 0 || settings.filterStartPos < 0 || settings.rawDataPos < 0) {
+        return;
+    }
+
+    const bool withTimestamp = settings.hasTimestamp();
+    const bool withSequence = settings.hasSequence();
+    const int timestampBytes = qBound(1, settings.timestampBytes, 8);
+    const int sequenceBytes = qBound(1, settings.sequenceBytes, 4);
+
+    // 无效的帧头保持为空，不会匹配任何记录
+    QVector<QByteArray> headers(streamCount);
+    QVector<int> recordSizes(streamCount);
+    int openStreams = 0;
+    for (int i = 0; i < streamCount; ++i) {
+        if (headerBytes(patterns[i], headers[i])) {
+            ++openStreams;
+        }
+        recordSizes[i] = recordSize(settings, headers[i].size());
+    }
+
+    QVector<TimestampUnwrapper> timestamps(streamCount, TimestampUnwrapper(settings.timestampBytes));
+    RecordScanner scanner(end, settings.filterStartPos, headers);
+
+    const char *p = begin;
+    quint32 recordNumber = 0;
+    while (openStreams > 0) {
+        const int i = scanner.find(p);
+        if (i < 0 || isCancelled(cancel, recordNumber + 1)) {
+            break;
+        }
+        ++recordNumber;
+
+        FrameStore &store = *stores[i];
+        const uchar *record = reinterpret_cast<const uchar *>(p);
+        if (settings.maxRows > 0 && store.frameCount() >= settings.maxRows) {
+            p += recordSizes[i];
+            continue;
+        }
+
+        // 文件末尾不完整的记录（记录号记在"行号"中，列为实际剩余的字节数）
+        if (end - p < recordSizes[i]) {
+            if (diagnostics) {
+                diagnostics->record(p - begin, recordNumber, int(end - p), ParseDiagnostics::TooFewColumns,
+                                    i, store.frameCount());
+            }
+            break;
+        }
+
+        qint16 *slot = store.appendFrame();
+        decodeSamples(record + settings.rawDataPos, frameSize, settings.isBigEndian, slot);
+
+        const int index = store.frameCount() - 1;
+        if (withTimestamp) {
+            const quint64 value = decodeValue(record + settings.timestampPos, timestampBytes, settings.isBigEndian);
+            store.setTimestamp(index, qint64(timestamps[i].unwrap(value, index > 0)) * settings.timestampUnitUs);
+        }
+        if (withSequence) {
+            store.setSequence(index, quint32(decodeValue(record + settings.sequencePos, sequenceBytes,
+                                                         settings.isBigEndian)));
+        }
+
+        if (settings.maxRows > 0 && store.frameCount() == settings.maxRows) {
+            --openStreams;
+        }
+        p += recordSizes[i];
+    }
+}
+
+TouchDataParser::Status BinaryInputReader::readFirstFrame(const char *begin, const char *end,
+                                                          const ParseSettings &settings, QVector<qint16> &frame,
+                                                          int *decodedCount) const
+{
+    QVector<QByteArray> headers(1);
+    if (!headerBytes(settings.pattern, headers[0]) || settings.filterStartPos < 0 || settings.rawDataPos < 0) {
+        return TouchDataParser::NoMatch;
+    }
+
+    RecordScanner scanner(end, settings.filterStartPos, headers);
+    const char *p = begin;
+    if (scanner.find(p) < 0) {
+        return TouchDataParser::NoMatch;
+    }
+
+    // 数据不完整时返回实际能读出的数据量，与文本格式的 SizeMismatch 一致
+    const int frameSize = settings.frameSize();
+    const qint64 available = qMax<qint64>(0, end - (p + settings.rawDataPos)) / 2;
+    const int decoded = int(qMin<qint64>(available, frameSize));
+    if (decodedCount) {
+        *decodedCount = decoded;
+    }
+    if (decoded == 0 || decoded != frameSize) {
+        return TouchDataParser::SizeMismatch;
+    }
+
+    QVector<qint16> data(frameSize);
+    decodeSamples(reinterpret_cast<const uchar *>(p) + settings.rawDataPos, frameSize, settings.isBigEndian,
+                  data.data());
+    frame = data;
+    return TouchDataParser::Ok;
+}
@@ -0,0 +1,26 @@
+#ifndef BINARYINPUTREADER_H
+#define BINARYINPUTREADER_H
+
+#include <QByteArray>
+#include "touchinputreader.h"
+
+// 二进制帧：文件由定长记录组成，帧头字节在记录的 filterStartPos 字节处，
+// 数据从 rawDataPos 字节起共 rx*tx*2 字节，时间戳/帧序号同样按字节偏移读取，字节序按 isBigEndian
+// 记录首尾相接时逐条前进；遇到不匹配的字节（记录间有校验等附加字节）时向后搜索下一个帧头
+// 没有"下一行"的概念，filterMode 不使用
+class BinaryInputReader : public TouchInputReader
+{
+public:
+    void readStreams(const char *begin, const char *end, const ParseSettings &settings,
+                     const QVector<QVector<QString>> &patterns, const QVector<FrameStore *> &stores,
+                     ParseDiagnostics *diagnostics, const QAtomicInt *cancel) const override;
+    TouchDataParser::Status readFirstFrame(const char *begin, const char *end, const ParseSettings &settings,
+                                           QVector<qint16> &frame, int *decodedCount) const override;
+
+    // 帧头的字节值（与文本格式相同的规范化后按十六进制转换）；有无法表示为一个字节的值时返回 false
+    static bool headerBytes(const QVector<QString> &pattern, QByteArray &bytes);
+    // 一条记录的字节数：帧头、数据、时间戳、帧序号中最靠后的结束位置
+    static int recordSize(const ParseSettings &settings, int headerSize);
+};
+
+#endif // BINARYINPUTREADER_H
@@ -0,0 +1,143 @@
+#include "capturesession.h"
+#include "simdkernels.h"
+#include "framearchive.h"
+#include <QtConcurrent>
+
+CaptureSession::CaptureSession(QObject *parent)
+    : QObject(parent)
+    , frameIndex(0)
+{
+    captures.append(new Capture);
+}
+
+CaptureSession::~CaptureSession()
+{
+    // 等待仍在解析的工作线程结束，避免其写入已释放的采集
+    for (QFutureWatcher<TouchDataParser::Status> *watcher : pendingLoads) {
+        watcher->waitForFinished();
+    }
+    qDeleteAll(captures);
+}
+
+const Capture *CaptureSession::capture(int index) const
+{
+    if (index < 0 || index >= captures.size()) {
+        return nullptr;
+    }
+    return captures[index];
+}
+
+void CaptureSession::setPrimaryFile(const QString &filePath)
+{
+    captures[0]->filePath = filePath;
+    captures[0]->loaded = !captures[0]->frames.isEmpty();
+}
+
+void CaptureSession::loadComparisons(const QStringList &filePaths, const ParseSettings &settings)
+{
+    for (const QString &filePath : filePaths) {
+        Capture *capture = new Capture;
+        capture->filePath = filePath;
+        const int index = captures.size();
+        captures.append(capture);
+
+        auto *watcher = new QFutureWatcher<TouchDataParser::Status>(this);
+        connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, capture, index]() {
+            capture->status = watcher->result();
+            capture->loaded = (capture->status == TouchDataParser::Ok);
+            pendingLoads.removeOne(watcher);
+            watcher->deleteLater();
+
+            emit captureLoaded(index);
+            if (pendingLoads.isEmpty()) {
+                emit loadingFinished();
+            }
+        });
+        pendingLoads.append(watcher);
+        watcher->setFuture(QtConcurrent::run([filePath, settings, capture]() {
+            return loadCaptureFile(filePath, settings, capture->frames);
+        }));
+    }
+}
+
+void CaptureSession::clearComparisons()
+{
+    if (isLoading()) {
+        return;
+    }
+    while (captures.size() > 1) {
+        delete captures.takeLast();
+    }
+}
+
+void CaptureSession::setCurrentFrame(int frame)
+{
+    if (frame == frameIndex) {
+        return;
+    }
+    frameIndex = frame;
+    emit currentFrameChanged(frameIndex);
+}
+
+const qint16 *CaptureSession::currentFrameData(int captureIndex) const
+{
+    const Capture *c = capture(captureIndex);
+    if (!c || !c->loaded || c->frames.isEmpty()) {
+        return nullptr;
+    }
+    return c->frames.frame(qBound(0, frameIndex, c->frames.frameCount() - 1));
+}
+
+bool CaptureSession::computeDifference(int indexA, int indexB, QVector<qint16> &out) const
+{
+    const qint16 *a = currentFrameData(indexA);
+    const qint16 *b = currentFrameData(indexB);
+    if (!a || !b || captures[indexA]->frames.frameSize() != captures[indexB]->frames.frameSize()) {
+        return false;
+    }
+
+    const int count = captures[indexA]->frames.frameSize();
+    if (out.size() != count) {
+        out.resize(count);
+    }
+    SimdKernels::subtractSaturate(a, b, out.data(), count);
+    return true;
+}
+
+qint64 CaptureSession::memoryUsage() const
+{
+    // 对比采集加载期间工作线程还在写入，只统计主采集
+    qint64 bytes = 0;
+    const int count = isLoading() ? qMin(1, captures.size()) : captures.size();
+    for (int i = 0; i < count; ++i) {
+        bytes += captures[i]->frames.memoryUsage();
+    }
+    return bytes;
+}
+
+qint64 CaptureSession::spillColdFrames(qint64 bytes)
+{
+    // 对比采集优先于主采集换出；对比采集加载期间工作线程还在写入，只换出主采集
+    qint64 moved = 0;
+    for (int i = isLoading() ? 0 : captures.size() - 1; i >= 0 && moved < bytes; --i) {
+        moved += captures[i]->frames.spillColdChunks(bytes - moved, frameIndex);
+    }
+    return moved;
+}
+
+TouchDataParser::Status CaptureSession::loadCaptureFile(const QString &filePath, const ParseSettings &settings,
+                                                        FrameStore &store)
+{
+    if (!FrameArchive::isArchive(filePath)) {
+        return TouchDataParser::readFrames(filePath, settings, store);
+    }
+
+    FrameArchiveReader reader;
+    if (!reader.open(filePath)) {
+        return TouchDataParser::OpenFailed;
+    }
+    if (!reader.readAll(store)) {
+        return TouchDataParser::SizeMismatch;
+    }
+    return store.isEmpty() ? TouchDataParser::NoMatch : TouchDataParser::Ok;
+}
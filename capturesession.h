@@ -0,0 +1,68 @@
+#ifndef CAPTURESESSION_H
+#define CAPTURESESSION_H
+
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+#include <QFutureWatcher>
+#include "framestore.h"
+#include "touchdataparser.h"
+
+// 一份触摸数据采集（一个日志文件）
+struct Capture
+{
+    QString filePath;
+    FrameStore frames;
+    bool loaded = false;
+    TouchDataParser::Status status = TouchDataParser::Ok;
+};
+
+// 会话：同时持有多份采集，按同一个帧时钟同步播放
+// 采集 0 为主数据（FunctionPage 读取的触摸数据），其余为对比数据
+class CaptureSession : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CaptureSession(QObject *parent = nullptr);
+    ~CaptureSession();
+
+    int captureCount() const { return captures.size(); }
+    const Capture *capture(int index) const;
+    FrameStore &primaryFrames() { return captures[0]->frames; }
+    const FrameStore &primaryFrames() const { return captures[0]->frames; }
+    void setPrimaryFile(const QString &filePath);
+
+    // 每个文件在各自的工作线程中解析，全部完成后发出 loadingFinished
+    void loadComparisons(const QStringList &filePaths, const ParseSettings &settings);
+    void clearComparisons();
+    bool isLoading() const { return !pendingLoads.isEmpty(); }
+
+    // 共享帧时钟：较短的采集停留在最后一帧
+    int currentFrame() const { return frameIndex; }
+    void setCurrentFrame(int frame);
+    const qint16 *currentFrameData(int captureIndex) const;
+
+    // 当前帧的差值 A - B（SIMD 饱和减法），两份采集的帧大小必须一致
+    bool computeDifference(int indexA, int indexB, QVector<qint16> &out) const;
+
+    qint64 memoryUsage() const;              // 对比采集加载期间只含主采集
+    // 内存不足时把各采集中离当前帧最远的块换出到文件，返回换出的字节数
+    qint64 spillColdFrames(qint64 bytes);
+
+    // 按文件类型读取一份采集（CSV 日志或 .rgdf 归档），可在工作线程中调用
+    static TouchDataParser::Status loadCaptureFile(const QString &filePath, const ParseSettings &settings,
+                                                   FrameStore &store);
+
+signals:
+    void captureLoaded(int index);
+    void loadingFinished();
+    void currentFrameChanged(int frame);
+
+private:
+    QVector<Capture *> captures;
+    QVector<QFutureWatcher<TouchDataParser::Status> *> pendingLoads;
+    int frameIndex;
+};
+
+#endif // CAPTURESESSION_H
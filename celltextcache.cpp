@@ -0,0 +1,38 @@
+#include "celltextcache.h"
+#include <QVector>
+
+namespace {
+
+const int kDecimalMin = -4096;           // 10 进制缓存范围：信号数据绝大多数落在这里
+const int kDecimalMax = 8191;
+
+} // namespace
+
+namespace CellTextCache {
+
+const QString &hex(qint16 value)
+{
+    static QVector<QString> table(65536);
+
+    QString &text = table[quint16(value)];
+    if (text.isNull()) {
+        text = QString("%1").arg(quint16(value), 4, 16, QChar('0')).toUpper();
+    }
+    return text;
+}
+
+QString decimal(qint16 value)
+{
+    static QVector<QString> table(kDecimalMax - kDecimalMin + 1);
+
+    if (value < kDecimalMin || value > kDecimalMax) {
+        return QString::number(value);
+    }
+    QString &text = table[value - kDecimalMin];
+    if (text.isNull()) {
+        text = QString::number(value);
+    }
+    return text;
+}
+
+} // namespace CellTextCache
@@ -0,0 +1,16 @@
+#ifndef CELLTEXTCACHE_H
+#define CELLTEXTCACHE_H
+
+#include <QString>
+
+// 单元格文本缓存：同一个数值只格式化一次，之后返回共享的 QString（只复制指针、增加引用计数）
+// 16 进制覆盖全部 65536 个值；10 进制只缓存常见的信号范围，范围外的值直接格式化
+// 缓存按需填充且不加锁，只能在界面线程使用
+namespace CellTextCache {
+
+const QString &hex(qint16 value);        // 4 位大写 16 进制，按无符号显示
+QString decimal(qint16 value);
+
+} // namespace CellTextCache
+
+#endif // CELLTEXTCACHE_H
@@ -0,0 +1,134 @@
+#include "commonmodescanner.h"
+#include "linereducer.h"
+#include "simdkernels.h"
+#include <QtConcurrent>
+#include <algorithm>
+
+// 每批处理的帧数（批之间检查取消并发布一次结果）
+static const int kBatchFrames = 1024;
+
+// 保留的最差帧数量
+static const int kMaxWorstFrames = 20;
+
+CommonModeScanner::CommonModeScanner(QObject *parent)
+    : QObject(parent)
+    , currentGeneration(0)
+    , scanned(0)
+    , total(0)
+    , running(false)
+{
+}
+
+CommonModeScanner::~CommonModeScanner()
+{
+    cancel();
+}
+
+void CommonModeScanner::start(const FrameStore &frames, const QVector<qint16> &baseline, bool baseMinusRaw,
+                              int width, int height)
+{
+    cancel();
+
+    worst.clear();
+    scanned = 0;
+    total = frames.frameCount();
+    if (frames.isEmpty() || baseline.size() != frames.frameSize() || width * height != frames.frameSize()) {
+        return;
+    }
+
+    running = true;
+    const int generation = currentGeneration.loadAcquire();
+    future = QtConcurrent::run([this, frames, baseline, baseMinusRaw, width, height, generation]() {
+        scan(frames, baseline, baseMinusRaw, width, height, generation);
+    });
+}
+
+void CommonModeScanner::cancel()
+{
+    // 工作线程最多再处理完当前这一批
+    currentGeneration.fetchAndAddOrdered(1);
+    future.waitForFinished();
+    running = false;
+}
+
+void CommonModeScanner::scan(FrameStore frames, QVector<qint16> baseline, bool baseMinusRaw,
+                             int width, int height, int generation)
+{
+    const int frameSize = frames.frameSize();
+    const int frameCount = frames.frameCount();
+    QVector<qint16> signal(frameSize);
+    LineReducer reducer;
+    QVector<Entry> entries;
+    entries.reserve(kMaxWorstFrames + 1);
+
+    for (int begin = 0; begin < frameCount; begin += kBatchFrames) {
+        if (currentGeneration.loadAcquire() != generation) {
+            return;
+        }
+
+        const int end = qMin(frameCount, begin + kBatchFrames);
+        for (int f = begin; f < end; ++f) {
+            if (baseMinusRaw) {
+                SimdKernels::subtractWrap(baseline.constData(), frames.frame(f), signal.data(), frameSize);
+            } else {
+                SimdKernels::subtractWrap(frames.frame(f), baseline.constData(), signal.data(), frameSize);
+            }
+            reducer.reduce(signal.constData(), width, height, LineReducer::Median);
+
+            Entry entry;
+            entry.frame = f;
+            const QVector<qint32> &rows = reducer.rowValues();
+            const QVector<qint32> &columns = reducer.columnValues();
+            for (int y = 0; y < rows.size(); ++y) {
+                if (qAbs(rows[y]) > qAbs(entry.offset)) {
+                    entry.offset = rows[y];
+                    entry.isRow = true;
+                    entry.line = y;
+                }
+            }
+            for (int x = 0; x < columns.size(); ++x) {
+                if (qAbs(columns[x]) > qAbs(entry.offset)) {
+                    entry.offset = columns[x];
+                    entry.isRow = false;
+                    entry.line = x;
+                }
+            }
+
+            // 有序插入，只保留前 kMaxWorstFrames 个
+            if (entries.size() == kMaxWorstFrames && qAbs(entry.offset) <= qAbs(entries.last().offset)) {
+                continue;
+            }
+            auto position = std::upper_bound(entries.begin(), entries.end(), entry,
+                                             [](const Entry &a, const Entry &b) {
+                                                 return qAbs(a.offset) > qAbs(b.offset);
+                                             });
+            entries.insert(position, entry);
+            if (entries.size() > kMaxWorstFrames) {
+                entries.removeLast();
+            }
+        }
+
+        const bool done = (end == frameCount);
+        QMetaObject::invokeMethod(this, [this, entries, end, done, generation]() {
+            publish(entries, end, done, generation);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void CommonModeScanner::publish(const QVector<Entry> &entries, int scannedCount, bool done, int generation)
+{
+    // 已取消或重新开始的扫描，结果丢弃
+    if (currentGeneration.loadAcquire() != generation) {
+        return;
+    }
+
+    worst = entries;
+    scanned = scannedCount;
+    if (done) {
+        running = false;
+    }
+    emit progress(scanned, total);
+    if (done) {
+        emit finished();
+    }
+}
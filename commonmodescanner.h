@@ -0,0 +1,55 @@
+#ifndef COMMONMODESCANNER_H
+#define COMMONMODESCANNER_H
+
+#include <QObject>
+#include <QFuture>
+#include <QAtomicInt>
+#include <QVector>
+#include "framestore.h"
+
+// 整段采集的共模排查：逐帧对信号数据按行/列取中值（中值不受触摸点影响），
+// 以偏移最大的一条线作为该帧的共模分数，保留分数最高的若干帧
+// 在工作线程中分批处理，每批结束后更新结果，界面可以边扫描边查看
+class CommonModeScanner : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Entry {
+        int frame = 0;
+        qint32 offset = 0;       // 该线的中值（带符号）
+        bool isRow = true;       // true = TX 行，false = RX 列
+        int line = 0;
+    };
+
+    explicit CommonModeScanner(QObject *parent = nullptr);
+    ~CommonModeScanner();
+
+    // 开始新的扫描（会先取消正在进行的扫描）；frames 和 baseline 隐式共享，只复制引用
+    void start(const FrameStore &frames, const QVector<qint16> &baseline, bool baseMinusRaw,
+               int width, int height);
+    void cancel();
+
+    bool isRunning() const { return running; }
+    int scannedFrames() const { return scanned; }
+    int totalFrames() const { return total; }
+    const QVector<Entry> &worstFrames() const { return worst; }     // 按 |offset| 从大到小
+
+signals:
+    void progress(int scanned, int total);
+    void finished();
+
+private:
+    void scan(FrameStore frames, QVector<qint16> baseline, bool baseMinusRaw, int width, int height,
+              int generation);
+    void publish(const QVector<Entry> &entries, int scannedCount, bool done, int generation);
+
+    QFuture<void> future;
+    QAtomicInt currentGeneration;    // 每次 start/cancel 递增，工作线程据此提前结束
+    QVector<Entry> worst;
+    int scanned;
+    int total;
+    bool running;
+};
+
+#endif // COMMONMODESCANNER_H
@@ -0,0 +1,128 @@
+#include "comparewindow.h"
+#include "capturesession.h"
+#include "heatmapview.h"
+#include <QComboBox>
+#include <QCheckBox>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QVBoxLayout>
+
+CompareWindow::CompareWindow(CaptureSession *session, QWidget *parent)
+    : QWidget(parent, Qt::Window)
+    , session(session)
+    , rxCount(0)
+    , txCount(0)
+    , reverseRx(false)
+    , differenceView(nullptr)
+{
+    setWindowTitle(tr("多文件对比"));
+    resize(960, 420);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    QHBoxLayout *toolLayout = new QHBoxLayout;
+    toolLayout->addWidget(new QLabel(tr("对比基准 (B):"), this));
+    referenceComboBox = new QComboBox(this);
+    toolLayout->addWidget(referenceComboBox);
+    differenceCheckBox = new QCheckBox(tr("显示差值热力图 (A - B)"), this);
+    differenceCheckBox->setChecked(true);
+    toolLayout->addWidget(differenceCheckBox);
+    toolLayout->addStretch();
+    statusLabel = new QLabel(this);
+    toolLayout->addWidget(statusLabel);
+    mainLayout->addLayout(toolLayout);
+
+    viewsLayout = new QHBoxLayout;
+    mainLayout->addLayout(viewsLayout, 1);
+
+    connect(referenceComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &CompareWindow::refresh);
+    connect(differenceCheckBox, &QCheckBox::toggled, this, &CompareWindow::refresh);
+    connect(session, &CaptureSession::currentFrameChanged, this, &CompareWindow::refresh);
+    connect(session, &CaptureSession::captureLoaded, this, &CompareWindow::rebuildViews);
+
+    rebuildViews();
+}
+
+void CompareWindow::setPanelLayout(int rx, int tx, bool reverse)
+{
+    rxCount = rx;
+    txCount = tx;
+    reverseRx = reverse;
+    refresh();
+}
+
+void CompareWindow::rebuildViews()
+{
+    qDeleteAll(captureViews);
+    captureViews.clear();
+    delete differenceView;
+    differenceView = nullptr;
+
+    int previousReference = referenceComboBox->currentIndex();
+    referenceComboBox->blockSignals(true);
+    referenceComboBox->clear();
+
+    for (int i = 0; i < session->captureCount(); ++i) {
+        const Capture *capture = session->capture(i);
+        QString name = capture->filePath.isEmpty() ? tr("未读取") : QFileInfo(capture->filePath).fileName();
+        QString label = (i == 0 ? tr("A: %1") : tr("#%1: %2").arg(i)).arg(name);
+
+        HeatmapView *view = new HeatmapView(this);
+        view->setTitle(label);
+        viewsLayout->addWidget(view, 1);
+        captureViews.append(view);
+
+        if (i > 0) {
+            referenceComboBox->addItem(label, i);
+        }
+    }
+
+    differenceView = new HeatmapView(this);
+    viewsLayout->addWidget(differenceView, 1);
+
+    if (previousReference >= 0 && previousReference < referenceComboBox->count()) {
+        referenceComboBox->setCurrentIndex(previousReference);
+    }
+    referenceComboBox->blockSignals(false);
+
+    refresh();
+}
+
+void CompareWindow::refresh()
+{
+    if (session->isLoading()) {
+        statusLabel->setText(tr("正在加载..."));
+    } else {
+        statusLabel->setText(tr("第 %1 帧  内存 %2 MB")
+            .arg(session->currentFrame() + 1)
+            .arg(session->memoryUsage() / (1024.0 * 1024.0), 0, 'f', 1));
+    }
+
+    for (int i = 0; i < captureViews.size(); ++i) {
+        const Capture *capture = session->capture(i);
+        const qint16 *data = session->currentFrameData(i);
+        if (data && capture->frames.frameSize() == rxCount * txCount) {
+            captureViews[i]->setFrame(data, rxCount, txCount, HeatmapRenderer::Sequential, reverseRx);
+        } else {
+            captureViews[i]->clearFrame();
+        }
+    }
+
+    if (!differenceView) {
+        return;
+    }
+
+    int reference = referenceComboBox->currentData().toInt();
+    bool showDifference = differenceCheckBox->isChecked() && reference > 0;
+    differenceView->setVisible(showDifference);
+    if (!showDifference) {
+        return;
+    }
+
+    differenceView->setTitle(tr("A - %1").arg(referenceComboBox->currentText()));
+    if (session->computeDifference(0, reference, differenceData) && differenceData.size() == rxCount * txCount) {
+        differenceView->setFrame(differenceData.constData(), rxCount, txCount, HeatmapRenderer::Diverging, reverseRx);
+    } else {
+        differenceView->clearFrame();
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef COMPAREWINDOW_H
+#define COMPAREWINDOW_H
+
+#include <QWidget>
+#include <QVector>
+
+class CaptureSession;
+class HeatmapView;
+class QComboBox;
+class QCheckBox;
+class QHBoxLayout;
+class QLabel;
+
+// 多文件对比窗口：并排显示会话中所有采集的当前帧，可选显示 A - B 差值热力图
+class CompareWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit CompareWindow(CaptureSession *session, QWidget *parent = nullptr);
+
+    void setPanelLayout(int rx, int tx, bool reverse);
+
+public slots:
+    void rebuildViews();
+    void refresh();
+
+private:
+    CaptureSession *session;
+    int rxCount;
+    int txCount;
+    bool reverseRx;
+
+    QComboBox *referenceComboBox;      // 差值的 B
+    QCheckBox *differenceCheckBox;
+    QLabel *statusLabel;
+    QHBoxLayout *viewsLayout;
+    QVector<HeatmapView *> captureViews;
+    HeatmapView *differenceView;
+    QVector<qint16> differenceData;    // 差值缓冲，复用避免每帧分配
+};
+
+#endif // COMPAREWINDOW_H
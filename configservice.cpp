@@ -0,0 +1,130 @@
+#include "configservice.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QJsonDocument>
+#include <QtConcurrent>
+
+ConfigService::ConfigService(const QString &filePath, QObject *parent)
+    : QObject(parent)
+    , path(filePath)
+    , dirty(false)
+{
+    debounceTimer.setSingleShot(true);
+    debounceTimer.setInterval(kDebounceMs);
+    connect(&debounceTimer, &QTimer::timeout, this, &ConfigService::startWrite);
+
+    // 写盘期间又有修改时，写完后再排一次
+    connect(&writer, &QFutureWatcherBase::finished, this, [this]() {
+        if (dirty) {
+            scheduleWrite();
+        }
+    });
+}
+
+ConfigService::~ConfigService()
+{
+    flush();
+}
+
+bool ConfigService::load()
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+    if (doc.isNull() || !doc.isObject()) {
+        return false;
+    }
+
+    QJsonObject root = doc.object();
+    params = root["parameters"].toObject();
+    presets = root["presets"].toObject();
+    return true;
+}
+
+void ConfigService::setParameters(const QJsonObject &parameters)
+{
+    if (parameters == params) {
+        return;
+    }
+    params = parameters;
+    scheduleWrite();
+}
+
+QStringList ConfigService::presetNames() const
+{
+    return presets.keys();
+}
+
+QJsonObject ConfigService::preset(const QString &name) const
+{
+    return presets.value(name).toObject();
+}
+
+void ConfigService::savePreset(const QString &name, const QJsonObject &parameters)
+{
+    presets[name] = parameters;
+    scheduleWrite();
+}
+
+void ConfigService::removePreset(const QString &name)
+{
+    if (!presets.contains(name)) {
+        return;
+    }
+    presets.remove(name);
+    scheduleWrite();
+}
+
+void ConfigService::flush()
+{
+    debounceTimer.stop();
+    writer.waitForFinished();
+    if (dirty) {
+        dirty = false;
+        writeFile(path, buildRoot());
+    }
+}
+
+void ConfigService::scheduleWrite()
+{
+    // 每次修改都重新计时，连续修改只在停下来后写一次
+    dirty = true;
+    debounceTimer.start();
+}
+
+void ConfigService::startWrite()
+{
+    if (writer.isRunning()) {
+        return;     // 当前写盘结束后会重新排队
+    }
+
+    dirty = false;
+    QJsonObject root = buildRoot();
+    QString filePath = path;
+    writer.setFuture(QtConcurrent::run([filePath, root]() {
+        return writeFile(filePath, root);
+    }));
+}
+
+QJsonObject ConfigService::buildRoot() const
+{
+    QJsonObject root;
+    root["parameters"] = params;
+    if (!presets.isEmpty()) {
+        root["presets"] = presets;
+    }
+    return root;
+}
+
+bool ConfigService::writeFile(const QString &filePath, const QJsonObject &root)
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return file.commit();
+}
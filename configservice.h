@@ -0,0 +1,49 @@
+#ifndef CONFIGSERVICE_H
+#define CONFIGSERVICE_H
+
+#include <QObject>
+#include <QJsonObject>
+#include <QStringList>
+#include <QTimer>
+#include <QFutureWatcher>
+
+// 配置服务：参数保存在内存中，修改后延迟合并写盘
+// 写盘在后台线程进行，先写临时文件再替换（QSaveFile），中途失败不会损坏原文件
+// 另外按名称保存面板预设（面板尺寸、阈值、筛选条件等），切换面板时一键套用
+class ConfigService : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ConfigService(const QString &filePath, QObject *parent = nullptr);
+    ~ConfigService();
+
+    bool load();
+
+    QJsonObject parameters() const { return params; }
+    void setParameters(const QJsonObject &parameters);
+
+    QStringList presetNames() const;
+    QJsonObject preset(const QString &name) const;
+    void savePreset(const QString &name, const QJsonObject &parameters);
+    void removePreset(const QString &name);
+
+    void flush();       // 立即同步写出挂起的修改（退出前调用）
+
+    static const int kDebounceMs = 500;
+
+private:
+    void scheduleWrite();
+    void startWrite();
+    QJsonObject buildRoot() const;
+    static bool writeFile(const QString &filePath, const QJsonObject &root);
+
+    QString path;
+    QJsonObject params;
+    QJsonObject presets;
+    QTimer debounceTimer;
+    QFutureWatcher<bool> writer;
+    bool dirty;
+};
+
+#endif // CONFIGSERVICE_H
@@ -0,0 +1,172 @@
+#include "csvinputreader.h"
+#include "framestore.h"
+#include <cstring>
+
+static inline const char *lineEnd(const char *p, const char *end)
+{
+    const void *newline = std::memchr(p, '\n', size_t(end - p));
+    return newline ? static_cast<const char *>(newline) : end;
+}
+
+void CsvInputReader::readStreams(const char *begin, const char *end, const ParseSettings &settings,
+                                 const QVector<QVector<QString>> &patterns, const QVector<FrameStore *> &stores,
+                                 ParseDiagnostics *diagnostics, const QAtomicInt *cancel) const
+{
+    const int frameSize = settings.frameSize();
+    const int totalBytes = frameSize * 2;
+    const int streamCount = qMin(patterns.size(), stores.size());
+
+    const bool withTimestamp = settings.hasTimestamp();
+    const bool withSequence = settings.hasSequence();
+
+    QVector<QVector<QByteArray>> normalized;
+    normalized.reserve(streamCount);
+    for (int i = 0; i < streamCount; ++i) {
+        normalized.append(TouchDataParser::normalizePattern(patterns[i]));
+    }
+
+    // 时间戳计数器回绕时累加一个周期，保证每种类型的时间戳单调不减
+    QVector<TimestampUnwrapper> timestamps(streamCount, TimestampUnwrapper(settings.timestampBytes));
+
+    // 所有类型都达到 maxRows 后提前结束
+    int openStreams = streamCount;
+    const char *p = begin;
+    quint32 lineNumber = 0;
+    quint32 rows = 0;
+    while (p < end && openStreams > 0) {
+        if (isCancelled(cancel, ++rows)) {
+            break;
+        }
+        ++lineNumber;
+        const char *e = lineEnd(p, end);
+        const char *next = e < end ? e + 1 : end;
+
+        for (int i = 0; i < streamCount; ++i) {
+            if (!TouchDataParser::matchLine(p, e, settings.filterStartPos, normalized[i])) {
+                continue;
+            }
+
+            FrameStore &store = *stores[i];
+            if (settings.maxRows > 0 && store.frameCount() >= settings.maxRows) {
+                break;
+            }
+
+            const char *dataBegin = p;
+            const char *dataEnd = e;
+            if (settings.filterMode == 1) {
+                if (next >= end) {
+                    // 没有下一行了
+                    if (diagnostics) {
+                        diagnostics->record(p - begin, lineNumber, 0, ParseDiagnostics::MissingDataLine,
+                                            i, store.frameCount());
+                    }
+                    break;
+                }
+                dataBegin = next;
+                dataEnd = lineEnd(next, end);
+                next = dataEnd < end ? dataEnd + 1 : end;
+                ++lineNumber;
+            }
+
+            qint16 *slot = store.appendFrame();
+            int decoded = TouchDataParser::decodeLine(dataBegin, dataEnd, settings.rawDataPos, totalBytes,
+                                                      settings.isBigEndian, slot);
+
+            // 配置了时间戳/序号列却读不出来的行与数据不完整的行一样丢弃
+            bool metadataOk = true;
+            quint64 value = 0;
+            const int index = store.frameCount() - 1;
+            if (decoded == frameSize && withTimestamp) {
+                metadataOk = TouchDataParser::decodeField(dataBegin, dataEnd, settings.timestampPos,
+                                                          settings.timestampBytes, settings.isBigEndian, value);
+                if (metadataOk) {
+                    store.setTimestamp(index, qint64(timestamps[i].unwrap(value, index > 0)) * settings.timestampUnitUs);
+                }
+            }
+            if (decoded == frameSize && metadataOk && withSequence) {
+                metadataOk = TouchDataParser::decodeField(dataBegin, dataEnd, settings.sequencePos,
+                                                          settings.sequenceBytes, settings.isBigEndian, value);
+                store.setSequence(index, quint32(value));
+            }
+
+            if (decoded != frameSize || !metadataOk) {
+                store.discardLastFrame();
+
+                // 出错的行很少，在这里再走一遍找出具体的列和原因
+                if (diagnostics) {
+                    int column = 0;
+                    ParseDiagnostics::Reason reason = ParseDiagnostics::None;
+                    if (decoded != frameSize) {
+                        reason = TouchDataParser::diagnoseLine(dataBegin, dataEnd, settings.rawDataPos, totalBytes,
+                                                               column);
+                        if (reason == ParseDiagnostics::None) {
+                            reason = ParseDiagnostics::TooFewColumns;   // rx*tx 为 0 等参数问题
+                        }
+                    } else {
+                        const bool timestampBad = withTimestamp
+                            && !TouchDataParser::decodeField(dataBegin, dataEnd, settings.timestampPos,
+                                                             settings.timestampBytes, settings.isBigEndian, value);
+                        reason = timestampBad ? ParseDiagnostics::BadTimestamp : ParseDiagnostics::BadSequence;
+                        column = timestampBad ? settings.timestampPos : settings.sequencePos;
+                        const int byteCount = timestampBad ? settings.timestampBytes : settings.sequenceBytes;
+                        int badColumn = 0;
+                        if (TouchDataParser::diagnoseLine(dataBegin, dataEnd, column, byteCount, badColumn)
+                            != ParseDiagnostics::None) {
+                            column = badColumn;
+                        }
+                    }
+                    diagnostics->record(dataBegin - begin, lineNumber, column, reason, i, store.frameCount());
+                }
+            } else if (settings.maxRows > 0 && store.frameCount() == settings.maxRows) {
+                --openStreams;
+            }
+            break;
+        }
+        p = next;
+    }
+}
+
+TouchDataParser::Status CsvInputReader::readFirstFrame(const char *begin, const char *end,
+                                                       const ParseSettings &settings, QVector<qint16> &frame,
+                                                       int *decodedCount) const
+{
+    const QVector<QByteArray> pattern = TouchDataParser::normalizePattern(settings.pattern);
+    const char *p = begin;
+    while (p < end) {
+        const char *e = lineEnd(p, end);
+        const char *next = e < end ? e + 1 : end;
+
+        if (TouchDataParser::matchLine(p, e, settings.filterStartPos, pattern)) {
+            const char *dataBegin = p;
+            const char *dataEnd = e;
+            if (settings.filterMode == 1) {
+                dataBegin = next;
+                dataEnd = next < end ? lineEnd(next, end) : end;
+            }
+            // 去掉行尾的 '\r' 后判断是否为空行
+            const char *trimmedEnd = dataEnd;
+            if (trimmedEnd > dataBegin && *(trimmedEnd - 1) == '\r') {
+                --trimmedEnd;
+            }
+            if (trimmedEnd == dataBegin) {
+                return TouchDataParser::EmptyLine;
+            }
+
+            const int frameSize = settings.frameSize();
+            QVector<qint16> data(frameSize);
+            int decoded = TouchDataParser::decodeLine(dataBegin, dataEnd, settings.rawDataPos, frameSize * 2,
+                                                      settings.isBigEndian, data.data());
+            if (decodedCount) {
+                *decodedCount = decoded;
+            }
+            if (decoded == 0 || decoded != frameSize) {
+                return TouchDataParser::SizeMismatch;
+            }
+            frame = data;
+            return TouchDataParser::Ok;
+        }
+        p = next;
+    }
+
+    return TouchDataParser::NoMatch;
+}
@@ -0,0 +1,18 @@
+#ifndef CSVINPUTREADER_H
+#define CSVINPUTREADER_H
+
+#include "touchinputreader.h"
+
+// 逗号分隔的十六进制文本：每行一条记录，帧头在 filterStartPos 列，
+// 数据在本行或下一行（filterMode）的 rawDataPos 列起
+class CsvInputReader : public TouchInputReader
+{
+public:
+    void readStreams(const char *begin, const char *end, const ParseSettings &settings,
+                     const QVector<QVector<QString>> &patterns, const QVector<FrameStore *> &stores,
+                     ParseDiagnostics *diagnostics, const QAtomicInt *cancel) const override;
+    TouchDataParser::Status readFirstFrame(const char *begin, const char *end, const ParseSettings &settings,
+                                           QVector<qint16> &frame, int *decodedCount) const override;
+};
+
+#endif // CSVINPUTREADER_H
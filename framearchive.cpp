@@ -0,0 +1,391 @@
+#include "framearchive.h"
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const char kMagic[8] = { 'R', 'G', 'D', 'F', 'R', 'A', 'R', '1' };
+const quint32 kVersion = 1;
+const int kHeaderSize = 48;
+const int kIndexEntrySize = 16;
+const quint32 kFlagBaseline = 0x1;
+
+// 每块原始数据约 256KB：足够让 zlib 找到重复，又能保持随机访问时的解码量较小
+const int kBlockSamples = 128 * 1024;
+
+// 随机访问时缓存的块数：顺序播放每块只解码一次，在块边界附近来回跳帧也不会反复解码
+const int kCachedBlocks = 4;
+
+// 读取时的上限：损坏的文件头不能让尺寸计算溢出，也不能让 qUncompress 按伪造的长度分配
+const int kMaxPanelSide = 65535;
+const qint64 kMaxFrameSamples = 16 * 1024 * 1024;
+const qint64 kMaxBlockBytes = 256 * 1024 * 1024;
+
+inline quint16 zigzagEncode(quint16 delta)
+{
+    qint16 value = qint16(delta);
+    return quint16((quint16(value) << 1) ^ quint16(value >> 15));
+}
+
+inline quint16 zigzagDecode(quint16 value)
+{
+    return quint16((value >> 1) ^ quint16(0 - (value & 1)));
+}
+
+// 编码一个块：帧间差分 -> zigzag -> 低/高字节分平面 -> zlib
+QByteArray encodeBlock(const FrameStore &frames, int firstFrame, int frameCount, const qint16 *reference)
+{
+    const int frameSize = frames.frameSize();
+    const int samples = frameCount * frameSize;
+    QByteArray planes(samples * 2, Qt::Uninitialized);
+    uchar *low = reinterpret_cast<uchar *>(planes.data());
+    uchar *high = low + samples;
+
+    const qint16 *previous = reference;
+    for (int f = 0; f < frameCount; ++f) {
+        const qint16 *current = frames.frame(firstFrame + f);
+        int base = f * frameSize;
+        for (int i = 0; i < frameSize; ++i) {
+            quint16 z = zigzagEncode(quint16(current[i] - previous[i]));
+            low[base + i] = uchar(z & 0xFF);
+            high[base + i] = uchar(z >> 8);
+        }
+        previous = current;
+    }
+
+    return qCompress(reinterpret_cast<const uchar *>(planes.constData()), planes.size());
+}
+
+} // namespace
+
+bool FrameArchive::isArchive(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    char magic[sizeof(kMagic)];
+    return file.read(magic, sizeof(magic)) == qint64(sizeof(magic))
+        && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0;
+}
+
+bool FrameArchive::write(QIODevice &device, const FrameStore &frames, int rxCount, int txCount,
+                         const QVector<qint16> &baseline)
+{
+    const int frameSize = frames.frameSize();
+    if (frameSize <= 0 || frameSize != rxCount * txCount) {
+        return false;
+    }
+
+    const bool hasBaseline = (baseline.size() == frameSize);
+    const QVector<qint16> zeros(hasBaseline ? 0 : frameSize, 0);
+    const qint16 *reference = hasBaseline ? baseline.constData() : zeros.constData();
+
+    const int framesPerBlock = qMax(1, kBlockSamples / frameSize);
+    const int blockCount = (frames.frameCount() + framesPerBlock - 1) / framesPerBlock;
+
+    // 各块互不依赖，并行压缩
+    QVector<QByteArray> blocks(blockCount);
+    QByteArray *blockData = blocks.data();
+    QVector<int> blockNumbers(blockCount);
+    for (int i = 0; i < blockCount; ++i) {
+        blockNumbers[i] = i;
+    }
+    QtConcurrent::blockingMap(blockNumbers, [&](int block) {
+        int first = block * framesPerBlock;
+        int count = qMin(framesPerBlock, frames.frameCount() - first);
+        blockData[block] = encodeBlock(frames, first, count, reference);
+    });
+
+    // 文件头
+    const qint64 baselineBytes = hasBaseline ? qint64(frameSize) * 2 : 0;
+    qint64 offset = kHeaderSize + baselineBytes;
+    qint64 indexOffset = offset;
+    for (const QByteArray &block : blocks) {
+        indexOffset += block.size();
+    }
+
+    uchar header[kHeaderSize];
+    std::memset(header, 0, sizeof(header));
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    qToLittleEndian<quint32>(kVersion, header + 8);
+    qToLittleEndian<quint32>(quint32(rxCount), header + 12);
+    qToLittleEndian<quint32>(quint32(txCount), header + 16);
+    qToLittleEndian<quint32>(quint32(frames.frameCount()), header + 20);
+    qToLittleEndian<quint32>(quint32(framesPerBlock), header + 24);
+    qToLittleEndian<quint32>(quint32(blockCount), header + 28);
+    qToLittleEndian<quint32>(hasBaseline ? kFlagBaseline : 0, header + 32);
+    qToLittleEndian<quint64>(quint64(indexOffset), header + 40);
+    if (device.write(reinterpret_cast<const char *>(header), kHeaderSize) != kHeaderSize) {
+        return false;
+    }
+
+    if (hasBaseline) {
+        QByteArray baselineBuffer(int(baselineBytes), Qt::Uninitialized);
+        for (int i = 0; i < frameSize; ++i) {
+            qToLittleEndian<qint16>(baseline[i], baselineBuffer.data() + i * 2);
+        }
+        if (device.write(baselineBuffer) != baselineBytes) {
+            return false;
+        }
+    }
+
+    // 数据块 + 块索引
+    QByteArray index(blockCount * kIndexEntrySize, Qt::Uninitialized);
+    for (int block = 0; block < blockCount; ++block) {
+        const QByteArray &data = blocks[block];
+        int first = block * framesPerBlock;
+        uchar *entry = reinterpret_cast<uchar *>(index.data()) + block * kIndexEntrySize;
+        qToLittleEndian<quint64>(quint64(offset), entry);
+        qToLittleEndian<quint32>(quint32(data.size()), entry + 8);
+        qToLittleEndian<quint32>(quint32(qMin(framesPerBlock, frames.frameCount() - first)), entry + 12);
+        if (device.write(data) != data.size()) {
+            return false;
+        }
+        offset += data.size();
+    }
+    return device.write(index) == index.size();
+}
+
+bool FrameArchive::write(const QString &filePath, const FrameStore &frames, int rxCount, int txCount,
+                         const QVector<qint16> &baseline)
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    if (!write(file, frames, rxCount, txCount, baseline)) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+FrameArchiveReader::FrameArchiveReader()
+    : mapped(nullptr)
+    , fileSize(0)
+    , rx(0)
+    , tx(0)
+    , frames(0)
+    , framesPerBlock(1)
+{
+}
+
+void FrameArchiveReader::close()
+{
+    if (mapped && buffer.isEmpty()) {
+        file.unmap(const_cast<uchar *>(mapped));
+    }
+    file.close();
+    mapped = nullptr;
+    buffer.clear();
+    fileSize = 0;
+    rx = tx = frames = 0;
+    framesPerBlock = 1;
+    baselineData.clear();
+    blockIndex.clear();
+    cache.clear();
+}
+
+bool FrameArchiveReader::open(const QString &filePath)
+{
+    close();
+
+    file.setFileName(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    fileSize = file.size();
+    if (fileSize < kHeaderSize) {
+        close();
+        return false;
+    }
+
+    // 优先内存映射，压缩数据直接从映射区解码
+    mapped = file.map(0, fileSize);
+    if (!mapped) {
+        buffer = file.readAll();
+        mapped = reinterpret_cast<const uchar *>(buffer.constData());
+    }
+
+    const uchar *header = mapped;
+    if (std::memcmp(header, kMagic, sizeof(kMagic)) != 0
+        || qFromLittleEndian<quint32>(header + 8) != kVersion) {
+        close();
+        return false;
+    }
+
+    // 先以 64 位检查各字段，确认 rx * tx、每块字节数都不会溢出后再转换为 int
+    const quint32 rxField = qFromLittleEndian<quint32>(header + 12);
+    const quint32 txField = qFromLittleEndian<quint32>(header + 16);
+    const quint32 framesField = qFromLittleEndian<quint32>(header + 20);
+    const quint32 framesPerBlockField = qFromLittleEndian<quint32>(header + 24);
+    const quint32 blocksField = qFromLittleEndian<quint32>(header + 28);
+    const quint32 flags = qFromLittleEndian<quint32>(header + 32);
+    const quint64 indexOffsetField = qFromLittleEndian<quint64>(header + 40);
+    const qint64 samplesPerFrame = qint64(rxField) * qint64(txField);
+    if (rxField == 0 || txField == 0 || rxField > quint32(kMaxPanelSide) || txField > quint32(kMaxPanelSide)
+        || samplesPerFrame > kMaxFrameSamples || framesPerBlockField == 0
+        || qint64(framesPerBlockField) * samplesPerFrame * 2 > kMaxBlockBytes
+        || framesField > quint32(std::numeric_limits<int>::max()) || blocksField > framesField
+        || indexOffsetField > quint64(fileSize)) {
+        close();
+        return false;
+    }
+
+    rx = int(rxField);
+    tx = int(txField);
+    frames = int(framesField);
+    framesPerBlock = int(framesPerBlockField);
+    const int blocks = int(blocksField);
+    const qint64 indexOffset = qint64(indexOffsetField);
+
+    const qint64 baselineBytes = (flags & kFlagBaseline) ? samplesPerFrame * 2 : 0;
+    if (kHeaderSize + baselineBytes > fileSize
+        || indexOffset < kHeaderSize || indexOffset + qint64(blocks) * kIndexEntrySize > fileSize) {
+        close();
+        return false;
+    }
+
+    if (baselineBytes > 0) {
+        baselineData.resize(frameSize());
+        for (int i = 0; i < frameSize(); ++i) {
+            baselineData[i] = qFromLittleEndian<qint16>(mapped + kHeaderSize + i * 2);
+        }
+    }
+
+    // 除最后一块外每块都必须是满的，块内帧数之和等于总帧数
+    blockIndex.resize(blocks);
+    qint64 firstFrame = 0;
+    for (int block = 0; block < blocks; ++block) {
+        const uchar *entry = mapped + indexOffset + qint64(block) * kIndexEntrySize;
+        const quint64 offset = qFromLittleEndian<quint64>(entry);
+        const quint32 compressedSize = qFromLittleEndian<quint32>(entry + 8);
+        const quint32 frameCount = qFromLittleEndian<quint32>(entry + 12);
+        const bool lastBlock = (block == blocks - 1);
+        if (offset < quint64(kHeaderSize) || offset > quint64(indexOffset)
+            || compressedSize < 4 || compressedSize > quint64(indexOffset) - offset
+            || frameCount == 0 || frameCount > quint32(framesPerBlock)
+            || (!lastBlock && frameCount != quint32(framesPerBlock))) {
+            close();
+            return false;
+        }
+        BlockEntry &e = blockIndex[block];
+        e.offset = qint64(offset);
+        e.compressedSize = int(compressedSize);
+        e.frameCount = int(frameCount);
+        e.firstFrame = int(firstFrame);
+        firstFrame += frameCount;
+    }
+    if (firstFrame != frames) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool FrameArchiveReader::decodeBlockTo(int block, FrameStore *store, qint16 *contiguous) const
+{
+    if (block < 0 || block >= blockIndex.size()) {
+        return false;
+    }
+
+    // qUncompress 按压缩数据前 4 字节（大端）记录的长度分配，先确认与块的大小一致
+    const BlockEntry &entry = blockIndex[block];
+    const int frameSize = rx * tx;
+    const int samples = entry.frameCount * frameSize;
+    if (qFromBigEndian<quint32>(mapped + entry.offset) != quint32(samples) * 2) {
+        return false;
+    }
+    const QByteArray planes = qUncompress(mapped + entry.offset, entry.compressedSize);
+    if (planes.size() != samples * 2) {
+        return false;
+    }
+
+    const uchar *low = reinterpret_cast<const uchar *>(planes.constData());
+    const uchar *high = low + samples;
+    const QVector<qint16> zeros(baselineData.isEmpty() ? frameSize : 0, 0);
+    const qint16 *previous = baselineData.isEmpty() ? zeros.constData() : baselineData.constData();
+
+    for (int f = 0; f < entry.frameCount; ++f) {
+        qint16 *current = store ? store->mutableFrame(entry.firstFrame + f) : contiguous + f * frameSize;
+        int base = f * frameSize;
+        for (int i = 0; i < frameSize; ++i) {
+            quint16 delta = zigzagDecode(quint16(low[base + i] | (high[base + i] << 8)));
+            current[i] = qint16(quint16(quint16(previous[i]) + delta));
+        }
+        previous = current;
+    }
+    return true;
+}
+
+bool FrameArchiveReader::decodeBlock(int block, QVector<qint16> &out) const
+{
+    if (block < 0 || block >= blockIndex.size()) {
+        return false;
+    }
+    out.resize(blockIndex[block].frameCount * frameSize());
+    return decodeBlockTo(block, nullptr, out.data());
+}
+
+const qint16 *FrameArchiveReader::frame(int index)
+{
+    if (index < 0 || index >= frames) {
+        return nullptr;
+    }
+
+    // 除最后一块外每块帧数相同，直接定位
+    const int block = index / framesPerBlock;
+    for (int i = 0; i < cache.size(); ++i) {
+        if (cache[i].block == block) {
+            if (i > 0) {
+                cache.move(i, 0);
+            }
+            return cache[0].samples.constData() + (index - blockIndex[block].firstFrame) * frameSize();
+        }
+    }
+
+    // 缓存满时复用最久未用的块的缓冲
+    if (cache.size() < kCachedBlocks) {
+        cache.prepend(CachedBlock{ -1, QVector<qint16>() });
+    } else {
+        cache.move(cache.size() - 1, 0);
+    }
+    CachedBlock &entry = cache[0];
+    entry.block = -1;
+    if (!decodeBlock(block, entry.samples)) {
+        return nullptr;
+    }
+    entry.block = block;
+    return entry.samples.constData() + (index - blockIndex[block].firstFrame) * frameSize();
+}
+
+bool FrameArchiveReader::readAll(FrameStore &store, const QAtomicInt *cancel) const
+{
+    store.reset(frameSize());
+    for (int i = 0; i < frames; ++i) {
+        store.appendFrame();
+    }
+    store.detachForWrite();
+
+    // 各块独立，并行解码后直接写入帧存储
+    QVector<int> blockNumbers(blockIndex.size());
+    for (int i = 0; i < blockNumbers.size(); ++i) {
+        blockNumbers[i] = i;
+    }
+    QAtomicInt failures(0);
+    QtConcurrent::blockingMap(blockNumbers, [&](int block) {
+        if ((cancel && cancel->loadRelaxed() != 0) || !decodeBlockTo(block, &store, nullptr)) {
+            failures.ref();
+        }
+    });
+
+    if (failures.loadAcquire() != 0) {
+        store.clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,85 @@
+#ifndef FRAMEARCHIVE_H
+#define FRAMEARCHIVE_H
+
+#include <QAtomicInt>
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include "framestore.h"
+
+class QIODevice;
+
+// RGD 帧归档 (.rgdf)
+//
+// 文件头 | 基线(可选) | 数据块... | 块索引
+// 每个数据块独立压缩：块内第一帧与基线（无基线时与 0）做差，其余帧与上一帧做差，
+// 差值经 zigzag 编码后按低/高字节分平面存放，再用 zlib 压缩。
+// 块索引记录每块的偏移，定位任意帧只需一次除法加一次块解码；各块互不依赖，也可并行解码整个归档。
+class FrameArchive
+{
+public:
+    static const char *suffix() { return "rgdf"; }
+    static bool isArchive(const QString &filePath);
+
+    static bool write(QIODevice &device, const FrameStore &frames, int rxCount, int txCount,
+                      const QVector<qint16> &baseline);
+    static bool write(const QString &filePath, const FrameStore &frames, int rxCount, int txCount,
+                      const QVector<qint16> &baseline);
+};
+
+class FrameArchiveReader
+{
+public:
+    FrameArchiveReader();
+
+    bool open(const QString &filePath);
+    void close();
+
+    int rxCount() const { return rx; }
+    int txCount() const { return tx; }
+    int frameSize() const { return rx * tx; }
+    int frameCount() const { return frames; }
+    int blockCount() const { return blockIndex.size(); }
+    const QVector<qint16> &baseline() const { return baselineData; }
+
+    // 解码单个块（线程安全），out 依次存放该块所有帧
+    bool decodeBlock(int block, QVector<qint16> &out) const;
+
+    // 随机访问一帧，只解码该帧所在的块；最近用过的几个块保留在缓存中（非线程安全）
+    // 返回的指针在下一次调用 frame() 前有效，块损坏时返回 nullptr
+    const qint16 *frame(int index);
+
+    // 并行解码所有块到帧存储；cancel 置位后剩下的块不再解码并返回 false
+    bool readAll(FrameStore &store, const QAtomicInt *cancel = nullptr) const;
+
+private:
+    struct BlockEntry
+    {
+        qint64 offset;
+        int compressedSize;
+        int firstFrame;
+        int frameCount;
+    };
+
+    struct CachedBlock
+    {
+        int block;
+        QVector<qint16> samples;
+    };
+
+    bool decodeBlockTo(int block, FrameStore *store, qint16 *contiguous) const;
+
+    QFile file;
+    const uchar *mapped;
+    QByteArray buffer;          // 无法映射时的整文件缓冲
+    qint64 fileSize;
+    int rx;
+    int tx;
+    int frames;
+    int framesPerBlock;
+    QVector<qint16> baselineData;
+    QVector<BlockEntry> blockIndex;
+    QVector<CachedBlock> cache;  // 最近使用的在前
+};
+
+#endif // FRAMEARCHIVE_H
@@ -0,0 +1,37 @@
+#include "framearena.h"
+#include <cstdint>
+
+FrameArena::FrameArena(size_t initialBytes)
+    : block(new char[initialBytes])
+    , blockSize(initialBytes)
+    , used(0)
+    , overflowBytes(0)
+{
+}
+
+void FrameArena::reset()
+{
+    if (!overflow.empty()) {
+        // 上一帧溢出：合并成一个足够大的主块
+        blockSize = used + overflowBytes;
+        block.reset(new char[blockSize]);
+        overflow.clear();
+        overflowBytes = 0;
+    }
+    used = 0;
+}
+
+void *FrameArena::allocateBytes(size_t bytes, size_t alignment)
+{
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.get());
+    const size_t offset = ((base + used + alignment - 1) & ~uintptr_t(alignment - 1)) - base;
+    if (offset + bytes <= blockSize) {
+        used = offset + bytes;
+        return block.get() + offset;
+    }
+
+    // new char[] 的返回值满足基本类型的对齐要求
+    overflow.emplace_back(new char[bytes]);
+    overflowBytes += bytes + alignment;
+    return overflow.back().get();
+}
@@ -0,0 +1,35 @@
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <QtGlobal>
+#include <memory>
+#include <vector>
+
+// 帧内临时缓冲：单调递增分配，每帧开始时 reset() 整体回收
+// 某一帧用量超过当前块时临时分配溢出块，下次 reset() 时把主块扩大到峰值用量，
+// 之后同样规模的帧不再产生任何堆分配
+class FrameArena
+{
+public:
+    explicit FrameArena(size_t initialBytes = 256 * 1024);
+
+    template <typename T>
+    T *allocate(int count)
+    {
+        return static_cast<T *>(allocateBytes(size_t(count) * sizeof(T), alignof(T)));
+    }
+
+    void reset();
+    size_t capacity() const { return blockSize; }
+
+private:
+    void *allocateBytes(size_t bytes, size_t alignment);
+
+    std::unique_ptr<char[]> block;
+    size_t blockSize;
+    size_t used;
+    size_t overflowBytes;                              // 本帧溢出块的总字节数
+    std::vector<std::unique_ptr<char[]>> overflow;
+};
+
+#endif // FRAMEARENA_H
@@ -0,0 +1,366 @@
+#include "frameexporter.h"
+#include "framearchive.h"
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtConcurrent>
+#include <QtEndian>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+// 固定大小的写缓冲，写满后整块交给设备，格式化过程不做堆分配
+class OutputBuffer
+{
+public:
+    explicit OutputBuffer(QIODevice &device) : device(device), used(0), failed(false) {}
+    ~OutputBuffer() { flush(); }
+
+    char *reserve(int bytes)
+    {
+        if (used + bytes > int(sizeof(data))) {
+            flush();
+        }
+        return data + used;
+    }
+    void commit(int bytes) { used += bytes; }
+
+    void append(const char *text, int length)
+    {
+        if (length > int(sizeof(data))) {
+            flush();
+            failed |= device.write(text, length) != length;
+            return;
+        }
+        std::memcpy(reserve(length), text, size_t(length));
+        used += length;
+    }
+    void append(char c) { *reserve(1) = c; used++; }
+
+    bool flush()
+    {
+        if (used > 0) {
+            failed |= device.write(data, used) != used;
+            used = 0;
+        }
+        return !failed;
+    }
+
+private:
+    QIODevice &device;
+    char data[64 * 1024];
+    int used;
+    bool failed;
+};
+
+// 字节 -> 两位大写十六进制字符
+struct HexTable
+{
+    char digits[256][2];
+    HexTable()
+    {
+        const char *alphabet = "0123456789ABCDEF";
+        for (int i = 0; i < 256; ++i) {
+            digits[i][0] = alphabet[i >> 4];
+            digits[i][1] = alphabet[i & 0xF];
+        }
+    }
+};
+
+const HexTable &hexTable()
+{
+    static const HexTable table;
+    return table;
+}
+
+inline void appendHex16(OutputBuffer &out, qint16 value)
+{
+    const HexTable &table = hexTable();
+    quint16 unsignedValue = static_cast<quint16>(value);
+    char *p = out.reserve(4);
+    std::memcpy(p, table.digits[unsignedValue >> 8], 2);
+    std::memcpy(p + 2, table.digits[unsignedValue & 0xFF], 2);
+    out.commit(4);
+}
+
+inline void appendInt(OutputBuffer &out, int value)
+{
+    char *p = out.reserve(16);
+    std::to_chars_result result = std::to_chars(p, p + 16, value);
+    out.commit(int(result.ptr - p));
+}
+
+inline void appendText(OutputBuffer &out, const char *text)
+{
+    out.append(text, int(std::strlen(text)));
+}
+
+// 旧版以 QIODevice::Text 写出，Windows 上换行为 CRLF；这里直接写入平台换行符，不经过文本模式的逐行转换
+#ifdef Q_OS_WIN
+const char kLineEnd[] = "\r\n";
+#else
+const char kLineEnd[] = "\n";
+#endif
+
+inline void appendLineEnd(OutputBuffer &out)
+{
+    out.append(kLineEnd, int(sizeof(kLineEnd)) - 1);
+}
+
+// 每个值一行，最后一个值后不换行
+void appendHexLines(OutputBuffer &out, const qint16 *values, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        appendHex16(out, values[i]);
+        if (i < count - 1) {
+            appendLineEnd(out);
+        }
+    }
+}
+
+// 与旧版 touchData.txt 完全一致的 16 进制文本（含平台换行符）
+class HexTextFormat : public FrameExportFormat
+{
+public:
+    QString name() const override { return QObject::tr("16进制文本"); }
+    QString suffix() const override { return "txt"; }
+
+    bool write(QIODevice &device, const FrameStore &frames, int, int,
+               const QVector<qint16> &) const override
+    {
+        OutputBuffer out(device);
+        const int frameSize = frames.frameSize();
+        const int frameCount = frames.frameCount();
+        for (int frame = 0; frame < frameCount; ++frame) {
+            appendText(out, "Frame ");
+            appendInt(out, frame);
+            appendText(out, ":");
+            appendLineEnd(out);
+            appendHexLines(out, frames.frame(frame), frameSize);
+            if (frame < frameCount - 1) {
+                appendLineEnd(out);
+                appendLineEnd(out);
+            }
+        }
+        return out.flush();
+    }
+};
+
+class RawBinaryFormat : public FrameExportFormat
+{
+public:
+    QString name() const override { return QObject::tr("原始二进制 int16 小端"); }
+    QString suffix() const override { return "bin"; }
+
+    bool write(QIODevice &device, const FrameStore &frames, int, int,
+               const QVector<qint16> &) const override
+    {
+        OutputBuffer out(device);
+        writeLittleEndianFrames(out, frames);
+        return out.flush();
+    }
+
+    static void writeLittleEndianFrames(OutputBuffer &out, const FrameStore &frames)
+    {
+        const int frameSize = frames.frameSize();
+        const int frameBytes = frameSize * int(sizeof(qint16));
+        for (int frame = 0; frame < frames.frameCount(); ++frame) {
+            const qint16 *frameData = frames.frame(frame);
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+            out.append(reinterpret_cast<const char *>(frameData), frameBytes);
+#else
+            for (int i = 0; i < frameSize; ++i) {
+                qToLittleEndian<qint16>(frameData[i], out.reserve(2));
+                out.commit(2);
+            }
+            Q_UNUSED(frameBytes);
+#endif
+        }
+    }
+};
+
+class CsvFormat : public FrameExportFormat
+{
+public:
+    QString name() const override { return QObject::tr("CSV 10进制"); }
+    QString suffix() const override { return "csv"; }
+
+    bool write(QIODevice &device, const FrameStore &frames, int rxCount, int txCount,
+               const QVector<qint16> &) const override
+    {
+        OutputBuffer out(device);
+
+        // 表头：frame,TX0_RX0,TX0_RX1,...
+        appendText(out, "frame");
+        for (int tx = 0; tx < txCount; ++tx) {
+            for (int rx = 0; rx < rxCount; ++rx) {
+                appendText(out, ",TX");
+                appendInt(out, tx);
+                appendText(out, "_RX");
+                appendInt(out, rx);
+            }
+        }
+        out.append('\n');
+
+        const int frameSize = frames.frameSize();
+        for (int frame = 0; frame < frames.frameCount(); ++frame) {
+            appendInt(out, frame);
+            const qint16 *frameData = frames.frame(frame);
+            for (int i = 0; i < frameSize; ++i) {
+                out.append(',');
+                appendInt(out, frameData[i]);
+            }
+            out.append('\n');
+        }
+        return out.flush();
+    }
+};
+
+class NpyFormat : public FrameExportFormat
+{
+public:
+    QString name() const override { return QObject::tr("NumPy 数组"); }
+    QString suffix() const override { return "npy"; }
+
+    bool write(QIODevice &device, const FrameStore &frames, int rxCount, int txCount,
+               const QVector<qint16> &) const override
+    {
+        // NPY 1.0：魔数 + 版本 + 头长度(小端 uint16) + 字典，整个头部按 64 字节对齐
+        QByteArray header = QString("{'descr': '<i2', 'fortran_order': False, 'shape': (%1, %2, %3), }")
+                                .arg(frames.frameCount()).arg(txCount).arg(rxCount).toLatin1();
+        const int preamble = 10;
+        int total = preamble + header.size() + 1;
+        int padding = (64 - total % 64) % 64;
+        header.append(QByteArray(padding, ' '));
+        header.append('\n');
+
+        OutputBuffer out(device);
+        out.append("\x93NUMPY", 6);
+        out.append(char(1));
+        out.append(char(0));
+        char length[2];
+        qToLittleEndian<quint16>(quint16(header.size()), length);
+        out.append(length, 2);
+        out.append(header.constData(), header.size());
+
+        RawBinaryFormat::writeLittleEndianFrames(out, frames);
+        return out.flush();
+    }
+};
+
+class ArchiveFormat : public FrameExportFormat
+{
+public:
+    QString name() const override { return QObject::tr("RGD 压缩归档"); }
+    QString suffix() const override { return FrameArchive::suffix(); }
+
+    bool write(QIODevice &device, const FrameStore &frames, int rxCount, int txCount,
+               const QVector<qint16> &baseline) const override
+    {
+        return FrameArchive::write(device, frames, rxCount, txCount, baseline);
+    }
+};
+
+} // namespace
+
+const FrameExportFormat &FrameExporter::format(Format format)
+{
+    static const HexTextFormat hexText;
+    static const RawBinaryFormat rawBinary;
+    static const CsvFormat csv;
+    static const NpyFormat npy;
+    static const ArchiveFormat archive;
+
+    switch (format) {
+    case RawBinary: return rawBinary;
+    case Csv: return csv;
+    case Npy: return npy;
+    case Archive: return archive;
+    case HexText: break;
+    }
+    return hexText;
+}
+
+QString FrameExporter::fileDialogFilter()
+{
+    QStringList filters;
+    for (Format f : { Archive, Npy, Csv, RawBinary, HexText }) {
+        const FrameExportFormat &exportFormat = format(f);
+        filters << QString("%1 (*.%2)").arg(exportFormat.name(), exportFormat.suffix());
+    }
+    return filters.join(";;");
+}
+
+FrameExporter::Format FrameExporter::formatForFilter(const QString &selectedFilter, const QString &filePath)
+{
+    // 优先按文件后缀判断，其次按对话框中选择的过滤器
+    QString suffix = QFileInfo(filePath).suffix().toLower();
+    for (Format f : { Archive, Npy, Csv, RawBinary, HexText }) {
+        if (format(f).suffix() == suffix) {
+            return f;
+        }
+    }
+    for (Format f : { Archive, Npy, Csv, RawBinary, HexText }) {
+        if (selectedFilter.contains("*." + format(f).suffix())) {
+            return f;
+        }
+    }
+    return HexText;
+}
+
+bool FrameExporter::exportFrames(const FrameStore &frames, int rxCount, int txCount,
+                                 const QString &filePath, Format exportFormat,
+                                 const QVector<qint16> &baseline)
+{
+    // QSaveFile 先写临时文件再原子替换，导出失败不会留下半个文件
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    if (!format(exportFormat).write(file, frames, rxCount, txCount, baseline)) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+QFuture<bool> FrameExporter::exportInBackground(const FrameStore &frames, int rxCount, int txCount,
+                                                const QString &filePath, Format format,
+                                                const QVector<qint16> &baseline,
+                                                const QFuture<bool> &previous)
+{
+    FrameStore snapshot = frames;
+    return QtConcurrent::run([snapshot, rxCount, txCount, filePath, format, baseline,
+                              waiting = previous]() mutable {
+        waiting.waitForFinished();
+        return exportFrames(snapshot, rxCount, txCount, filePath, format, baseline);
+    });
+}
+
+bool FrameExporter::exportBaseline(const QVector<qint16> &baseline, const QString &filePath)
+{
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    bool ok;
+    {
+        OutputBuffer out(file);
+        appendHexLines(out, baseline.constData(), baseline.size());
+        ok = out.flush();
+    }
+    if (!ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+QFuture<bool> FrameExporter::exportBaselineInBackground(const QVector<qint16> &baseline, const QString &filePath,
+                                                        const QFuture<bool> &previous)
+{
+    return QtConcurrent::run([baseline, filePath, waiting = previous]() mutable {
+        waiting.waitForFinished();
+        return exportBaseline(baseline, filePath);
+    });
+}
@@ -0,0 +1,54 @@
+#ifndef FRAMEEXPORTER_H
+#define FRAMEEXPORTER_H
+
+#include <QFuture>
+#include <QString>
+#include <QStringList>
+#include "framestore.h"
+
+class QIODevice;
+
+// 帧导出：每种格式实现一个 FrameExportFormat，在后台线程中写出
+class FrameExportFormat
+{
+public:
+    virtual ~FrameExportFormat() = default;
+
+    virtual QString name() const = 0;           // 显示名称
+    virtual QString suffix() const = 0;         // 文件后缀（不含点）
+    virtual bool write(QIODevice &device, const FrameStore &frames, int rxCount, int txCount,
+                       const QVector<qint16> &baseline) const = 0;
+};
+
+class FrameExporter
+{
+public:
+    enum Format {
+        HexText,        // 与旧版 touchData.txt 相同的 16 进制文本
+        RawBinary,      // 小端 int16 帧数据首尾相接
+        Csv,            // 每行一帧，10 进制
+        Npy,            // NumPy .npy，形状 (帧数, tx, rx)，可直接 np.load(mmap_mode='r')
+        Archive         // RGD 压缩归档 .rgdf，可直接重新读取
+    };
+
+    static const FrameExportFormat &format(Format format);
+    static QString fileDialogFilter();                           // 文件对话框过滤器
+    static Format formatForFilter(const QString &selectedFilter, const QString &filePath);
+
+    static bool exportFrames(const FrameStore &frames, int rxCount, int txCount,
+                             const QString &filePath, Format format,
+                             const QVector<qint16> &baseline = QVector<qint16>());
+    // 后台导出前先复制 frames（QVector 隐式共享，只复制引用），导出期间重新读取数据不影响写出内容
+    // previous 为上一次后台导出，先等它写完再开始，连续导出同一文件时按顺序进行
+    static QFuture<bool> exportInBackground(const FrameStore &frames, int rxCount, int txCount,
+                                            const QString &filePath, Format format,
+                                            const QVector<qint16> &baseline = QVector<qint16>(),
+                                            const QFuture<bool> &previous = QFuture<bool>());
+
+    // 基线：与旧版 baseLine.txt 相同的 16 进制文本，每个节点一行
+    static bool exportBaseline(const QVector<qint16> &baseline, const QString &filePath);
+    static QFuture<bool> exportBaselineInBackground(const QVector<qint16> &baseline, const QString &filePath,
+                                                    const QFuture<bool> &previous = QFuture<bool>());
+};
+
+#endif // FRAMEEXPORTER_H
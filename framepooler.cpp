@@ -0,0 +1,88 @@
+#include "framepooler.h"
+#include <algorithm>
+
+namespace {
+
+// 逐块取最大值：按输入行顺序读取，每个输出行先复制第一行的块最大值，其余行再与之比较
+template <typename T>
+void maxPool(const T *data, int rxCount, int txCount, int factor, T *out)
+{
+    const int pooledRx = FramePooler::pooledCount(rxCount, factor);
+    for (int ty = 0; ty * factor < txCount; ++ty) {
+        T *outRow = out + ty * pooledRx;
+        const int rowEnd = qMin(txCount, (ty + 1) * factor);
+        for (int row = ty * factor; row < rowEnd; ++row) {
+            const T *line = data + row * rxCount;
+            for (int bx = 0; bx < pooledRx; ++bx) {
+                const T *block = line + bx * factor;
+                const int width = qMin(factor, rxCount - bx * factor);
+                const T value = *std::max_element(block, block + width);
+                outRow[bx] = (row == ty * factor) ? value : qMax(outRow[bx], value);
+            }
+        }
+    }
+}
+
+} // namespace
+
+int FramePooler::autoFactor(int rxCount, int txCount, int width, int height, int minCellWidth, int minCellHeight)
+{
+    if (rxCount <= 0 || txCount <= 0 || width <= 0 || height <= 0) {
+        return 1;
+    }
+
+    int factor = 1;
+    while (factor < 256
+           && (pooledCount(rxCount, factor) * minCellWidth > width
+               || pooledCount(txCount, factor) * minCellHeight > height)) {
+        factor *= 2;
+    }
+    return factor;
+}
+
+void FramePooler::pool(const qint16 *data, int rxCount, int txCount, int factor, Mode mode, qint16 *out)
+{
+    if (factor <= 1) {
+        std::copy(data, data + rxCount * txCount, out);
+        return;
+    }
+    if (mode == MaxPool) {
+        maxPool(data, rxCount, txCount, factor, out);
+        return;
+    }
+
+    // 均值：每块的和最多 factor² 个 qint16，factor 不超过 256 时 int 不会溢出
+    const int pooledRx = pooledCount(rxCount, factor);
+    for (int ty = 0; ty * factor < txCount; ++ty) {
+        const int rowEnd = qMin(txCount, (ty + 1) * factor);
+        for (int bx = 0; bx < pooledRx; ++bx) {
+            const int columnEnd = qMin(rxCount, (bx + 1) * factor);
+            int sum = 0;
+            for (int row = ty * factor; row < rowEnd; ++row) {
+                const qint16 *line = data + row * rxCount;
+                for (int column = bx * factor; column < columnEnd; ++column) {
+                    sum += line[column];
+                }
+            }
+            const int cells = (rowEnd - ty * factor) * (columnEnd - bx * factor);
+            out[ty * pooledRx + bx] = qint16(sum / cells);
+        }
+    }
+}
+
+void FramePooler::poolStates(const quint8 *states, int rxCount, int txCount, int factor, quint8 *out)
+{
+    if (factor <= 1) {
+        std::copy(states, states + rxCount * txCount, out);
+        return;
+    }
+    maxPool(states, rxCount, txCount, factor, out);
+}
+
+void FramePooler::crop(const qint16 *data, int rxCount, const QRect &region, qint16 *out)
+{
+    for (int row = 0; row < region.height(); ++row) {
+        const qint16 *line = data + (region.top() + row) * rxCount + region.left();
+        std::copy(line, line + region.width(), out + row * region.width());
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef FRAMEPOOLER_H
+#define FRAMEPOOLER_H
+
+#include <QRect>
+#include <QtGlobal>
+
+// 大面板的 ROI 裁剪和降采样概览：按 tx 行、rx 列排列的一帧数据，
+// 每 factor×factor 个节点合并为一个格子（最大值或均值）；最大值合并保证单个节点的峰值不会在缩小时丢失
+class FramePooler
+{
+public:
+    enum Mode {
+        MaxPool,
+        MeanPool
+    };
+
+    static int pooledCount(int count, int factor) { return (count + factor - 1) / factor; }
+
+    // 每个格子至少 minCellWidth × minCellHeight 像素时需要的最小合并倍数（1、2、4、8...）
+    static int autoFactor(int rxCount, int txCount, int width, int height, int minCellWidth, int minCellHeight);
+
+    // out 长度为 pooledCount(rx) * pooledCount(tx)；边缘不满的块只统计实际存在的节点
+    static void pool(const qint16 *data, int rxCount, int txCount, int factor, Mode mode, qint16 *out);
+    // 格子状态（PeakDetector::CellState）按块取最大，峰值优先于超阈值
+    static void poolStates(const quint8 *states, int rxCount, int txCount, int factor, quint8 *out);
+
+    // 复制 region（节点坐标，x = rx，y = tx，需在面板范围内）到 out，out 按 region 的行列排列
+    static void crop(const qint16 *data, int rxCount, const QRect &region, qint16 *out);
+};
+
+#endif // FRAMEPOOLER_H
@@ -0,0 +1,272 @@
+#include "framestore.h"
+#include "memorybudget.h"
+#include <algorithm>
+#include <cstring>
+
+// 每个块约 1MB，既能减少大文件加载时的重新分配，又不会让小文件浪费太多内存
+static const int kChunkSamples = 512 * 1024;
+
+FrameChunk::FrameChunk(int samples, bool spill)
+    : samples(nullptr)
+    , count(qMax(0, samples))
+    , spilled(false)
+{
+    allocate(spill);
+}
+
+FrameChunk::FrameChunk(const FrameChunk &other)
+    : QSharedData(other)
+    , samples(nullptr)
+    , count(other.count)
+    , spilled(false)
+{
+    allocate(false);
+    std::memcpy(samples, other.samples, sizeof(qint16) * size_t(count));
+}
+
+FrameChunk::~FrameChunk()
+{
+    release();
+}
+
+void FrameChunk::allocate(bool spill)
+{
+    const qint64 bytes = qint64(count) * qint64(sizeof(qint16));
+    if (!spill && MemoryBudget::reserveHeap(bytes)) {
+        samples = new qint16[count]();
+        return;
+    }
+    samples = static_cast<qint16 *>(MemoryBudget::mapSpill(bytes));
+    if (samples) {
+        spilled = true;
+        return;
+    }
+    // 换出文件不可用（磁盘满等）时只能放在堆上
+    MemoryBudget::forceHeap(bytes);
+    samples = new qint16[count]();
+}
+
+void FrameChunk::release()
+{
+    const qint64 bytes = qint64(count) * qint64(sizeof(qint16));
+    if (spilled) {
+        MemoryBudget::unmapSpill(samples, bytes);
+    } else {
+        delete[] samples;
+        MemoryBudget::releaseHeap(bytes);
+    }
+    samples = nullptr;
+}
+
+void FrameChunk::shrink(int size)
+{
+    if (spilled || size >= count || size < 0) {
+        return;
+    }
+    qint16 *smaller = new qint16[size];
+    std::memcpy(smaller, samples, sizeof(qint16) * size_t(size));
+    delete[] samples;
+    MemoryBudget::releaseHeap(qint64(count - size) * qint64(sizeof(qint16)));
+    samples = smaller;
+    count = size;
+}
+
+FrameStore::FrameStore()
+    : nodeCount(0)
+    , framesTotal(0)
+    , framesPerChunk(1)
+    , recordTimestamps(false)
+    , sequenceWidth(0)
+{
+}
+
+void FrameStore::reset(int frameSize)
+{
+    chunks.clear();
+    nodeCount = qMax(0, frameSize);
+    framesTotal = 0;
+    framesPerChunk = nodeCount > 0 ? qMax(1, kChunkSamples / nodeCount) : 1;
+    recordTimestamps = false;
+    sequenceWidth = 0;
+    frameTimes.clear();
+    frameSequences.clear();
+}
+
+void FrameStore::clear()
+{
+    chunks.clear();
+    framesTotal = 0;
+    frameTimes.clear();
+    frameSequences.clear();
+}
+
+void FrameStore::enableMetadata(bool timestamps, int sequenceBytes)
+{
+    recordTimestamps = timestamps;
+    sequenceWidth = qBound(0, sequenceBytes, 4);
+    frameTimes.fill(0, recordTimestamps ? framesTotal : 0);
+    frameSequences.fill(0, sequenceWidth > 0 ? framesTotal : 0);
+}
+
+void FrameStore::squeeze()
+{
+    frameTimes.squeeze();
+    frameSequences.squeeze();
+    if (chunks.isEmpty()) {
+        return;
+    }
+
+    int usedInLast = framesTotal - (chunks.size() - 1) * framesPerChunk;
+    const FrameChunk &last = *chunks.constLast();
+    if (!last.isSpilled() && usedInLast * nodeCount < last.size()) {
+        chunks.last()->shrink(usedInLast * nodeCount);
+    }
+}
+
+const qint16 *FrameStore::frame(int index) const
+{
+    if (index < 0 || index >= framesTotal) {
+        return nullptr;
+    }
+    return chunks[index / framesPerChunk]->constData() + (index % framesPerChunk) * nodeCount;
+}
+
+void FrameStore::detachForWrite()
+{
+    for (int i = 0; i < chunks.size(); ++i) {
+        chunks[i].detach();
+    }
+}
+
+qint16 *FrameStore::mutableFrame(int index)
+{
+    if (index < 0 || index >= framesTotal) {
+        return nullptr;
+    }
+    // 非 const 的访问会检查共享并可能复制，多个线程同时调用时不安全；detachForWrite() 已保证不共享
+    Q_ASSERT(chunks.isDetached());
+    const FrameChunk &chunk = *chunks.at(index / framesPerChunk);
+    Q_ASSERT(chunk.ref.loadRelaxed() == 1);
+    return const_cast<qint16 *>(chunk.constData()) + (index % framesPerChunk) * nodeCount;
+}
+
+qint16 *FrameStore::appendFrame()
+{
+    int chunkIndex = framesTotal / framesPerChunk;
+    if (chunkIndex >= chunks.size()) {
+        chunks.append(QSharedDataPointer<FrameChunk>(new FrameChunk(framesPerChunk * nodeCount)));
+    }
+    qint16 *slot = chunks[chunkIndex]->data() + (framesTotal % framesPerChunk) * nodeCount;
+    framesTotal++;
+    if (recordTimestamps) {
+        frameTimes.append(0);
+    }
+    if (sequenceWidth > 0) {
+        frameSequences.append(0);
+    }
+    return slot;
+}
+
+void FrameStore::appendFrame(const qint16 *data)
+{
+    std::memcpy(appendFrame(), data, sizeof(qint16) * nodeCount);
+}
+
+void FrameStore::discardLastFrame()
+{
+    if (framesTotal > 0) {
+        framesTotal--;
+        if (recordTimestamps) {
+            frameTimes.removeLast();
+        }
+        if (sequenceWidth > 0) {
+            frameSequences.removeLast();
+        }
+    }
+}
+
+void FrameStore::gatherNode(int node, int first, int count, qint16 *out) const
+{
+    if (node < 0 || node >= nodeCount || first < 0 || count <= 0 || first + count > framesTotal) {
+        return;
+    }
+
+    // 块内各帧首尾相接，节点值之间的步长就是帧大小
+    int index = first;
+    const int last = first + count;
+    while (index < last) {
+        const int chunkIndex = index / framesPerChunk;
+        const int chunkEnd = qMin(last, (chunkIndex + 1) * framesPerChunk);
+        const qint16 *src = chunks[chunkIndex]->constData() + (index % framesPerChunk) * nodeCount + node;
+        for (int i = index; i < chunkEnd; ++i, src += nodeCount) {
+            *out++ = *src;
+        }
+        index = chunkEnd;
+    }
+}
+
+int FrameStore::contiguousFrames(int index) const
+{
+    if (index < 0 || index >= framesTotal) {
+        return 0;
+    }
+    return qMin(framesTotal, (index / framesPerChunk + 1) * framesPerChunk) - index;
+}
+
+qint64 FrameStore::memoryUsage() const
+{
+    qint64 bytes = 0;
+    for (const QSharedDataPointer<FrameChunk> &chunk : chunks) {
+        bytes += chunk->heapBytes();
+    }
+    bytes += qint64(frameTimes.capacity()) * qint64(sizeof(qint64));
+    bytes += qint64(frameSequences.capacity()) * qint64(sizeof(quint32));
+    return bytes;
+}
+
+qint64 FrameStore::spilledBytes() const
+{
+    qint64 bytes = 0;
+    for (const QSharedDataPointer<FrameChunk> &chunk : chunks) {
+        if (chunk->isSpilled()) {
+            bytes += qint64(chunk->size()) * qint64(sizeof(qint16));
+        }
+    }
+    return bytes;
+}
+
+qint64 FrameStore::spillColdChunks(qint64 bytes, int hotFrame)
+{
+    // 副本共享整个块列表，替换块会让本对象复制列表，原来的块仍留在副本中，换出后反而多占一份
+    if (!chunks.isDetached()) {
+        return 0;
+    }
+
+    const int hotChunk = qBound(0, hotFrame, qMax(0, framesTotal - 1)) / framesPerChunk;
+    QVector<int> candidates;
+    for (int i = 0; i < chunks.size(); ++i) {
+        if (qAbs(i - hotChunk) > 1 && !chunks.at(i)->isSpilled() && chunks.at(i)->ref.loadRelaxed() == 1) {
+            candidates.append(i);
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [hotChunk](int a, int b) {
+        return qAbs(a - hotChunk) > qAbs(b - hotChunk);
+    });
+
+    qint64 moved = 0;
+    for (int index : candidates) {
+        if (moved >= bytes) {
+            break;
+        }
+        const FrameChunk &source = *chunks.at(index);
+        FrameChunk *target = new FrameChunk(source.size(), true);
+        if (!target->isSpilled()) {
+            delete target;          // 换出文件不可用
+            break;
+        }
+        std::memcpy(target->data(), source.constData(), sizeof(qint16) * size_t(source.size()));
+        moved += source.heapBytes();
+        chunks[index] = QSharedDataPointer<FrameChunk>(target);
+    }
+    return moved;
+}
@@ -0,0 +1,91 @@
+#ifndef FRAMESTORE_H
+#define FRAMESTORE_H
+
+#include <QSharedData>
+#include <QVector>
+
+// 帧数据块：在内存预算（MemoryBudget）之内时放在堆上，超出时放在换出文件的内存映射中
+// 与 QVector 一样隐式共享，写入共享的块时先复制
+class FrameChunk : public QSharedData
+{
+public:
+    explicit FrameChunk(int samples, bool spill = false);
+    FrameChunk(const FrameChunk &other);
+    FrameChunk &operator=(const FrameChunk &) = delete;
+    ~FrameChunk();
+
+    qint16 *data() { return samples; }
+    const qint16 *constData() const { return samples; }
+    int size() const { return count; }
+    bool isSpilled() const { return spilled; }
+    qint64 heapBytes() const { return spilled ? 0 : qint64(count) * qint64(sizeof(qint16)); }
+    void shrink(int size);                   // 只缩小堆上的块
+
+private:
+    void allocate(bool spill);
+    void release();
+
+    qint16 *samples;
+    int count;
+    bool spilled;
+};
+
+// 帧存储：按块连续存放所有帧，避免 QVector<QVector<qint16>> 的逐帧分配
+// 每个块容纳固定数量的帧，帧在块内连续，frame() 返回的指针在 clear() 或 spillColdChunks() 前保持有效
+class FrameStore
+{
+public:
+    FrameStore();
+
+    void reset(int frameSize);              // 清空并设置每帧节点数
+    void clear();
+    void squeeze();                          // 释放最后一个块中未使用的空间
+
+    int frameSize() const { return nodeCount; }
+    int frameCount() const { return framesTotal; }
+    bool isEmpty() const { return framesTotal == 0; }
+
+    const qint16 *frame(int index) const;
+    // 写入已有的帧前先在调用线程调用 detachForWrite()，复制共享的块列表和块；
+    // 之后 mutableFrame() 不再复制，不同帧可由多个线程同时写入
+    void detachForWrite();
+    qint16 *mutableFrame(int index);
+    qint16 *appendFrame();                   // 追加一帧并返回其写入位置
+    void appendFrame(const qint16 *data);
+    void discardLastFrame();                 // 撤销最近一次 appendFrame()
+
+    // 取出一个节点在 [first, first + count) 帧上的值（按块逐帧跨步读取，不复制整帧）
+    void gatherNode(int node, int first, int count, qint16 *out) const;
+    // 从 index 起在内存中连续存放的帧数（到所在块的末尾为止）
+    int contiguousFrames(int index) const;
+
+    // 每帧的采集时间戳（微秒）和帧序号，与帧数据并行存放；reset() 后默认不记录
+    // 需在追加第一帧之前调用，sequenceBytes 为 0 表示不记录序号
+    void enableMetadata(bool timestamps, int sequenceBytes);
+    bool hasTimestamps() const { return recordTimestamps; }
+    bool hasSequences() const { return sequenceWidth > 0; }
+    int sequenceBytes() const { return sequenceWidth; }
+    qint64 timestamp(int index) const { return frameTimes[index]; }
+    quint32 sequence(int index) const { return frameSequences[index]; }
+    void setTimestamp(int index, qint64 timeUs) { frameTimes[index] = timeUs; }
+    void setSequence(int index, quint32 sequence) { frameSequences[index] = sequence; }
+
+    qint64 memoryUsage() const;              // 实际占用的内存字节数（不含换出文件中的块）
+    qint64 spilledBytes() const;
+
+    // 把离 hotFrame 最远的堆上的块换出到文件，直到释放 bytes 字节；hotFrame 所在的块和相邻的块保留
+    // 本对象有副本（如工作线程中的）或块仍被其他帧存储引用时换出也不能回收，不换；返回实际释放的堆字节数
+    qint64 spillColdChunks(qint64 bytes, int hotFrame);
+
+private:
+    int nodeCount;                           // 每帧节点数 (rx * tx)
+    int framesTotal;                         // 已存储的帧数
+    int framesPerChunk;                      // 每个块容纳的帧数
+    QVector<QSharedDataPointer<FrameChunk>> chunks;  // 帧数据块
+    bool recordTimestamps;                   // 是否记录时间戳
+    int sequenceWidth;                       // 帧序号字节数，0 表示不记录
+    QVector<qint64> frameTimes;              // 每帧时间戳（微秒，单调不减）
+    QVector<quint32> frameSequences;         // 每帧序号（原始值，按 sequenceWidth 回绕）
+};
+
+#endif // FRAMESTORE_H
@@ -0,0 +1,213 @@
+#include "frametablemodel.h"
+#include "celltextcache.h"
+#include <QBrush>
+#include <QColor>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// 角色列表只构建一次，每帧发出 dataChanged 时不再分配
+const QVector<int> &colorRoles()
+{
+    static const QVector<int> roles{Qt::BackgroundRole};
+    return roles;
+}
+
+const QVector<int> &textRoles()
+{
+    static const QVector<int> roles{Qt::DisplayRole};
+    return roles;
+}
+
+const QVector<int> &textAndColorRoles()
+{
+    static const QVector<int> roles{Qt::DisplayRole, Qt::BackgroundRole};
+    return roles;
+}
+
+} // namespace
+
+FrameTableModel::FrameTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , rx(0)
+    , tx(0)
+    , rxFirst(0)
+    , txFirst(0)
+    , headerFactor(1)
+    , rxNodeCount(0)
+    , txNodeCount(0)
+    , hasValues(false)
+    , hasColors(false)
+    , showHex(false)
+    , reversed(false)
+{
+}
+
+void FrameTableModel::setDimensions(int rxCount, int txCount)
+{
+    if (rxCount == rx && txCount == tx) {
+        return;
+    }
+
+    beginResetModel();
+    rx = rxCount;
+    tx = txCount;
+    values.resize(rx * tx);
+    colors.resize(rx * tx);
+    hasValues = false;
+    hasColors = false;
+    endResetModel();
+}
+
+void FrameTableModel::setHeaderMapping(int rxOrigin, int txOrigin, int factor, int rxNodes, int txNodes)
+{
+    if (rxOrigin == rxFirst && txOrigin == txFirst && factor == headerFactor
+        && rxNodes == rxNodeCount && txNodes == txNodeCount) {
+        return;
+    }
+    rxFirst = rxOrigin;
+    txFirst = txOrigin;
+    headerFactor = qMax(1, factor);
+    rxNodeCount = rxNodes;
+    txNodeCount = txNodes;
+    if (rx > 0) {
+        emit headerDataChanged(Qt::Horizontal, 0, rx - 1);
+    }
+    if (tx > 0) {
+        emit headerDataChanged(Qt::Vertical, 0, tx - 1);
+    }
+}
+
+void FrameTableModel::setFrame(const qint16 *data, bool asHex, bool reverseRx)
+{
+    // 显示方式不变时只通知数值有变化的行，相邻帧大部分节点不变时视图只重绘变化的部分
+    if (!hasValues || asHex != showHex || reverseRx != reversed) {
+        std::copy(data, data + values.size(), values.begin());
+        hasValues = true;
+        showHex = asHex;
+        reversed = reverseRx;
+        emitAllChanged(textAndColorRoles());
+        return;
+    }
+
+    int firstRow = -1;
+    int lastRow = -1;
+    for (int row = 0; row < tx; ++row) {
+        const qint16 *source = data + row * rx;
+        qint16 *target = values.data() + row * rx;
+        if (std::memcmp(source, target, size_t(rx) * sizeof(qint16)) != 0) {
+            std::copy(source, source + rx, target);
+            if (firstRow < 0) {
+                firstRow = row;
+            }
+            lastRow = row;
+        }
+    }
+    if (firstRow >= 0) {
+        emit dataChanged(index(firstRow, 0), index(lastRow, rx - 1), textRoles());
+    }
+}
+
+void FrameTableModel::setCellColors(const QVector<quint8> &cellColors)
+{
+    if (cellColors.size() != colors.size()) {
+        return;
+    }
+    if (hasColors && std::memcmp(cellColors.constData(), colors.constData(), size_t(colors.size())) == 0) {
+        return;
+    }
+    std::copy(cellColors.constBegin(), cellColors.constEnd(), colors.begin());
+    hasColors = true;
+    emitAllChanged(colorRoles());
+}
+
+void FrameTableModel::clearCellColors()
+{
+    if (!hasColors) {
+        return;
+    }
+    hasColors = false;
+    emitAllChanged(colorRoles());
+}
+
+void FrameTableModel::clearValues()
+{
+    if (!hasValues && !hasColors) {
+        return;
+    }
+    hasValues = false;
+    hasColors = false;
+    emitAllChanged(textAndColorRoles());
+}
+
+int FrameTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : tx;
+}
+
+int FrameTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : rx;
+}
+
+QVariant FrameTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid()) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole: {
+        if (!hasValues) {
+            return QVariant();
+        }
+        // 文本来自共享缓存，这里只复制 QString 的指针
+        qint16 value = values[cellIndex(index)];
+        return showHex ? CellTextCache::hex(value) : CellTextCache::decimal(value);
+    }
+    case Qt::BackgroundRole: {
+        // 青绿色 - 峰值，粉色 - 超过阈值，默认背景色
+        static const QBrush brushes[] = { QBrush(QColor("#FFFFEF")), QBrush(QColor("#FA78E0")),
+                                          QBrush(QColor("#32C8B4")) };
+        quint8 color = hasColors ? colors[cellIndex(index)] : quint8(DefaultColor);
+        return brushes[qMin<int>(color, PeakColor)];
+    }
+    case Qt::TextAlignmentRole:
+        return int(Qt::AlignCenter);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant FrameTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    // 列标题始终保持正序（RX0, RX1, ...），行标题为 TX0, TX1, ...；从 ROI 起点编号，概览时写出合并的范围
+    const bool horizontal = (orientation == Qt::Horizontal);
+    const QString prefix = horizontal ? QStringLiteral("RX") : QStringLiteral("TX");
+    const int origin = horizontal ? rxFirst : txFirst;
+    const int first = origin + section * headerFactor;
+    if (headerFactor <= 1) {
+        return prefix + QString::number(first);
+    }
+    const int nodes = horizontal ? rxNodeCount : txNodeCount;
+    const int last = origin + qMin(nodes, (section + 1) * headerFactor) - 1;
+    return QString("%1%2-%3").arg(prefix).arg(first).arg(last);
+}
+
+int FrameTableModel::cellIndex(const QModelIndex &index) const
+{
+    // 反转 RX 时数据从右往左显示
+    int column = reversed ? (rx - 1 - index.column()) : index.column();
+    return index.row() * rx + column;
+}
+
+void FrameTableModel::emitAllChanged(const QVector<int> &roles)
+{
+    if (rx > 0 && tx > 0) {
+        emit dataChanged(index(0, 0), index(tx - 1, rx - 1), roles);
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef FRAMETABLEMODEL_H
+#define FRAMETABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVector>
+
+// 数据表格模型：一帧数据 + 每格的颜色状态，文本和表头在视图请求时才生成
+// 修改面板尺寸只重置模型（O(1)，外加缓冲区重新分配），不再逐格创建 QTableWidgetItem
+class FrameTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    // 取值与 PeakDetector::CellState 一致，可以直接传入检测结果
+    enum CellColor : quint8 {
+        DefaultColor = 0,
+        ThresholdColor = 1,
+        PeakColor = 2
+    };
+
+    explicit FrameTableModel(QObject *parent = nullptr);
+
+    void setDimensions(int rxCount, int txCount);
+    int rxCount() const { return rx; }
+    int txCount() const { return tx; }
+
+    // 表头映射：第一个格子对应的节点（ROI 起点）、每个格子合并的节点数（概览），
+    // nodes 为 ROI 的节点数，最后一个不满的块的表头只写到实际存在的节点
+    void setHeaderMapping(int rxOrigin, int txOrigin, int factor, int rxNodes, int txNodes);
+
+    // data 按 tx 行、rx 列排列，长度必须等于 rx*tx
+    void setFrame(const qint16 *data, bool asHex, bool reverseRx);
+    void setCellColors(const QVector<quint8> &colors);
+    void clearCellColors();
+    void clearValues();
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    int cellIndex(const QModelIndex &index) const;
+    void emitAllChanged(const QVector<int> &roles);
+
+    int rx;
+    int tx;
+    int rxFirst;
+    int txFirst;
+    int headerFactor;
+    int rxNodeCount;
+    int txNodeCount;
+    QVector<qint16> values;
+    QVector<quint8> colors;
+    bool hasValues;
+    bool hasColors;
+    bool showHex;
+    bool reversed;
+};
+
+#endif // FRAMETABLEMODEL_H
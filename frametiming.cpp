@@ -0,0 +1,84 @@
+#include "frametiming.h"
+#include "framestore.h"
+#include <cmath>
+
+// 报告中列出的跳号位置上限
+static const int kMaxListedGaps = 20;
+
+FrameTimingReport FrameTiming::analyze(const FrameStore &frames)
+{
+    FrameTimingReport report;
+    report.frameCount = frames.frameCount();
+    report.hasTimestamps = frames.hasTimestamps();
+    report.hasSequences = frames.hasSequences();
+
+    if (report.hasSequences) {
+        const quint64 modulus = quint64(1) << (8 * frames.sequenceBytes());
+        for (int i = 1; i < report.frameCount; ++i) {
+            // 差值按模运算，回绕（如 0xFFFF -> 0x0000）视为正常递增
+            quint64 step = (quint64(frames.sequence(i)) + modulus - frames.sequence(i - 1)) % modulus;
+            if (step == 1) {
+                continue;
+            }
+            if (step == 0 || step > modulus / 2) {
+                report.repeatedFrames++;
+                continue;
+            }
+            report.sequenceGaps++;
+            report.droppedFrames += qint64(step - 1);
+            if (report.gapFrames.size() < kMaxListedGaps) {
+                report.gapFrames.append(i);
+            }
+        }
+    }
+
+    if (report.hasTimestamps && report.frameCount > 1) {
+        // Welford 单遍求均值和方差
+        double mean = 0.0;
+        double m2 = 0.0;
+        qint64 minInterval = frames.timestamp(1) - frames.timestamp(0);
+        qint64 maxInterval = minInterval;
+        for (int i = 1; i < report.frameCount; ++i) {
+            const qint64 interval = frames.timestamp(i) - frames.timestamp(i - 1);
+            minInterval = qMin(minInterval, interval);
+            maxInterval = qMax(maxInterval, interval);
+            const double delta = double(interval) - mean;
+            mean += delta / i;
+            m2 += delta * (double(interval) - mean);
+        }
+        const int intervals = report.frameCount - 1;
+        report.meanIntervalUs = mean;
+        report.stdDevIntervalUs = std::sqrt(m2 / intervals);
+        report.minIntervalUs = minInterval;
+        report.maxIntervalUs = maxInterval;
+        report.reportRateHz = mean > 0.0 ? 1e6 / mean : 0.0;
+
+        // 第二遍只做比较，统计明显迟到的帧
+        const double lateLimit = mean * 1.5;
+        for (int i = 1; i < report.frameCount; ++i) {
+            if (double(frames.timestamp(i) - frames.timestamp(i - 1)) > lateLimit) {
+                report.lateFrames++;
+            }
+        }
+    }
+
+    return report;
+}
+
+int FrameTiming::frameAtTime(const FrameStore &frames, qint64 timeUs)
+{
+    int low = 0;
+    int high = frames.frameCount() - 1;
+    if (high < 0 || !frames.hasTimestamps()) {
+        return 0;
+    }
+    while (low < high) {
+        int mid = low + (high - low + 1) / 2;
+        if (frames.timestamp(mid) <= timeUs) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return low;
+}
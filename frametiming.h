@@ -0,0 +1,39 @@
+#ifndef FRAMETIMING_H
+#define FRAMETIMING_H
+
+#include <QVector>
+
+class FrameStore;
+
+// 整个采集的时序统计：帧序号跳号和上报间隔抖动，一次遍历帧存储中的并行数组得到
+struct FrameTimingReport
+{
+    int frameCount = 0;
+    bool hasTimestamps = false;
+    bool hasSequences = false;
+
+    // 帧序号（按字节数回绕比较）
+    int sequenceGaps = 0;          // 出现跳号的位置数
+    qint64 droppedFrames = 0;      // 跳过的序号总数
+    int repeatedFrames = 0;        // 序号重复或倒退的位置数
+    QVector<int> gapFrames;        // 跳号后第一帧的索引（只记录前若干个）
+
+    // 相邻两帧的时间间隔（微秒）
+    double meanIntervalUs = 0.0;
+    double stdDevIntervalUs = 0.0;
+    qint64 minIntervalUs = 0;
+    qint64 maxIntervalUs = 0;
+    int lateFrames = 0;            // 间隔超过平均值 1.5 倍的帧数
+    double reportRateHz = 0.0;     // 按平均间隔换算的上报率
+};
+
+class FrameTiming
+{
+public:
+    static FrameTimingReport analyze(const FrameStore &frames);
+
+    // 时间戳不大于 timeUs 的最后一帧（时间戳单调不减，二分查找）；早于第一帧时返回 0
+    static int frameAtTime(const FrameStore &frames, qint64 timeUs);
+};
+
+#endif // FRAMETIMING_H
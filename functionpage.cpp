@@ -1,41 +1,96 @@
 #include "functionpage.h"
 #include "./ui_functionpage.h"
+#include "capturesession.h"
+#include "comparewindow.h"
+#include "noisespectrumwindow.h"
+#include "parsediagnosticswindow.h"
+#include "nodeserieswindow.h"
+#include "analysispluginwindow.h"
+#include "baselinebuilder.h"
+#include "framestore.h"
+#include "frameexporter.h"
+#include "framearchive.h"
+#include "heatmapview.h"
+#include "uiupdatescheduler.h"
+#include "configservice.h"
+#include "frametablemodel.h"
+#include "simdkernels.h"
+#include "frametiming.h"
+#include "lineprofilestrip.h"
+#include "commonmodescanner.h"
+#include "framepooler.h"
+#include "memorybudget.h"
+#include "perfdebug.h"
 #include <QFile>
-#include <QJsonDocument>
 #include <QJsonObject>
+#include <QInputDialog>
 #include <QHeaderView>
 #include <QLineEdit>
 #include <QFileDialog>
 #include <QMessageBox>
-#include <QTextStream>
-#include <QTableWidgetItem>
-#include <QQueue>
-#include <QColor>
 #include <QElapsedTimer>
+#include <QEvent>
 #include <QDebug>
-
-// 性能调试开关：设置为 false 可以禁用所有调试输出，提升性能
-#define ENABLE_PERFORMANCE_DEBUG true
-
-#if ENABLE_PERFORMANCE_DEBUG
-    #define PERF_DEBUG(msg) qDebug() << msg
-#else
-    #define PERF_DEBUG(msg) do {} while(0)
-#endif
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QRegularExpression>
+#include <QtConcurrent>
+#include <algorithm>
 
 FunctionPage::FunctionPage(QWidget *parent)
     : QWidget(parent)
     , ui(new Ui::FunctionPage)
+    , config(new ConfigService("config.json", this))
+    , tableModel(new FrameTableModel(this))
     , isPlaying(false)
     , currentDataMode(RawData)
+    , session(new CaptureSession(this))
+    , currentStream(0)
     , currentFrame(0)
     , playTimer(new QTimer(this))
+    , playClockOriginUs(0)
+    , compareWindow(nullptr)
+    , spectrumWindow(nullptr)
+    , diagnosticsWindow(nullptr)
+    , nodeSeriesWindow(nullptr)
+    , analysisWindow(nullptr)
+    , heatmapView(nullptr)
+    , viewFactor(1)
+    , uiScheduler(new UiUpdateScheduler(this))
+    , rowStrip(nullptr)
+    , columnStrip(nullptr)
+    , commonModeScanner(new CommonModeScanner(this))
+    , shownFrameValue(-1)
+    , shownFrameMax(-1)
+    , processingWatcher(nullptr)
+    , processingGeneration(0)
+    , archiveWatcher(nullptr)
+    , archiveCancel(0)
+    , memoryTimer(new QTimer(this))
 {
     ui->setupUi(this);
 
+    // 热力图视图与表格共用数据区，默认隐藏
+    heatmapView = new HeatmapView(ui->dataArea);
+    heatmapView->hide();
+    ui->dataAreaLayout->addWidget(heatmapView, 0, 0);
+
+    // 行/列统计边栏：每行的统计在网格右侧，每列的统计在网格下方，默认隐藏
+    rowStrip = new LineProfileStrip(Qt::Vertical, ui->dataArea);
+    columnStrip = new LineProfileStrip(Qt::Horizontal, ui->dataArea);
+    rowStrip->hide();
+    columnStrip->hide();
+    ui->dataAreaLayout->addWidget(rowStrip, 0, 1);
+    ui->dataAreaLayout->addWidget(columnStrip, 1, 0);
+    ui->worstFramesComboBox->addItem(tr("共模排查: 无数据"));
+    ui->worstFramesComboBox->setEnabled(false);
+    ui->overlayButton->setEnabled(false);
+
     // 配置播放定时器（初始间隔50ms，实际值会在loadConfig中设置）
     playTimer->setInterval(50);
     connect(playTimer, &QTimer::timeout, this, &FunctionPage::onPlayTimerTimeout);
+    connect(uiScheduler, &UiUpdateScheduler::flushRequested, this, &FunctionPage::onUiFlush);
 
     // 设置上下区域的 8:2 比例
     ui->contentVerticalLayout->setStretch(0, 8);  // topArea
@@ -63,11 +118,20 @@ FunctionPage::FunctionPage(QWidget *parent)
     connect(ui->signalThresholdSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &FunctionPage::onSignalThresholdChanged);
     connect(ui->signalCalcComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() {
         saveConfig();
+        updateProcessing();
+        restartCommonModeScan();
         displayCurrentFrame();  // 切换计算模式时重新显示信号数据
     });
+
+    // 连接信号处理链选项
+    connect(ui->commonModeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FunctionPage::onProcessingOptionChanged);
+    connect(ui->medianComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FunctionPage::onProcessingOptionChanged);
+    connect(ui->iirComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FunctionPage::onProcessingOptionChanged);
+    connect(ui->smoothCheckBox, &QCheckBox::toggled, this, &FunctionPage::onProcessingOptionChanged);
     connect(ui->reverseRxCheckBox, &QCheckBox::stateChanged, this, [this]() {
         saveConfig();
         displayCurrentFrame();  // 重新显示数据（表头不变）
+        syncCompareWindow();
     });
 
     // 连接 hex 输入框的验证
@@ -81,7 +145,10 @@ FunctionPage::FunctionPage(QWidget *parent)
     connect(ui->rawDataPosLineEdit, &QLineEdit::editingFinished, this, &FunctionPage::validateIntInput);
     connect(ui->filterStartLineEdit, &QLineEdit::editingFinished, this, &FunctionPage::validateIntInput);
     connect(ui->maxRowsLineEdit, &QLineEdit::editingFinished, this, &FunctionPage::validateIntInput);
+    connect(ui->timestampPosLineEdit, &QLineEdit::editingFinished, this, &FunctionPage::validateIntInput);
+    connect(ui->sequencePosLineEdit, &QLineEdit::editingFinished, this, &FunctionPage::validateIntInput);
     connect(ui->playSpeedLineEdit, &QLineEdit::editingFinished, this, &FunctionPage::validatePlaySpeed);
+    connect(ui->playClockComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FunctionPage::onPlayClockChanged);
 
     // 连接文件浏览按钮
     connect(ui->baselineFileBrowseButton, &QPushButton::clicked, this, &FunctionPage::onBaselineFileBrowse);
@@ -99,26 +166,113 @@ FunctionPage::FunctionPage(QWidget *parent)
 
     // 连接 bottom_1 配置项的信号
     connect(ui->byteOrderComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() { saveConfig(); });
+    connect(ui->inputFormatComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() { saveConfig(); });
     connect(ui->autoFilterSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this]() { saveConfig(); });
     connect(ui->filterModeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() { saveConfig(); });
+    connect(ui->timestampBytesSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this]() { saveConfig(); });
+    connect(ui->timestampUnitComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() { saveConfig(); });
+    connect(ui->sequenceBytesSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this]() { saveConfig(); });
+    connect(ui->baselineStartSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this]() { saveConfig(); });
+    connect(ui->baselineFramesSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this]() { saveConfig(); });
+    connect(ui->baselineMethodComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() { saveConfig(); });
+    connect(ui->memoryBudgetSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int megabytes) {
+        MemoryBudget::setLimit(qint64(megabytes) * 1024 * 1024);
+        saveConfig();
+        updateMemoryStatus();
+    });
 
     // 连接数据模式切换按钮
     connect(ui->rawDataButton, &QPushButton::clicked, this, &FunctionPage::onRawDataButtonClicked);
     connect(ui->signalDataButton, &QPushButton::clicked, this, &FunctionPage::onSignalDataButtonClicked);
     connect(ui->baselineDataButton, &QPushButton::clicked, this, &FunctionPage::onBaselineDataButtonClicked);
 
+    // 连接多文件对比
+    connect(ui->compareButton, &QPushButton::clicked, this, &FunctionPage::onCompareButtonClicked);
+    connect(ui->exportButton, &QPushButton::clicked, this, &FunctionPage::onExportButtonClicked);
+    connect(ui->timingReportButton, &QPushButton::clicked, this, &FunctionPage::onTimingReportClicked);
+    connect(ui->spectrumButton, &QPushButton::clicked, this, &FunctionPage::onSpectrumButtonClicked);
+    connect(ui->diagnosticsButton, &QPushButton::clicked, this, &FunctionPage::onDiagnosticsButtonClicked);
+    connect(ui->pluginButton, &QPushButton::clicked, this, &FunctionPage::onPluginButtonClicked);
+    connect(session, &CaptureSession::loadingFinished, this, &FunctionPage::onComparisonLoadingFinished);
+
+    // 连接面板预设
+    connect(ui->presetComboBox, QOverload<int>::of(&QComboBox::activated), this, &FunctionPage::onPresetActivated);
+
+    // 连接扫描类型切换（多种帧头分流读取后可用）
+    connect(ui->scanTypeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FunctionPage::onScanTypeChanged);
+    connect(ui->extraPatternsLineEdit, &QLineEdit::editingFinished, this, [this]() { saveConfig(); });
+    connect(ui->savePresetButton, &QPushButton::clicked, this, &FunctionPage::onSavePresetClicked);
+    connect(ui->deletePresetButton, &QPushButton::clicked, this, &FunctionPage::onDeletePresetClicked);
+
+    // 连接热力图显示切换
+    connect(ui->heatmapButton, &QPushButton::toggled, this, &FunctionPage::onHeatmapButtonToggled);
+    connect(ui->overlayButton, &QPushButton::toggled, this, &FunctionPage::onOverlayButtonToggled);
+
+    // 连接行列统计和共模排查
+    connect(ui->lineStatsComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FunctionPage::onLineStatsChanged);
+    connect(ui->worstFramesComboBox, QOverload<int>::of(&QComboBox::activated), this, &FunctionPage::onWorstFrameActivated);
+    connect(commonModeScanner, &CommonModeScanner::progress, this, &FunctionPage::onCommonModeScanProgress);
+
+    // 连接 ROI 和概览；数据区大小变化时重新布局
+    connect(ui->overviewComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FunctionPage::onOverviewChanged);
+    connect(ui->poolingComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &FunctionPage::onOverviewChanged);
+    connect(ui->roiButton, &QPushButton::clicked, this, &FunctionPage::onRoiButtonClicked);
+    connect(heatmapView, &HeatmapView::regionSelected, this, &FunctionPage::onHeatmapRegionSelected);
+
+    // 双击表格中的节点或单击热力图中的节点时显示该节点在整段采集中的时序
+    connect(ui->dataTable, &QTableView::clicked, this, &FunctionPage::onTableNodeClicked);
+    connect(ui->dataTable, &QTableView::doubleClicked, this, &FunctionPage::onTableNodeDoubleClicked);
+    connect(heatmapView, &HeatmapView::cellClicked, this, &FunctionPage::onHeatmapNodeClicked);
+    ui->dataTable->installEventFilter(this);
+    heatmapView->installEventFilter(this);
+
+    // 内存预算：处理结果缓存先于触摸数据换出；每秒检查一次用量并刷新状态栏
+    memoryConsumers.append(MemoryBudget::addConsumer(tr("信号处理缓存"), 0,
+        [this]() { return processedCache.memoryUsage(); },
+        [this](qint64 bytes) { return evictProcessedSignal(bytes); }));
+    memoryConsumers.append(MemoryBudget::addConsumer(tr("触摸数据"), 1,
+        [this]() {
+            qint64 usage = session->memoryUsage();
+            for (int i = 0; i < streamFrames.size(); ++i) {
+                usage += (i == currentStream) ? 0 : streamFrames[i].memoryUsage();
+            }
+            return usage;
+        },
+        [this](qint64 bytes) { return evictTouchFrames(bytes); }));
+    memoryTimer->setInterval(1000);
+    connect(memoryTimer, &QTimer::timeout, this, &FunctionPage::updateMemoryStatus);
+    memoryTimer->start();
+    updateMemoryStatus();
+
     // 默认选中"原始数据"按钮
     onRawDataButtonClicked();
 
     // 初始化播放控制按钮状态
     updateFrameButtons();
     updateProgressBar();
+    updateDiagnosticsButton();
+
+    // 配置加载完成后开始预读上次的触摸数据文件
+    connect(ui->prefetchCheckBox, &QCheckBox::toggled, this, [this](bool checked) {
+        if (!checked) {
+            touchPrefetcher.discard();
+        }
+        saveConfig();
+    });
+    startTouchPrefetch();
 }
 
 FunctionPage::~FunctionPage()
 {
+    for (int id : memoryConsumers) {
+        MemoryBudget::removeConsumer(id);
+    }
+    uiScheduler->cancel();
     stopPlayback();
+    cancelArchiveDecode();
+    dumpFuture.waitForFinished();
     saveConfig();
+    config->flush();
     delete ui;
 }
 
@@ -130,12 +284,14 @@ void FunctionPage::onBackButtonClicked()
 void FunctionPage::onRxCountChanged(int value)
 {
     updateTableSize();
+    syncCompareWindow();
     saveConfig();
 }
 
 void FunctionPage::onTxCountChanged(int value)
 {
     updateTableSize();
+    syncCompareWindow();
     saveConfig();
 }
 
@@ -147,104 +303,82 @@ void FunctionPage::onRawThresholdChanged(int value)
 void FunctionPage::onSignalThresholdChanged(int value)
 {
     saveConfig();
+
+    // 共模去除以信号阈值区分触摸格子
+    if (ui->commonModeComboBox->currentIndex() != 0) {
+        updateProcessing();
+        displayCurrentFrame();
+    }
 }
 
 void FunctionPage::initializeTable()
 {
-    // 设置表格行列数
-    int rxCount = ui->rxSpinBox->value();
-    int txCount = ui->txSpinBox->value();
-
-    ui->dataTable->setRowCount(txCount);
-    ui->dataTable->setColumnCount(rxCount);
-
-    // 设置行标题 (TX0, TX1, ...)
-    QStringList rowHeaders;
-    for (int i = 0; i < txCount; ++i) {
-        rowHeaders << QString("TX%1").arg(i);
-    }
-    ui->dataTable->setVerticalHeaderLabels(rowHeaders);
-
-    // 设置列标题 (RX0, RX1, ...) - 始终保持正序
-    QStringList colHeaders;
-    for (int i = 0; i < rxCount; ++i) {
-        colHeaders << QString("RX%1").arg(i);
-    }
-    ui->dataTable->setHorizontalHeaderLabels(colHeaders);
+    // 表格只保存面板尺寸和当前帧，单元格文本和表头由模型按需生成
+    tableModel->setDimensions(ui->rxSpinBox->value(), ui->txSpinBox->value());
+    ui->dataTable->setModel(tableModel);
 
     // 设置单元格最小尺寸（增加最小列宽以容纳更长的数字）
     ui->dataTable->verticalHeader()->setMinimumSectionSize(18);
     ui->dataTable->horizontalHeader()->setMinimumSectionSize(35); // 增加到60以容纳5-6位数字
 
-    // 设置表头调整模式为自动拉伸
+    // 默认自动拉伸；格子放不下时 updateTableLayout 改为固定尺寸并滚动
     ui->dataTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     ui->dataTable->verticalHeader()->setSectionResizeMode(QHeaderView::Stretch);
 
     // 设置文字换行模式为不换行，让内容完整显示
     ui->dataTable->setWordWrap(false);
-
-    // 预创建所有单元格，避免后续重复创建
-    for (int tx = 0; tx < txCount; ++tx) {
-        for (int rx = 0; rx < rxCount; ++rx) {
-            QTableWidgetItem *item = new QTableWidgetItem("");
-            item->setTextAlignment(Qt::AlignCenter);
-            ui->dataTable->setItem(tx, rx, item);
-        }
-    }
 }
 
 void FunctionPage::updateTableSize()
 {
-    int rxCount = ui->rxSpinBox->value();
-    int txCount = ui->txSpinBox->value();
-
-    ui->dataTable->setRowCount(txCount);
-    ui->dataTable->setColumnCount(rxCount);
-
-    // 更新行标题
-    QStringList rowHeaders;
-    for (int i = 0; i < txCount; ++i) {
-        rowHeaders << QString("TX%1").arg(i);
-    }
-    ui->dataTable->setVerticalHeaderLabels(rowHeaders);
+    // 面板尺寸变化后原来的 ROI 不再对应同样的节点
+    setRoi(QRect());
+    tableModel->setDimensions(ui->rxSpinBox->value(), ui->txSpinBox->value());
+    // 数据与新尺寸不符时不会重新显示，这里直接按新的行列数决定拉伸还是固定
+    updateTableLayout();
+    updateProcessing();
+    restartCommonModeScan();
+    revalidateData();
+}
 
-    // 更新列标题 - 始终保持正序
-    QStringList colHeaders;
-    for (int i = 0; i < rxCount; ++i) {
-        colHeaders << QString("RX%1").arg(i);
+void FunctionPage::revalidateData()
+{
+    // 面板尺寸变化后，已读取的数据与新尺寸一致时直接重新显示，无需重新读取文件
+    const int nodeCount = ui->rxSpinBox->value() * ui->txSpinBox->value();
+    bool framesValid = playbackFrameCount() > 0 && playbackFrameSize() == nodeCount;
+    bool baselineValid = baselineData.size() == nodeCount;
+
+    bool valid = false;
+    if (currentDataMode == BaselineData) {
+        valid = baselineValid;
+    } else if (currentDataMode == SignalData) {
+        valid = framesValid && baselineValid;
+    } else {
+        valid = framesValid;
     }
-    ui->dataTable->setHorizontalHeaderLabels(colHeaders);
 
-    // 确保所有单元格都已创建
-    for (int tx = 0; tx < txCount; ++tx) {
-        for (int rx = 0; rx < rxCount; ++rx) {
-            if (!ui->dataTable->item(tx, rx)) {
-                QTableWidgetItem *item = new QTableWidgetItem("");
-                item->setTextAlignment(Qt::AlignCenter);
-                ui->dataTable->setItem(tx, rx, item);
-            }
-        }
+    if (!valid) {
+        tableModel->clearValues();
+        heatmapView->clearFrame();
+    } else if (currentDataMode == BaselineData && !framesValid) {
+        frameArena.reset();
+        displayData(baselineData.constData(), baselineData.size(), true);
+    } else {
+        uiScheduler->request(UiUpdateScheduler::FramePart);
     }
 }
 
 void FunctionPage::loadConfig()
 {
-    QFile file("config.json");
-    if (!file.open(QIODevice::ReadOnly)) {
-        return; // 如果文件不存在，使用UI中的默认值
-    }
-
-    QByteArray data = file.readAll();
-    file.close();
-
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (doc.isNull() || !doc.isObject()) {
-        return;
+    // 如果文件不存在，使用UI中的默认值
+    if (config->load()) {
+        applyParameters(config->parameters());
     }
+    refreshPresetList();
+}
 
-    QJsonObject root = doc.object();
-    QJsonObject params = root["parameters"].toObject();
-
+void FunctionPage::applyParameters(const QJsonObject &params)
+{
     // 加载参数值
     if (params.contains("rx_count")) {
         ui->rxSpinBox->setValue(params["rx_count"].toInt());
@@ -264,6 +398,27 @@ void FunctionPage::loadConfig()
     if (params.contains("reverse_rx")) {
         ui->reverseRxCheckBox->setChecked(params["reverse_rx"].toBool());
     }
+    if (params.contains("common_mode")) {
+        ui->commonModeComboBox->setCurrentIndex(params["common_mode"].toInt());
+    }
+    if (params.contains("median_frames")) {
+        ui->medianComboBox->setCurrentIndex(params["median_frames"].toInt());
+    }
+    if (params.contains("iir_shift")) {
+        ui->iirComboBox->setCurrentIndex(params["iir_shift"].toInt());
+    }
+    if (params.contains("spatial_smooth")) {
+        ui->smoothCheckBox->setChecked(params["spatial_smooth"].toBool());
+    }
+    if (params.contains("line_stats")) {
+        ui->lineStatsComboBox->setCurrentIndex(params["line_stats"].toInt());
+    }
+    if (params.contains("overview_mode")) {
+        ui->overviewComboBox->setCurrentIndex(params["overview_mode"].toInt());
+    }
+    if (params.contains("overview_pooling")) {
+        ui->poolingComboBox->setCurrentIndex(params["overview_pooling"].toInt());
+    }
 
     // 加载 bottom_1 配置
     if (params.contains("raw_data_pos")) {
@@ -272,6 +427,9 @@ void FunctionPage::loadConfig()
     if (params.contains("byte_order")) {
         ui->byteOrderComboBox->setCurrentIndex(params["byte_order"].toInt());
     }
+    if (params.contains("input_format")) {
+        ui->inputFormatComboBox->setCurrentIndex(params["input_format"].toInt());
+    }
     if (params.contains("auto_filter_bits")) {
         ui->autoFilterSpinBox->setValue(params["auto_filter_bits"].toInt());
     }
@@ -296,6 +454,28 @@ void FunctionPage::loadConfig()
     if (params.contains("hex_input5")) {
         ui->hexInput5->setText(params["hex_input5"].toString());
     }
+    if (params.contains("extra_patterns")) {
+        ui->extraPatternsLineEdit->setText(params["extra_patterns"].toString());
+    }
+
+    // 时间戳/帧序号列（-1 表示不读取，界面上显示为空）
+    if (params.contains("timestamp_pos")) {
+        int pos = params["timestamp_pos"].toInt();
+        ui->timestampPosLineEdit->setText(pos >= 0 ? QString::number(pos) : QString());
+    }
+    if (params.contains("timestamp_bytes")) {
+        ui->timestampBytesSpinBox->setValue(params["timestamp_bytes"].toInt());
+    }
+    if (params.contains("timestamp_unit")) {
+        ui->timestampUnitComboBox->setCurrentIndex(params["timestamp_unit"].toInt());
+    }
+    if (params.contains("sequence_pos")) {
+        int pos = params["sequence_pos"].toInt();
+        ui->sequencePosLineEdit->setText(pos >= 0 ? QString::number(pos) : QString());
+    }
+    if (params.contains("sequence_bytes")) {
+        ui->sequenceBytesSpinBox->setValue(params["sequence_bytes"].toInt());
+    }
 
     // 加载 bottom_3 文件路径
     if (params.contains("baseline_file_path")) {
@@ -304,6 +484,20 @@ void FunctionPage::loadConfig()
     if (params.contains("touch_file_path")) {
         ui->touchFileLineEdit->setText(params["touch_file_path"].toString());
     }
+    if (params.contains("prefetch_touch_file")) {
+        ui->prefetchCheckBox->setChecked(params["prefetch_touch_file"].toBool());
+    }
+
+    // 加载多帧基线的帧范围和计算方法
+    if (params.contains("baseline_start")) {
+        ui->baselineStartSpinBox->setValue(params["baseline_start"].toInt());
+    }
+    if (params.contains("baseline_frames")) {
+        ui->baselineFramesSpinBox->setValue(params["baseline_frames"].toInt());
+    }
+    if (params.contains("baseline_method")) {
+        ui->baselineMethodComboBox->setCurrentIndex(params["baseline_method"].toInt());
+    }
 
     // 加载最大读取行数
     if (params.contains("max_rows")) {
@@ -312,6 +506,12 @@ void FunctionPage::loadConfig()
         ui->maxRowsLineEdit->setText(QString::number(maxRows));
     }
 
+    // 加载内存上限（启动时界面信号尚未连接，直接设置）
+    if (params.contains("memory_budget_mb")) {
+        ui->memoryBudgetSpinBox->setValue(params["memory_budget_mb"].toInt());
+        MemoryBudget::setLimit(qint64(ui->memoryBudgetSpinBox->value()) * 1024 * 1024);
+    }
+
     // 加载播放速度
     if (params.contains("play_speed")) {
         int playSpeed = params["play_speed"].toInt();
@@ -319,9 +519,95 @@ void FunctionPage::loadConfig()
         ui->playSpeedLineEdit->setText(QString::number(playSpeed));
         playTimer->setInterval(playSpeed);
     }
+    if (params.contains("play_clock")) {
+        ui->playClockComboBox->setCurrentIndex(params["play_clock"].toInt());
+    }
 }
 
 void FunctionPage::saveConfig()
+{
+    // 只更新内存中的配置，写盘由 ConfigService 延迟合并并在后台完成
+    config->setParameters(collectParameters());
+}
+
+namespace {
+
+// 面板预设包含的参数：面板尺寸、阈值和数据行格式（不含文件路径和播放设置）
+const char *const kPresetKeys[] = {
+    "rx_count", "tx_count", "raw_threshold", "signal_threshold", "signal_calc_mode", "reverse_rx",
+    "raw_data_pos", "byte_order", "input_format", "auto_filter_bits", "filter_start_pos", "filter_mode",
+    "hex_input1", "hex_input2", "hex_input3", "hex_input4", "hex_input5", "extra_patterns",
+    "timestamp_pos", "timestamp_bytes", "timestamp_unit", "sequence_pos", "sequence_bytes"
+};
+
+} // namespace
+
+void FunctionPage::refreshPresetList()
+{
+    ui->presetComboBox->blockSignals(true);
+    ui->presetComboBox->clear();
+    ui->presetComboBox->addItem(tr("选择预设..."));
+    ui->presetComboBox->addItems(config->presetNames());
+    ui->presetComboBox->blockSignals(false);
+    ui->deletePresetButton->setEnabled(ui->presetComboBox->count() > 1);
+}
+
+void FunctionPage::onPresetActivated(int index)
+{
+    if (index <= 0) {
+        return;
+    }
+
+    QJsonObject preset = config->preset(ui->presetComboBox->itemText(index));
+    if (preset.isEmpty()) {
+        return;
+    }
+    stopPlayback();
+    applyParameters(preset);
+    saveConfig();
+}
+
+void FunctionPage::onSavePresetClicked()
+{
+    QString defaultName = ui->presetComboBox->currentIndex() > 0
+        ? ui->presetComboBox->currentText()
+        : QString("%1x%2").arg(ui->rxSpinBox->value()).arg(ui->txSpinBox->value());
+
+    bool ok = false;
+    QString name = QInputDialog::getText(this, tr("保存面板预设"), tr("预设名称:"),
+                                         QLineEdit::Normal, defaultName, &ok).trimmed();
+    if (!ok || name.isEmpty()) {
+        return;
+    }
+
+    QJsonObject params = collectParameters();
+    QJsonObject preset;
+    for (const char *key : kPresetKeys) {
+        preset[key] = params[key];
+    }
+    config->savePreset(name, preset);
+
+    refreshPresetList();
+    ui->presetComboBox->setCurrentText(name);
+}
+
+void FunctionPage::onDeletePresetClicked()
+{
+    int index = ui->presetComboBox->currentIndex();
+    if (index <= 0) {
+        return;
+    }
+
+    QString name = ui->presetComboBox->currentText();
+    if (QMessageBox::question(this, tr("删除面板预设"), tr("确定删除预设“%1”吗？").arg(name))
+        != QMessageBox::Yes) {
+        return;
+    }
+    config->removePreset(name);
+    refreshPresetList();
+}
+
+QJsonObject FunctionPage::collectParameters() const
 {
     QJsonObject params;
     params["rx_count"] = ui->rxSpinBox->value();
@@ -330,10 +616,18 @@ void FunctionPage::saveConfig()
     params["signal_threshold"] = ui->signalThresholdSpinBox->value();
     params["signal_calc_mode"] = ui->signalCalcComboBox->currentIndex();
     params["reverse_rx"] = ui->reverseRxCheckBox->isChecked();
+    params["common_mode"] = ui->commonModeComboBox->currentIndex();
+    params["median_frames"] = ui->medianComboBox->currentIndex();
+    params["iir_shift"] = ui->iirComboBox->currentIndex();
+    params["spatial_smooth"] = ui->smoothCheckBox->isChecked();
+    params["line_stats"] = ui->lineStatsComboBox->currentIndex();
+    params["overview_mode"] = ui->overviewComboBox->currentIndex();
+    params["overview_pooling"] = ui->poolingComboBox->currentIndex();
 
     // 保存 bottom_1 配置
     params["raw_data_pos"] = ui->rawDataPosLineEdit->text().toInt();
     params["byte_order"] = ui->byteOrderComboBox->currentIndex();
+    params["input_format"] = ui->inputFormatComboBox->currentIndex();
     params["auto_filter_bits"] = ui->autoFilterSpinBox->value();
     params["filter_start_pos"] = ui->filterStartLineEdit->text().toInt();
     params["filter_mode"] = ui->filterModeComboBox->currentIndex();
@@ -342,27 +636,30 @@ void FunctionPage::saveConfig()
     params["hex_input3"] = ui->hexInput3->text();
     params["hex_input4"] = ui->hexInput4->text();
     params["hex_input5"] = ui->hexInput5->text();
+    params["extra_patterns"] = ui->extraPatternsLineEdit->text();
+    params["timestamp_pos"] = ui->timestampPosLineEdit->text().isEmpty() ? -1 : ui->timestampPosLineEdit->text().toInt();
+    params["timestamp_bytes"] = ui->timestampBytesSpinBox->value();
+    params["timestamp_unit"] = ui->timestampUnitComboBox->currentIndex();
+    params["sequence_pos"] = ui->sequencePosLineEdit->text().isEmpty() ? -1 : ui->sequencePosLineEdit->text().toInt();
+    params["sequence_bytes"] = ui->sequenceBytesSpinBox->value();
 
     // 保存 bottom_3 文件路径
     params["baseline_file_path"] = ui->baselineFileLineEdit->text();
+    params["baseline_start"] = ui->baselineStartSpinBox->value();
+    params["baseline_frames"] = ui->baselineFramesSpinBox->value();
+    params["baseline_method"] = ui->baselineMethodComboBox->currentIndex();
     params["touch_file_path"] = ui->touchFileLineEdit->text();
+    params["prefetch_touch_file"] = ui->prefetchCheckBox->isChecked();
 
     // 保存最大读取行数
     params["max_rows"] = ui->maxRowsLineEdit->text().toInt();
+    params["memory_budget_mb"] = ui->memoryBudgetSpinBox->value();
 
     // 保存播放速度
     params["play_speed"] = ui->playSpeedLineEdit->text().toInt();
+    params["play_clock"] = ui->playClockComboBox->currentIndex();
 
-    QJsonObject root;
-    root["parameters"] = params;
-
-    QJsonDocument doc(root);
-
-    QFile file("config.json");
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(doc.toJson(QJsonDocument::Indented));
-        file.close();
-    }
+    return params;
 }
 
 void FunctionPage::validateHexInput()
@@ -409,6 +706,14 @@ void FunctionPage::validateIntInput()
     bool isMaxRows = (lineEdit == ui->maxRowsLineEdit);
     int minValue = isMaxRows ? 1 : 0;
 
+    // 时间戳/帧序号列可以留空（不读取）
+    bool isOptional = (lineEdit == ui->timestampPosLineEdit || lineEdit == ui->sequencePosLineEdit);
+    if (text.isEmpty() && isOptional) {
+        lineEdit->clear();
+        saveConfig();
+        return;
+    }
+
     // 如果输入为空，设置为最小值
     if (text.isEmpty()) {
         lineEdit->setText(QString::number(minValue));
@@ -474,28 +779,97 @@ void FunctionPage::updatePlaySpeed()
     int speed = ui->playSpeedLineEdit->text().toInt();
     if (speed < 10) speed = 200; // 保护机制
 
-    // 如果定时器正在运行，需要重启才能使新间隔生效
-    bool wasRunning = playTimer->isActive();
-    if (wasRunning) {
-        playTimer->stop();
+    playTimer->setInterval(speed);
+
+    // 正在播放时需要重启定时器才能使新间隔生效
+    if (isPlaying) {
+        restartPlayTimer();
     }
 
-    playTimer->setInterval(speed);
+    saveConfig();
+}
+
+namespace {
 
-    if (wasRunning) {
-        playTimer->start();
+// playClockComboBox 各项对应的倍速，0 表示按固定间隔播放
+const double kPlayRates[] = {0.0, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0};
+
+// 按采集时间播放时，采集中超过该时长的空档按该时长播放
+const qint64 kMaxTimedGapMs = 2000;
+
+} // namespace
+
+double FunctionPage::playRate() const
+{
+    int index = ui->playClockComboBox->currentIndex();
+    if (index < 0 || index >= int(sizeof(kPlayRates) / sizeof(kPlayRates[0]))) {
+        return 0.0;
     }
+    return kPlayRates[index];
+}
+
+bool FunctionPage::isTimedPlayback() const
+{
+    // 没有读取时间戳时退回固定间隔
+    return playRate() > 0.0 && session->primaryFrames().hasTimestamps();
+}
 
+void FunctionPage::onPlayClockChanged(int index)
+{
+    Q_UNUSED(index);
+    if (isPlaying) {
+        restartPlayTimer();
+    }
     saveConfig();
 }
 
+void FunctionPage::restartPlayTimer()
+{
+    if (isTimedPlayback()) {
+        playTimer->setSingleShot(true);
+        playTimer->setTimerType(Qt::PreciseTimer);
+        syncPlayClock();
+        scheduleTimedFrame();
+    } else {
+        playTimer->setSingleShot(false);
+        playTimer->setTimerType(Qt::CoarseTimer);
+        playTimer->start(qMax(10, ui->playSpeedLineEdit->text().toInt()));
+    }
+}
+
+void FunctionPage::syncPlayClock()
+{
+    // 以当前帧为起点，之后的墙钟时间乘以倍速换算成采集时间
+    playClock.start();
+    playClockOriginUs = touchFrames().timestamp(currentFrame);
+}
+
+qint64 FunctionPage::playbackCaptureTime() const
+{
+    return playClockOriginUs + qint64(double(playClock.nsecsElapsed()) / 1000.0 * playRate());
+}
+
+void FunctionPage::scheduleTimedFrame()
+{
+    const FrameStore &frames = touchFrames();
+    if (currentFrame + 1 >= frames.frameCount()) {
+        // 与固定间隔一致：最后一帧之后再触发一次以结束播放
+        playTimer->start(0);
+        return;
+    }
+
+    // 等到下一帧的采集时刻；向上取整到毫秒，保证触发时已到达该帧
+    qint64 waitUs = qint64(double(frames.timestamp(currentFrame + 1) - playbackCaptureTime()) / playRate());
+    playTimer->start(int(qBound<qint64>(0, (waitUs + 999) / 1000, kMaxTimedGapMs)));
+}
+
 void FunctionPage::onBaselineFileBrowse()
 {
     QString fileName = QFileDialog::getOpenFileName(
         this,
         tr("选择基线数据文件"),
         "",
-        tr("CSV文件 (*.csv);;所有文件 (*.*)")
+        tr("数据文件 (*.csv *.rgdf);;CSV文件 (*.csv);;RGD归档 (*.rgdf);;所有文件 (*.*)")
     );
 
     if (!fileName.isEmpty()) {
@@ -510,10 +884,14 @@ void FunctionPage::onTouchFileBrowse()
         this,
         tr("选择触摸数据文件"),
         "",
-        tr("CSV文件 (*.csv);;所有文件 (*.*)")
+        tr("数据文件 (*.csv *.rgdf);;CSV文件 (*.csv);;RGD归档 (*.rgdf);;所有文件 (*.*)")
     );
 
     if (!fileName.isEmpty()) {
+        // 换了文件，之前预读的结果不会再用到
+        if (fileName != ui->touchFileLineEdit->text()) {
+            touchPrefetcher.discard();
+        }
         ui->touchFileLineEdit->setText(fileName);
         saveConfig();
     }
@@ -579,422 +957,625 @@ void FunctionPage::onBaselineDataButtonClicked()
 void FunctionPage::onBaselineReadButtonClicked()
 {
     if (readBaselineData()) {
-        QMessageBox::information(this, tr("读取成功"), tr("基线数据读取完成！"));
+        QMessageBox::information(this, tr("读取成功"), tr("基线数据读取完成！\n\n%1").arg(baselineReport));
     } else {
         QMessageBox::warning(this, tr("读取失败"), tr("基线数据读取失败，请检查文件路径和格式！"));
     }
 }
 
-bool FunctionPage::matchFilterPattern(const QStringList &data, int startPos, const QVector<QString> &pattern)
+ParseSettings FunctionPage::currentParseSettings() const
 {
-    // 检查是否有足够的数据进行匹配
-    if (startPos + pattern.size() > data.size()) {
-        return false;
-    }
-
-    // 逐个匹配
-    for (int i = 0; i < pattern.size(); ++i) {
-        QString dataValue = data[startPos + i].trimmed().toUpper();
-        QString patternValue = pattern[i].toUpper();
+    ParseSettings settings;
+    settings.rxCount = ui->rxSpinBox->value();
+    settings.txCount = ui->txSpinBox->value();
+    settings.rawDataPos = ui->rawDataPosLineEdit->text().toInt();
+    settings.filterStartPos = ui->filterStartLineEdit->text().toInt();
+    settings.filterMode = ui->filterModeComboBox->currentIndex(); // 0=本行, 1=下一行
+    settings.isBigEndian = (ui->byteOrderComboBox->currentIndex() == 0); // 0=大端, 1=小端
+    settings.inputFormat = ui->inputFormatComboBox->currentIndex();      // 0=自动识别, 1=文本, 2=二进制
+    settings.maxRows = ui->maxRowsLineEdit->text().toInt();
+
+    // 时间戳/帧序号列，留空表示不读取
+    settings.timestampPos = ui->timestampPosLineEdit->text().isEmpty() ? -1 : ui->timestampPosLineEdit->text().toInt();
+    settings.timestampBytes = ui->timestampBytesSpinBox->value();
+    settings.timestampUnitUs = (ui->timestampUnitComboBox->currentIndex() == 1) ? 1000 : 1; // 0=μs, 1=ms
+    settings.sequencePos = ui->sequencePosLineEdit->text().isEmpty() ? -1 : ui->sequencePosLineEdit->text().toInt();
+    settings.sequenceBytes = ui->sequenceBytesSpinBox->value();
 
-        // 移除可能的0x前缀
-        if (dataValue.startsWith("0X")) {
-            dataValue = dataValue.mid(2);
-        }
-        if (patternValue.startsWith("0X")) {
-            patternValue = patternValue.mid(2);
-        }
+    // 构建过滤模式
+    int autoFilterBits = ui->autoFilterSpinBox->value();
+    settings.pattern.append(ui->hexInput1->text());
+    if (autoFilterBits >= 2) settings.pattern.append(ui->hexInput2->text());
+    if (autoFilterBits >= 3) settings.pattern.append(ui->hexInput3->text());
+    if (autoFilterBits >= 4) settings.pattern.append(ui->hexInput4->text());
+    if (autoFilterBits >= 5) settings.pattern.append(ui->hexInput5->text());
 
-        // 确保是2位十六进制数
-        while (dataValue.length() < 2) dataValue = "0" + dataValue;
-        while (patternValue.length() < 2) patternValue = "0" + patternValue;
+    return settings;
+}
 
-        if (dataValue != patternValue) {
-            return false;
+QVector<QVector<QString>> FunctionPage::scanPatterns() const
+{
+    // 第一组为 hexInput 中的帧头，其余来自"其他帧头"（分号分隔，每组内用空格或逗号分隔字节）
+    QVector<QVector<QString>> patterns;
+    patterns.append(currentParseSettings().pattern);
+
+    const QStringList groups = ui->extraPatternsLineEdit->text().split(';');
+    for (const QString &group : groups) {
+        QVector<QString> pattern;
+        const QStringList bytes = group.split(QRegularExpression("[\\s,]+"));
+        for (const QString &byte : bytes) {
+            if (!byte.isEmpty()) {
+                pattern.append(byte);
+            }
+        }
+        if (!pattern.isEmpty()) {
+            patterns.append(pattern);
         }
     }
-
-    return true;
+    return patterns;
 }
 
-QVector<qint16> FunctionPage::parseCSVLine(const QString &line, int startPos, int count, bool isBigEndian)
+void FunctionPage::displayData(const qint16 *data, int count, bool asHex)
 {
-    QVector<qint16> result;
+    int rxCount = ui->rxSpinBox->value();
+    int txCount = ui->txSpinBox->value();
 
-    // 分割CSV行
-    QStringList data = line.split(',');
+    // 检查数据量是否匹配
+    if (count != rxCount * txCount) {
+        QMessageBox::warning(this, tr("数据量不匹配"),
+            tr("读取的数据量(%1)与表格大小(%2x%3=%4)不匹配！")
+            .arg(count).arg(rxCount).arg(txCount).arg(rxCount * txCount));
+        return;
+    }
 
-    // 移除所有数据的空白字符
-    for (QString &item : data) {
-        item = item.trimmed();
+    // 设置了 ROI 时只显示和分析该区域
+    const QRect region = activeRoi();
+    const qint16 *viewData = data;
+    if (region.width() != rxCount || region.height() != txCount) {
+        qint16 *cropped = frameArena.allocate<qint16>(region.width() * region.height());
+        FramePooler::crop(data, rxCount, region, cropped);
+        viewData = cropped;
     }
+    const int viewRx = region.width();
+    const int viewTx = region.height();
 
-    // 检查是否有足够的数据
-    if (startPos >= data.size() || startPos + count > data.size()) {
-        return result;
+    // 连通域 + 峰值检测（只在信号数据模式下），检测结果用于表格颜色和热力图标记
+    const bool withPeaks = !asHex && currentDataMode == SignalData;
+    if (withPeaks) {
+        QElapsedTimer timer;
+        timer.start();
+        peakDetector.detect(viewData, viewRx, viewTx, ui->signalThresholdSpinBox->value());
+        PERF_DEBUG("[性能] 峰值检测耗时:" << timer.elapsed() << "ms, 峰值数:" << peakDetector.peaks().size());
     }
 
-    // 每两个8位数据组成一个16位数据
-    for (int i = 0; i < count; i += 2) {
-        if (startPos + i + 1 >= data.size()) {
-            break;
-        }
+    viewFactor = overviewFactor(viewRx, viewTx);
+    if (ui->heatmapButton->isChecked()) {
+        displayDataInHeatmap(viewData, viewRx, viewTx, asHex, withPeaks);
+    } else {
+        displayDataInTable(viewData, viewRx, viewTx, asHex, withPeaks);
+    }
+    updateLineProfiles(viewData, viewRx, viewTx, asHex);
+}
 
-        // 读取两个8位十六进制数
-        bool ok1, ok2;
-        QString hex1 = data[startPos + i].trimmed();
-        QString hex2 = data[startPos + i + 1].trimmed();
+void FunctionPage::updateLineProfiles(const qint16 *data, int rxCount, int txCount, bool asHex)
+{
+    // lineStatsComboBox 各项对应的统计（第 0 项为关闭）
+    static const LineReducer::Statistic kStatistics[] = {
+        LineReducer::Mean, LineReducer::Mean, LineReducer::Median, LineReducer::Sum
+    };
+
+    // 行列统计只对信号数据有意义
+    const int index = ui->lineStatsComboBox->currentIndex();
+    const bool visible = index > 0 && !asHex && currentDataMode == SignalData;
+    if (rowStrip->isHidden() == visible) {
+        rowStrip->setVisible(visible);
+        columnStrip->setVisible(visible);
+    }
+    if (!visible) {
+        return;
+    }
 
-        // 移除可能的0x前缀
-        if (hex1.startsWith("0x", Qt::CaseInsensitive)) {
-            hex1 = hex1.mid(2);
-        }
-        if (hex2.startsWith("0x", Qt::CaseInsensitive)) {
-            hex2 = hex2.mid(2);
-        }
+    lineReducer.reduce(data, rxCount, txCount, kStatistics[qBound(0, index, 3)]);
+    columnStrip->setValues(lineReducer.columnValues(), ui->reverseRxCheckBox->isChecked());
+    rowStrip->setValues(lineReducer.rowValues());
 
-        quint8 byte1 = hex1.toUInt(&ok1, 16);
-        quint8 byte2 = hex2.toUInt(&ok2, 16);
+    // 与当前视图的格子区域对齐（表格减去表头，热力图减去标题和范围文字）
+    QWidget *view = ui->dataTable;
+    QRect grid = ui->dataTable->viewport()->geometry();
+    if (ui->heatmapButton->isChecked()) {
+        view = heatmapView;
+        grid = heatmapView->gridRect();
+    }
+    columnStrip->setSpan(grid.left(), view->width() - grid.right() - 1);
+    rowStrip->setSpan(grid.top(), view->height() - grid.bottom() - 1);
+}
 
-        if (!ok1 || !ok2) {
-            continue;
-        }
+QRect FunctionPage::activeRoi() const
+{
+    // 面板尺寸变化后不在面板内的 ROI 不再生效
+    const QRect panel(0, 0, ui->rxSpinBox->value(), ui->txSpinBox->value());
+    return (roiRect.isNull() || !panel.contains(roiRect)) ? panel : roiRect;
+}
 
-        // 根据字节序组合
-        qint16 value;
-        if (isBigEndian) {
-            // 大端：第一个字节是高字节
-            value = (byte1 << 8) | byte2;
-        } else {
-            // 小端：第一个字节是低字节
-            value = (byte2 << 8) | byte1;
-        }
+void FunctionPage::setRoi(const QRect &region)
+{
+    const QRect panel(0, 0, ui->rxSpinBox->value(), ui->txSpinBox->value());
+    const QRect clipped = region.intersected(panel);
+    roiRect = (clipped.isEmpty() || clipped == panel) ? QRect() : clipped;
+
+    ui->roiButton->setChecked(!roiRect.isNull());
+    ui->roiButton->setToolTip(roiRect.isNull()
+        ? tr("在表格中框选区域后点击，只显示和分析该区域；也可以在热力图上拖动框选")
+        : tr("ROI: RX%1-%2, TX%3-%4（点击取消）")
+              .arg(roiRect.left()).arg(roiRect.right()).arg(roiRect.top()).arg(roiRect.bottom()));
+    ui->dataTable->clearSelection();
+}
 
-        result.append(value);
+int FunctionPage::overviewFactor(int rxCount, int txCount) const
+{
+    // overviewComboBox: 0=逐节点, 1=自动, 2=2×2, 3=4×4, 4=8×8
+    const int index = ui->overviewComboBox->currentIndex();
+    if (index >= 2) {
+        return 1 << (index - 1);
+    }
+    if (index != 1) {
+        return 1;
     }
 
-    return result;
+    // 自动：表格每格不小于表头的最小尺寸，热力图每个节点至少 1 像素
+    if (ui->heatmapButton->isChecked()) {
+        const QRect grid = heatmapView->gridRect();
+        return FramePooler::autoFactor(rxCount, txCount, grid.width(), grid.height(), 1, 1);
+    }
+    const QSize available = ui->dataTable->maximumViewportSize();
+    return FramePooler::autoFactor(rxCount, txCount, available.width(), available.height(),
+                                   ui->dataTable->horizontalHeader()->minimumSectionSize(),
+                                   ui->dataTable->verticalHeader()->minimumSectionSize());
 }
 
-void FunctionPage::applySignalDataColors(const QVector<qint16> &data, int rxCount, int txCount)
+void FunctionPage::updateTableLayout()
 {
-    QElapsedTimer timer;
-    timer.start();
-
-    int signalThreshold = ui->signalThresholdSpinBox->value();
-
-    // 创建二维数组存储数据（tx行，rx列）
-    QElapsedTimer gridTimer;
-    gridTimer.start();
-    QVector<QVector<qint16>> grid(txCount, QVector<qint16>(rxCount));
-    int dataIndex = 0;
-    for (int tx = 0; tx < txCount; ++tx) {
-        for (int rx = 0; rx < rxCount; ++rx) {
-            grid[tx][rx] = data[dataIndex++];
+    // 格子放得下时拉伸铺满；放不下时固定为最小尺寸并滚动，视图只布局和绘制可见的格子
+    const QSize available = ui->dataTable->maximumViewportSize();
+    QHeaderView *headers[] = { ui->dataTable->horizontalHeader(), ui->dataTable->verticalHeader() };
+    const int counts[] = { tableModel->columnCount(), tableModel->rowCount() };
+    const int extents[] = { available.width(), available.height() };
+    for (int i = 0; i < 2; ++i) {
+        QHeaderView *header = headers[i];
+        const bool fits = counts[i] * header->minimumSectionSize() <= extents[i];
+        const QHeaderView::ResizeMode mode = fits ? QHeaderView::Stretch : QHeaderView::Fixed;
+        if (counts[i] > 0 && header->sectionResizeMode(0) != mode) {
+            header->setDefaultSectionSize(header->minimumSectionSize());
+            header->setSectionResizeMode(mode);
         }
     }
+}
 
-    // 标记访问过的格子和超过阈值的格子
-    QVector<QVector<bool>> visited(txCount, QVector<bool>(rxCount, false));
-    QVector<QVector<bool>> isPeak(txCount, QVector<bool>(rxCount, false));
-
-    // 8邻域方向（上、下、左、右、左上、右上、左下、右下）
-    int dx[] = {-1, 1, 0, 0, -1, -1, 1, 1};
-    int dy[] = {0, 0, -1, 1, -1, 1, -1, 1};
-
-    // BFS查找连通域
-    QElapsedTimer bfsTimer;
-    bfsTimer.start();
-    int componentCount = 0;
-    for (int tx = 0; tx < txCount; ++tx) {
-        for (int rx = 0; rx < rxCount; ++rx) {
-            if (!visited[tx][rx] && grid[tx][rx] > signalThreshold) {
-                componentCount++;
-                // 找到一个新的连通域，使用BFS遍历
-                QVector<QPair<int, int>> component; // 存储当前连通域的所有格子
-                QQueue<QPair<int, int>> queue;
-
-                queue.enqueue(qMakePair(tx, rx));
-                visited[tx][rx] = true;
-
-                while (!queue.isEmpty()) {
-                    auto current = queue.dequeue();
-                    int ctx = current.first;
-                    int crx = current.second;
-                    component.append(current);
-
-                    // 检查8邻域
-                    for (int d = 0; d < 8; ++d) {
-                        int ntx = ctx + dx[d];
-                        int nrx = crx + dy[d];
-
-                        // 边界检查
-                        if (ntx >= 0 && ntx < txCount && nrx >= 0 && nrx < rxCount) {
-                            if (!visited[ntx][nrx] && grid[ntx][nrx] > signalThreshold) {
-                                visited[ntx][nrx] = true;
-                                queue.enqueue(qMakePair(ntx, nrx));
-                            }
-                        }
-                    }
-                }
+void FunctionPage::onOverviewChanged()
+{
+    saveConfig();
+    revalidateData();
+}
 
-                // 在当前连通域中检测峰值
-                for (const auto &pos : component) {
-                    int ctx = pos.first;
-                    int crx = pos.second;
-                    qint16 centerValue = grid[ctx][crx];
-                    bool isLocalPeak = true;
-
-                    // 检查8邻域，看是否为峰值
-                    for (int d = 0; d < 8; ++d) {
-                        int ntx = ctx + dx[d];
-                        int nrx = crx + dy[d];
-
-                        if (ntx >= 0 && ntx < txCount && nrx >= 0 && nrx < rxCount) {
-                            if (grid[ntx][nrx] > centerValue) {
-                                isLocalPeak = false;
-                                break;
-                            }
-                        }
-                    }
-
-                    if (isLocalPeak) {
-                        isPeak[ctx][crx] = true;
-                    }
-                }
-            }
-        }
+void FunctionPage::onRoiButtonClicked()
+{
+    // 已有 ROI 时点击取消
+    if (!roiRect.isNull()) {
+        setRoi(QRect());
+        revalidateData();
+        return;
     }
 
-    // 应用颜色（使用静态颜色对象避免重复创建）
-    QElapsedTimer colorTimer;
-    colorTimer.start();
-    static QColor peakColor("#32C8B4");      // 青绿色 - 峰值
-    static QColor thresholdColor("#FA78E0");  // 粉色 - 超过阈值
-    static QColor defaultColor("#FFFFEF");    // 默认背景色
-
-    int colorChanges = 0;
-    int thresholdCount = 0;
-    int peakCount = 0;
-    bool reverseRx = ui->reverseRxCheckBox->isChecked();
-    for (int tx = 0; tx < txCount; ++tx) {
-        for (int rx = 0; rx < rxCount; ++rx) {
-            // 计算实际的列索引（如果反转RX，则应用到反转后的位置）
-            int actualRx = reverseRx ? (rxCount - 1 - rx) : rx;
-            QTableWidgetItem *item = ui->dataTable->item(tx, actualRx);
-            if (item) {
-                QColor newColor;
-                if (grid[tx][rx] > signalThreshold) {
-                    thresholdCount++;
-                    if (isPeak[tx][rx]) {
-                        newColor = peakColor;
-                        peakCount++;
-                    } else {
-                        newColor = thresholdColor;
-                    }
-                } else {
-                    newColor = defaultColor;
-                }
+    // 表格中选中格子的外接矩形（模型坐标）换算回节点坐标
+    const QModelIndexList selected = ui->dataTable->selectionModel()->selectedIndexes();
+    if (selected.isEmpty() || ui->heatmapButton->isChecked()) {
+        ui->roiButton->setChecked(false);
+        QMessageBox::information(this, tr("设置 ROI"), tr("请先在表格中框选区域，或在热力图上拖动框选！"));
+        return;
+    }
+    int firstRow = tableModel->rowCount();
+    int lastRow = -1;
+    int firstColumn = tableModel->columnCount();
+    int lastColumn = -1;
+    for (const QModelIndex &index : selected) {
+        firstRow = qMin(firstRow, index.row());
+        lastRow = qMax(lastRow, index.row());
+        firstColumn = qMin(firstColumn, index.column());
+        lastColumn = qMax(lastColumn, index.column());
+    }
+    if (ui->reverseRxCheckBox->isChecked()) {
+        const int columns = tableModel->columnCount();
+        const int first = columns - 1 - lastColumn;
+        lastColumn = columns - 1 - firstColumn;
+        firstColumn = first;
+    }
+
+    const QRect base = activeRoi();
+    setRoi(QRect(base.left() + firstColumn * viewFactor, base.top() + firstRow * viewFactor,
+                 (lastColumn - firstColumn + 1) * viewFactor, (lastRow - firstRow + 1) * viewFactor)
+               .intersected(base));
+    revalidateData();
+}
 
-                // 只在颜色不同时才设置，避免不必要的更新
-                if (item->background().color() != newColor) {
-                    // 使用 setData 设置背景色，优先级更高
-                    item->setData(Qt::BackgroundRole, QBrush(newColor));
-                    colorChanges++;
-                }
-            }
+void FunctionPage::onHeatmapRegionSelected(const QRect &cells)
+{
+    // 热力图格子（概览时每格 viewFactor×viewFactor 个节点）换算回节点坐标
+    const QRect base = activeRoi();
+    setRoi(QRect(base.left() + cells.left() * viewFactor, base.top() + cells.top() * viewFactor,
+                 cells.width() * viewFactor, cells.height() * viewFactor).intersected(base));
+    revalidateData();
+}
+
+bool FunctionPage::eventFilter(QObject *watched, QEvent *event)
+{
+    // 数据区大小变化时重新决定表格的布局方式；自动概览还要按新尺寸重新合并
+    if (event->type() == QEvent::Resize && (watched == ui->dataTable || watched == heatmapView)) {
+        if (ui->overviewComboBox->currentIndex() == 1) {
+            revalidateData();
+        } else if (watched == ui->dataTable) {
+            updateTableLayout();
         }
     }
+    return QWidget::eventFilter(watched, event);
 }
 
-void FunctionPage::displayDataInTable(const QVector<qint16> &data, bool asHex)
+void FunctionPage::onLineStatsChanged(int index)
 {
-    QElapsedTimer totalTimer;
-    totalTimer.start();
+    Q_UNUSED(index);
+    saveConfig();
+    displayCurrentFrame();
+}
 
-    int rxCount = ui->rxSpinBox->value();
-    int txCount = ui->txSpinBox->value();
+void FunctionPage::startTouchPrefetch()
+{
+    const QString filePath = ui->touchFileLineEdit->text();
+    if (!ui->prefetchCheckBox->isChecked() || filePath.isEmpty() || FrameArchive::isArchive(filePath)) {
+        return;
+    }
+    touchPrefetcher.start(filePath, currentParseSettings(), scanPatterns());
+}
 
-    // 检查数据量是否匹配
-    if (data.size() != rxCount * txCount) {
-        QMessageBox::warning(this, tr("数据量不匹配"),
-            tr("读取的数据量(%1)与表格大小(%2x%3=%4)不匹配！")
-            .arg(data.size()).arg(rxCount).arg(txCount).arg(rxCount * txCount));
+void FunctionPage::restartCommonModeScan()
+{
+    ui->worstFramesComboBox->clear();
+    const FrameStore &frames = touchFrames();
+    if (frames.isEmpty() || baselineData.size() != frames.frameSize()
+        || frames.frameSize() != ui->rxSpinBox->value() * ui->txSpinBox->value()) {
+        commonModeScanner->cancel();
+        ui->worstFramesComboBox->addItem(tr("共模排查: 无数据"));
+        ui->worstFramesComboBox->setEnabled(false);
         return;
     }
 
-    // 暂时禁用表格更新，批量修改后一次性刷新
-    ui->dataTable->setUpdatesEnabled(false);
-
-    // 按从左到右，从上到下的顺序填充表格
-    QElapsedTimer fillTimer;
-    fillTimer.start();
-    bool reverseRx = ui->reverseRxCheckBox->isChecked();
-    int dataIndex = 0;
-    for (int tx = 0; tx < txCount; ++tx) {
-        for (int rx = 0; rx < rxCount; ++rx) {
-            QString text;
-            if (asHex) {
-                // 16进制显示，将有符号数视为无符号数显示
-                quint16 unsignedValue = static_cast<quint16>(data[dataIndex]);
-                text = QString("%1").arg(unsignedValue, 4, 16, QChar('0')).toUpper();
-            } else {
-                // 10进制显示
-                text = QString::number(data[dataIndex]);
-            }
+    ui->worstFramesComboBox->addItem(tr("共模排查: 扫描中..."));
+    ui->worstFramesComboBox->setEnabled(true);
+    commonModeScanner->start(frames, baselineData, ui->signalCalcComboBox->currentIndex() == 0,
+                             ui->rxSpinBox->value(), ui->txSpinBox->value());
+}
 
-            // 计算实际填充的列索引（如果反转RX，则从右往左填充）
-            int actualRx = reverseRx ? (rxCount - 1 - rx) : rx;
+void FunctionPage::onCommonModeScanProgress()
+{
+    // 每批扫描完成后刷新列表，扫描未结束时也可以先跳转到已找到的帧
+    const int scanned = commonModeScanner->scannedFrames();
+    const int total = qMax(1, commonModeScanner->totalFrames());
+    QComboBox *combo = ui->worstFramesComboBox;
+    combo->blockSignals(true);
+    combo->clear();
+    if (commonModeScanner->isRunning()) {
+        combo->addItem(tr("共模排查: 扫描中 %1%").arg(scanned * 100 / total));
+    } else {
+        combo->addItem(tr("共模最差帧 (共 %1 帧)").arg(scanned));
+    }
+    for (const CommonModeScanner::Entry &entry : commonModeScanner->worstFrames()) {
+        combo->addItem(tr("第 %1 帧  %2%3  %4")
+                           .arg(entry.frame + 1)
+                           .arg(entry.isRow ? "TX" : "RX")
+                           .arg(entry.line)
+                           .arg(entry.offset > 0 ? QString("+%1").arg(entry.offset) : QString::number(entry.offset)));
+    }
+    combo->blockSignals(false);
+}
 
-            // 重用已存在的item，直接设置文本（item一定存在，因为已预创建）
-            QTableWidgetItem *item = ui->dataTable->item(tx, actualRx);
-            item->setText(text);
-            dataIndex++;
-        }
+void FunctionPage::onWorstFrameActivated(int index)
+{
+    const QVector<CommonModeScanner::Entry> &entries = commonModeScanner->worstFrames();
+    if (index <= 0 || index > entries.size()) {
+        return;
+    }
+
+    // 跳转到该帧并以信号数据显示
+    stopPlayback();
+    currentFrame = qBound(0, entries[index - 1].frame, qMax(0, touchFrames().frameCount() - 1));
+    if (currentDataMode != SignalData) {
+        onSignalDataButtonClicked();
+    } else {
+        displayCurrentFrame();
     }
-    PERF_DEBUG("[性能] 填充表格数据耗时:" << fillTimer.elapsed() << "ms");
+    updateFrameButtons();
+    updateProgressBar();
+}
+
+void FunctionPage::displayDataInTable(const qint16 *data, int rxCount, int txCount, bool asHex, bool withPeaks)
+{
+    QElapsedTimer totalTimer;
+    totalTimer.start();
 
-    // 最后应用背景颜色（在所有表格操作完成之后）
-    // 如果是信号数据模式（非16进制），应用背景颜色逻辑
-    QElapsedTimer colorTimer;
-    colorTimer.start();
-    if (!asHex && currentDataMode == SignalData) {
-        applySignalDataColors(data, rxCount, txCount);
+    // 概览：按块合并后再交给模型，格子数随合并倍数减少
+    const int factor = viewFactor;
+    const int tableRx = FramePooler::pooledCount(rxCount, factor);
+    const int tableTx = FramePooler::pooledCount(txCount, factor);
+    const qint16 *tableData = data;
+    if (factor > 1) {
+        qint16 *pooled = frameArena.allocate<qint16>(tableRx * tableTx);
+        FramePooler::pool(data, rxCount, txCount, factor, FramePooler::Mode(ui->poolingComboBox->currentIndex()),
+                          pooled);
+        tableData = pooled;
+    }
+
+    const QRect region = activeRoi();
+    tableModel->setDimensions(tableRx, tableTx);
+    tableModel->setHeaderMapping(region.left(), region.top(), factor, rxCount, txCount);
+    updateTableLayout();
+
+    // 模型复制一帧数据后通知视图刷新，文本在绘制可见单元格时才生成
+    tableModel->setFrame(tableData, asHex, ui->reverseRxCheckBox->isChecked());
+
+    // 如果是信号数据模式（非16进制），检测结果直接作为表格的颜色状态；否则恢复默认背景色
+    if (withPeaks && factor > 1) {
+        pooledStates.resize(tableRx * tableTx);
+        FramePooler::poolStates(peakDetector.states().constData(), rxCount, txCount, factor, pooledStates.data());
+        tableModel->setCellColors(pooledStates);
+    } else if (withPeaks) {
+        tableModel->setCellColors(peakDetector.states());
     } else {
-        // 如果不是信号数据模式，清除所有背景色（只在必要时设置）
-        static QColor defaultColor("#FFFFEF");
-        bool reverseRx = ui->reverseRxCheckBox->isChecked();
-        for (int tx = 0; tx < txCount; ++tx) {
-            for (int rx = 0; rx < rxCount; ++rx) {
-                // 计算实际的列索引
-                int actualRx = reverseRx ? (rxCount - 1 - rx) : rx;
-                QTableWidgetItem *item = ui->dataTable->item(tx, actualRx);
-                if (item) {
-                    // 只在颜色不同时才设置，避免不必要的更新
-                    if (item->background().color() != defaultColor) {
-                        // 使用 setData 设置背景色
-                        item->setData(Qt::BackgroundRole, QBrush(defaultColor));
-                    }
-                }
-            }
-        }
+        tableModel->clearCellColors();
     }
-    // 立即重新启用更新并返回，让 Qt 异步处理重绘
-    ui->dataTable->setUpdatesEnabled(true);
 
-    PERF_DEBUG("[性能] displayDataInTable 完整总耗时（含启用更新）:" << totalTimer.elapsed() << "ms");
+    PERF_DEBUG("[性能] displayDataInTable 总耗时:" << totalTimer.elapsed() << "ms");
     PERF_DEBUG("========================================");
 }
 
-bool FunctionPage::readBaselineData()
+void FunctionPage::displayDataInHeatmap(const qint16 *data, int rxCount, int txCount, bool asHex, bool withPeaks)
 {
-    // 获取文件路径
-    QString filePath = ui->baselineFileLineEdit->text();
+    QElapsedTimer timer;
+    timer.start();
+
+    const int factor = viewFactor;
+    const int mapRx = FramePooler::pooledCount(rxCount, factor);
+    const int mapTx = FramePooler::pooledCount(txCount, factor);
+    const qint16 *mapData = data;
+    if (factor > 1) {
+        qint16 *pooled = frameArena.allocate<qint16>(mapRx * mapTx);
+        FramePooler::pool(data, rxCount, txCount, factor, FramePooler::Mode(ui->poolingComboBox->currentIndex()),
+                          pooled);
+        mapData = pooled;
+    }
+
+    // 峰值标记只在信号数据模式下有意义；概览时标在峰值所在的格子上
+    if (withPeaks && factor > 1) {
+        pooledPeaks.resize(0);
+        for (const QPoint &peak : peakDetector.peaks()) {
+            pooledPeaks.append(QPoint(peak.x() / factor, peak.y() / factor));
+        }
+        heatmapView->setPeaks(pooledPeaks);
+    } else if (withPeaks) {
+        heatmapView->setPeaks(peakDetector.peaks());
+    } else {
+        heatmapView->setPeaks(QVector<QPoint>());
+    }
+
+    heatmapView->setValueOverlay(ui->overlayButton->isChecked(), asHex);
+    heatmapView->setFrame(mapData, mapRx, mapTx, HeatmapRenderer::Sequential, ui->reverseRxCheckBox->isChecked());
+
+    PERF_DEBUG("[性能] displayDataInHeatmap 耗时:" << timer.nsecsElapsed() / 1000 << "us");
+}
+
+bool FunctionPage::readBaselineData()
+{
+    // 获取文件路径
+    QString filePath = ui->baselineFileLineEdit->text();
     if (filePath.isEmpty()) {
         QMessageBox::warning(this, tr("文件路径为空"), tr("请先选择基线数据文件！"));
         return false;
     }
 
-    // 打开CSV文件
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(this, tr("文件打开失败"), tr("无法打开文件：%1").arg(filePath));
+    // 归档不经过帧头筛选，直接解码基线用到的帧；文本文件按帧头筛选
+    QVector<qint16> data;
+    QVector<QVector<qint16>> baselines;      // 多种扫描类型时各类型的基线
+    if (FrameArchive::isArchive(filePath)) {
+        if (!readArchiveBaseline(filePath, data)) {
+            return false;
+        }
+    } else if (!readTextBaseline(filePath, data, baselines)) {
         return false;
     }
 
-    QTextStream in(&file);
+    // 保存基线数据到成员变量
+    baselineData = data;
 
-    // 获取配置参数
-    int autoFilterBits = ui->autoFilterSpinBox->value();
-    int filterStartPos = ui->filterStartLineEdit->text().toInt();
-    int filterMode = ui->filterModeComboBox->currentIndex(); // 0=本行, 1=下一行
-    int rawDataPos = ui->rawDataPosLineEdit->text().toInt();
-    bool isBigEndian = (ui->byteOrderComboBox->currentIndex() == 0); // 0=大端, 1=小端
-    int rxCount = ui->rxSpinBox->value();
-    int txCount = ui->txSpinBox->value();
-    int totalBytes = rxCount * txCount * 2; // 需要读取的8位数据总量
+    // 多种扫描类型时保存各自的基线
+    streamBaselines.clear();
+    if (baselines.size() > 1) {
+        streamBaselines = baselines;
+    }
+    invalidateProcessing();
+    restartCommonModeScan();
 
-    // 构建过滤模式
-    QVector<QString> pattern;
-    pattern.append(ui->hexInput1->text());
-    if (autoFilterBits >= 2) pattern.append(ui->hexInput2->text());
-    if (autoFilterBits >= 3) pattern.append(ui->hexInput3->text());
-    if (autoFilterBits >= 4) pattern.append(ui->hexInput4->text());
-    if (autoFilterBits >= 5) pattern.append(ui->hexInput5->text());
-
-    // 读取并匹配行
-    QString matchedLine;
-    QString nextLine;
-    bool foundMatch = false;
-
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        QStringList data = line.split(',');
-
-        // 移除空白字符
-        for (QString &item : data) {
-            item = item.trimmed();
-        }
+    // 在后台保存 baseLine.txt（16进制文本，与基线文件放在同一目录），排在上一次导出之后
+    QString dumpPath = QFileInfo(filePath).absoluteDir().filePath("baseLine.txt");
+    dumpFuture = FrameExporter::exportBaselineInBackground(data, dumpPath, dumpFuture);
 
-        // 匹配过滤模式
-        if (matchFilterPattern(data, filterStartPos, pattern)) {
-            matchedLine = line;
+    // 以16进制显示在表格中
+    frameArena.reset();
+    displayData(baselineData.constData(), baselineData.size(), true);
 
-            // 如果需要读取下一行，继续读取
-            if (filterMode == 1) {
-                if (!in.atEnd()) {
-                    nextLine = in.readLine();
-                }
-            }
+    return true;
+}
 
-            foundMatch = true;
+bool FunctionPage::readTextBaseline(const QString &filePath, QVector<qint16> &baseline,
+                                    QVector<QVector<qint16>> &baselines)
+{
+    // 获取配置参数
+    ParseSettings settings = currentParseSettings();
+
+    // 从第 firstFrame 条匹配帧起取 frameCount 帧，每个节点取中值或去异常均值；
+    // 多种扫描类型时一次分流读取，各类型分别计算自己的基线
+    const int firstFrame = ui->baselineStartSpinBox->value() - 1;
+    const int frameCount = ui->baselineFramesSpinBox->value();
+    const BaselineBuilder::Method method = BaselineBuilder::Method(ui->baselineMethodComboBox->currentIndex());
+    QVector<QVector<QString>> patterns = scanPatterns();
+    const int stream = qBound(0, currentStream, patterns.size() - 1);
+
+    QVector<FrameStore> batchFrames(patterns.size());
+    QVector<FrameStore *> stores;
+    for (FrameStore &store : batchFrames) {
+        stores.append(&store);
+    }
+    ParseSettings batch = settings;
+    batch.maxRows = firstFrame + frameCount;
+
+    QElapsedTimer readTimer;
+    if (patterns.size() == 1) {
+        // 先读取第一条匹配行，确认帧头和数据格式正确
+        QVector<qint16> data;
+        int decodedCount = 0;
+        TouchDataParser::Status status = TouchDataParser::readFirstFrame(filePath, settings, data, &decodedCount);
+
+        switch (status) {
+        case TouchDataParser::OpenFailed:
+            QMessageBox::warning(this, tr("文件打开失败"), tr("无法打开文件：%1").arg(filePath));
+            return false;
+        case TouchDataParser::NoMatch:
+            QMessageBox::warning(this, tr("未找到匹配行"), tr("在文件中未找到符合筛选条件的数据行！"));
+            return false;
+        case TouchDataParser::EmptyLine:
+            QMessageBox::warning(this, tr("数据行为空"), tr("要读取的数据行为空！"));
+            return false;
+        case TouchDataParser::SizeMismatch:
+            QMessageBox::warning(this, tr("数据解析失败"),
+                tr("解析的数据量(%1)与期望值(%2)不符！").arg(decodedCount).arg(settings.frameSize()));
+            return false;
+        case TouchDataParser::Ok:
             break;
         }
-    }
-
-    file.close();
 
-    if (!foundMatch) {
-        QMessageBox::warning(this, tr("未找到匹配行"), tr("在文件中未找到符合筛选条件的数据行！"));
-        return false;
+        readTimer.start();
+        if (firstFrame == 0 && frameCount == 1) {
+            // 只取第一帧时不必再读一遍文件
+            batchFrames[0].reset(data.size());
+            batchFrames[0].appendFrame(data.constData());
+        } else {
+            TouchDataParser::readStreams(filePath, batch, patterns, stores);
+        }
+    } else {
+        // 第一条匹配行只按第一组帧头查找，多种扫描类型时先分流读取，只检查当前类型读到的帧
+        readTimer.start();
+        ParseDiagnostics diagnostics;
+        if (TouchDataParser::readStreams(filePath, batch, patterns, stores, &diagnostics) == TouchDataParser::OpenFailed) {
+            QMessageBox::warning(this, tr("文件打开失败"), tr("无法打开文件：%1").arg(filePath));
+            return false;
+        }
+        if (batchFrames[stream].isEmpty()) {
+            int failedRows = 0;
+            for (const ParseDiagnostics::Entry &entry : diagnostics.entries()) {
+                if (entry.stream == stream) {
+                    ++failedRows;
+                }
+            }
+            if (failedRows > 0) {
+                QMessageBox::warning(this, tr("数据解析失败"),
+                    tr("当前扫描类型有 %1 行匹配帧头但无法解析，请检查 RX/TX 和数据起始位置等参数！").arg(failedRows));
+            } else {
+                QMessageBox::warning(this, tr("未找到匹配行"), tr("在文件中未找到当前扫描类型的数据行！"));
+            }
+            return false;
+        }
     }
+    const qint64 readMs = readTimer.elapsed();
 
-    // 确定要解析的行
-    QString lineToRead = (filterMode == 0) ? matchedLine : nextLine;
-    if (lineToRead.isEmpty()) {
-        QMessageBox::warning(this, tr("数据行为空"), tr("要读取的数据行为空！"));
+    // 多种扫描类型时以当前类型为准：帧数不足时拒绝读取，质量评估也报告当前类型
+    if (batchFrames[stream].frameCount() <= firstFrame) {
+        QMessageBox::warning(this, tr("基线帧超出范围"),
+            tr("文件中只有 %1 条匹配帧，无法从第 %2 帧开始取基线！").arg(batchFrames[stream].frameCount()).arg(firstFrame + 1));
         return false;
     }
 
-    // 解析数据
-    QVector<qint16> data = parseCSVLine(lineToRead, rawDataPos, totalBytes, isBigEndian);
+    baselines.resize(patterns.size());
+    QStringList shortStreams;                // 帧数不足、没有生成基线的其他扫描类型
+    for (int i = 0; i < patterns.size(); ++i) {
+        if (batchFrames[i].frameCount() <= firstFrame) {
+            QStringList bytes;
+            for (const QString &byte : patterns[i]) {
+                bytes << byte.toUpper();
+            }
+            shortStreams << bytes.join(' ');
+            continue;
+        }
+        const BaselineResult result = BaselineBuilder::build(batchFrames[i], firstFrame, frameCount, method);
+        baselines[i] = result.baseline;
+        if (i == stream) {
+            baselineReport = result.summary(settings.rxCount)
+                + tr("\n读取 %1 帧耗时 %2 ms").arg(batchFrames[i].frameCount()).arg(readMs);
+        }
+    }
+    if (!shortStreams.isEmpty()) {
+        baselineReport += tr("\n注意：帧头 %1 的匹配帧不足 %2 条，没有生成基线，切换到这些扫描类型时沿用当前基线")
+                              .arg(shortStreams.join(tr("、"))).arg(firstFrame + 1);
+    }
+    baseline = baselines[stream];
+    return true;
+}
 
-    if (data.isEmpty() || data.size() != rxCount * txCount) {
+bool FunctionPage::readArchiveBaseline(const QString &filePath, QVector<qint16> &baseline)
+{
+    FrameArchiveReader reader;
+    if (!reader.open(filePath)) {
+        QMessageBox::warning(this, tr("文件打开失败"), tr("无法打开文件：%1").arg(filePath));
+        return false;
+    }
+    if (reader.rxCount() != ui->rxSpinBox->value() || reader.txCount() != ui->txSpinBox->value()) {
         QMessageBox::warning(this, tr("数据解析失败"),
-            tr("解析的数据量(%1)与期望值(%2)不符！").arg(data.size()).arg(rxCount * txCount));
+            tr("归档的面板尺寸为 RX %1 × TX %2，与当前设置（RX %3 × TX %4）不符！")
+                .arg(reader.rxCount()).arg(reader.txCount())
+                .arg(ui->rxSpinBox->value()).arg(ui->txSpinBox->value()));
         return false;
     }
 
-    // 保存基线数据到成员变量
-    baselineData = data;
-
-    // 保存到 baseLine.txt (以16进制格式保存)
-    QFile outputFile("baseLine.txt");
-    if (outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&outputFile);
-        for (int i = 0; i < data.size(); ++i) {
-            quint16 unsignedValue = static_cast<quint16>(data[i]);
-            out << QString("%1").arg(unsignedValue, 4, 16, QChar('0')).toUpper();
-            if (i < data.size() - 1) {
-                out << "\n";
-            }
+    // 与文本文件相同，从第 firstFrame 帧起取 frameCount 帧计算；只解码到最后一帧所在的块
+    const int firstFrame = ui->baselineStartSpinBox->value() - 1;
+    const int frameCount = ui->baselineFramesSpinBox->value();
+    const BaselineBuilder::Method method = BaselineBuilder::Method(ui->baselineMethodComboBox->currentIndex());
+    if (reader.frameCount() <= firstFrame) {
+        // 帧数不足时退回归档中保存的基线（导出时的基线）
+        if (reader.baseline().size() == reader.frameSize()) {
+            baseline = reader.baseline();
+            baselineReport = tr("归档中只有 %1 帧，使用归档中保存的基线").arg(reader.frameCount());
+            return true;
         }
-        outputFile.close();
+        QMessageBox::warning(this, tr("基线帧超出范围"),
+            tr("归档中只有 %1 帧，无法从第 %2 帧开始取基线！").arg(reader.frameCount()).arg(firstFrame + 1));
+        return false;
     }
 
-    // 以16进制显示在表格中
-    displayDataInTable(data, true);
+    QElapsedTimer readTimer;
+    readTimer.start();
+    const int lastFrame = qMin(reader.frameCount(), firstFrame + frameCount);
+    FrameStore frames;
+    frames.reset(reader.frameSize());
+    for (int i = 0; i < lastFrame; ++i) {
+        const qint16 *frame = reader.frame(i);
+        if (!frame) {
+            QMessageBox::warning(this, tr("归档已损坏"), tr("无法解码归档中的帧数据：%1").arg(filePath));
+            return false;
+        }
+        frames.appendFrame(frame);
+    }
+    const qint64 readMs = readTimer.elapsed();
 
+    const BaselineResult result = BaselineBuilder::build(frames, firstFrame, frameCount, method);
+    baseline = result.baseline;
+    baselineReport = result.summary(reader.rxCount())
+        + tr("\n读取 %1 帧耗时 %2 ms").arg(frames.frameCount()).arg(readMs);
     return true;
 }
 
@@ -1007,109 +1588,94 @@ bool FunctionPage::readTouchData()
         return false;
     }
 
-    // 打开CSV文件
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QMessageBox::warning(this, tr("文件打开失败"), tr("无法打开文件：%1").arg(filePath));
-        return false;
-    }
-
-    QTextStream in(&file);
-
-    // 获取配置参数
-    int autoFilterBits = ui->autoFilterSpinBox->value();
-    int filterStartPos = ui->filterStartLineEdit->text().toInt();
-    int filterMode = ui->filterModeComboBox->currentIndex(); // 0=本行, 1=下一行
-    int rawDataPos = ui->rawDataPosLineEdit->text().toInt();
-    bool isBigEndian = (ui->byteOrderComboBox->currentIndex() == 0); // 0=大端, 1=小端
-    int rxCount = ui->rxSpinBox->value();
-    int txCount = ui->txSpinBox->value();
-    int totalBytes = rxCount * txCount * 2; // 需要读取的8位数据总量
-    int maxRows = ui->maxRowsLineEdit->text().toInt();
-
-    // 构建过滤模式
-    QVector<QString> pattern;
-    pattern.append(ui->hexInput1->text());
-    if (autoFilterBits >= 2) pattern.append(ui->hexInput2->text());
-    if (autoFilterBits >= 3) pattern.append(ui->hexInput3->text());
-    if (autoFilterBits >= 4) pattern.append(ui->hexInput4->text());
-    if (autoFilterBits >= 5) pattern.append(ui->hexInput5->text());
-
-    // 清空之前的触摸数据
-    touchFrames.clear();
-
-    // 读取并匹配行
-    int framesRead = 0;
-    QString currentLine;
-    QString nextLine;
-
-    while (!in.atEnd() && framesRead < maxRows) {
-        currentLine = in.readLine();
-        QStringList data = currentLine.split(',');
-
-        // 移除空白字符
-        for (QString &item : data) {
-            item = item.trimmed();
+    // 停止播放后再替换帧数据
+    stopPlayback();
+    closeFrameWindows();
+
+    // 读取并匹配行（直接写入会话的帧存储）；归档文件直接解码，无需筛选
+    // 配置了多组帧头时一次扫描分流到各自的帧存储，当前扫描类型的帧作为主采集
+    FrameStore &frames = touchFrames();
+    bool isArchive = FrameArchive::isArchive(filePath);
+    QVector<QVector<QString>> patterns = scanPatterns();
+    TouchDataParser::Status status;
+    if (!isArchive) {
+        cancelArchiveDecode();
+    }
+    streamFrames.clear();
+    parseDiagnostics.clear();
+    diagnosticsFilePath = filePath;
+    if (isArchive) {
+        status = readArchiveData(filePath);
+        if (status == TouchDataParser::SizeMismatch) {
+            return false;                    // readArchiveData 已提示原因
         }
-
-        // 匹配过滤模式
-        if (matchFilterPattern(data, filterStartPos, pattern)) {
-            QString lineToRead;
-
-            // 确定要解析的行
-            if (filterMode == 0) {
-                // 读取匹配行本行
-                lineToRead = currentLine;
-            } else {
-                // 读取匹配行的下一行
-                if (!in.atEnd()) {
-                    nextLine = in.readLine();
-                    lineToRead = nextLine;
-                } else {
-                    break; // 没有下一行了
+    } else if (touchPrefetcher.take(filePath, currentParseSettings(), patterns, status, streamFrames,
+                                    parseDiagnostics)) {
+        // 文件和参数与预读时一致，直接使用后台解析的结果
+        PERF_DEBUG("[性能] 使用预读的触摸数据");
+    } else if (patterns.size() > 1) {
+        streamFrames.resize(patterns.size());
+        QVector<FrameStore *> stores;
+        for (FrameStore &store : streamFrames) {
+            stores.append(&store);
+        }
+        status = TouchDataParser::readStreams(filePath, currentParseSettings(), patterns, stores,
+                                             &parseDiagnostics);
+    } else {
+        status = TouchDataParser::readFrames(filePath, currentParseSettings(), frames, &parseDiagnostics);
+    }
+
+    // 只有一种扫描类型时不保留分流结果；多种类型时优先保持当前类型，该类型没有帧则取第一个有帧的类型
+    if (streamFrames.size() == 1) {
+        frames = streamFrames[0];
+        streamFrames.clear();
+    } else if (streamFrames.size() > 1) {
+        currentStream = qBound(0, currentStream, streamFrames.size() - 1);
+        if (streamFrames[currentStream].isEmpty()) {
+            for (int i = 0; i < streamFrames.size(); ++i) {
+                if (!streamFrames[i].isEmpty()) {
+                    currentStream = i;
+                    break;
                 }
             }
-
-            // 解析数据
-            QVector<qint16> frameData = parseCSVLine(lineToRead, rawDataPos, totalBytes, isBigEndian);
-
-            if (frameData.size() == rxCount * txCount) {
-                touchFrames.append(frameData);
-                framesRead++;
-            }
         }
+        frames = streamFrames[currentStream];
     }
+    session->setPrimaryFile(filePath);
+    updateScanTypeList();
+    updateDiagnosticsButton();
 
-    file.close();
-
-    if (touchFrames.isEmpty()) {
-        QMessageBox::warning(this, tr("未找到数据"), tr("在文件中未找到符合筛选条件的数据！"));
+    if (status == TouchDataParser::OpenFailed) {
+        QMessageBox::warning(this, tr("文件打开失败"), tr("无法打开文件：%1").arg(filePath));
         return false;
     }
 
-    // 保存到 touchData.txt (以16进制格式保存所有帧)
-    QFile outputFile("touchData.txt");
-    if (outputFile.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QTextStream out(&outputFile);
-        for (int frame = 0; frame < touchFrames.size(); ++frame) {
-            out << "Frame " << frame << ":\n";
-            const QVector<qint16> &frameData = touchFrames[frame];
-            for (int i = 0; i < frameData.size(); ++i) {
-                quint16 unsignedValue = static_cast<quint16>(frameData[i]);
-                out << QString("%1").arg(unsignedValue, 4, 16, QChar('0')).toUpper();
-                if (i < frameData.size() - 1) {
-                    out << "\n";
-                } else if (frame < touchFrames.size() - 1) {
-                    out << "\n\n";
-                }
-            }
+    if (playbackFrameCount() == 0) {
+        // 有匹配帧头但解析失败的行时说明原因，并打开诊断窗口
+        if (!parseDiagnostics.isEmpty()) {
+            QMessageBox::warning(this, tr("未找到数据"),
+                tr("%1 行匹配帧头但无法解析（%2），请检查 RX/TX 和数据起始位置等参数！")
+                    .arg(parseDiagnostics.totalCount()).arg(parseDiagnostics.summary()));
+            onDiagnosticsButtonClicked();
+        } else {
+            QMessageBox::warning(this, tr("未找到数据"), tr("在文件中未找到符合筛选条件的数据！"));
         }
-        outputFile.close();
+        return false;
+    }
+
+    // 在后台保存 touchData.txt（16进制文本，与数据文件放在同一目录），不阻塞界面
+    // 连续读取时排在上一次导出之后，避免两次导出同时写同一个文件
+    if (!isArchive) {
+        QString dumpPath = QFileInfo(filePath).absoluteDir().filePath("touchData.txt");
+        dumpFuture = FrameExporter::exportInBackground(frames, ui->rxSpinBox->value(), ui->txSpinBox->value(),
+                                                       dumpPath, FrameExporter::HexText, QVector<qint16>(),
+                                                       dumpFuture);
     }
 
     // 重置播放状态
     currentFrame = 0;
-    stopPlayback();
+    invalidateProcessing();
+    restartCommonModeScan();
 
     // 显示第一帧
     displayCurrentFrame();
@@ -1117,52 +1683,163 @@ bool FunctionPage::readTouchData()
     // 更新按钮和进度条状态
     updateFrameButtons();
     updateProgressBar();
+    syncCompareWindow();
 
-    QMessageBox::information(this, tr("读取成功"),
-        tr("成功读取 %1 帧触摸数据！").arg(touchFrames.size()));
+    QString message = tr("成功读取 %1 帧触摸数据！").arg(playbackFrameCount());
+    if (!parseDiagnostics.isEmpty()) {
+        message += tr("\n另有 %1 行无法解析已跳过（%2），可点击\"解析诊断\"查看。")
+                       .arg(parseDiagnostics.totalCount()).arg(parseDiagnostics.summary());
+    }
+    QMessageBox::information(this, tr("读取成功"), message);
 
     return true;
 }
 
+TouchDataParser::Status FunctionPage::readArchiveData(const QString &filePath)
+{
+    QSharedPointer<FrameArchiveReader> reader(new FrameArchiveReader);
+    if (!reader->open(filePath)) {
+        return TouchDataParser::OpenFailed;
+    }
+
+    // 归档自带面板尺寸，与当前设置不同时以归档为准；超出界面范围时不读取，保留当前数据
+    if (reader->rxCount() > ui->rxSpinBox->maximum() || reader->txCount() > ui->txSpinBox->maximum()) {
+        QMessageBox::warning(this, tr("面板尺寸超出范围"),
+            tr("归档的面板尺寸为 RX %1 × TX %2，超出支持的范围（RX 最大 %3，TX 最大 %4）！")
+                .arg(reader->rxCount()).arg(reader->txCount())
+                .arg(ui->rxSpinBox->maximum()).arg(ui->txSpinBox->maximum()));
+        return TouchDataParser::SizeMismatch;
+    }
+    // 先解码第一块确认归档可用
+    if (reader->frameCount() > 0 && !reader->frame(0)) {
+        QMessageBox::warning(this, tr("归档已损坏"), tr("无法解码归档中的帧数据：%1").arg(filePath));
+        return TouchDataParser::SizeMismatch;
+    }
+
+    cancelArchiveDecode();
+    touchFrames() = FrameStore();
+    if (reader->rxCount() != ui->rxSpinBox->value()) {
+        ui->rxSpinBox->setValue(reader->rxCount());
+    }
+    if (reader->txCount() != ui->txSpinBox->value()) {
+        ui->txSpinBox->setValue(reader->txCount());
+    }
+
+    // 尚未读取基线时使用归档中保存的基线
+    if (baselineData.size() != reader->frameSize() && reader->baseline().size() == reader->frameSize()) {
+        baselineData = reader->baseline();
+    }
+    if (reader->frameCount() == 0) {
+        return TouchDataParser::NoMatch;
+    }
+
+    // 播放直接从归档按块解码，不等整段解码；整段在后台解码到帧存储
+    archivePlayback = reader;
+    startArchiveDecode(filePath);
+    return TouchDataParser::Ok;
+}
+
+void FunctionPage::startArchiveDecode(const QString &filePath)
+{
+    archiveCancel.storeRelaxed(0);
+    archiveWatcher = new QFutureWatcher<FrameStore>(this);
+    connect(archiveWatcher, &QFutureWatcherBase::finished, this, [this, filePath]() {
+        QFutureWatcher<FrameStore> *watcher = archiveWatcher;
+        archiveWatcher = nullptr;
+        const FrameStore decoded = watcher->result();
+        watcher->deleteLater();
+        if (decoded.frameCount() != archivePlayback->frameCount()) {
+            // 有块无法解码：能解码的块仍可按块播放，但不提供整段的处理和分析
+            QMessageBox::warning(this, tr("归档已损坏"), tr("无法解码归档中的部分帧数据：%1").arg(filePath));
+            return;
+        }
+
+        // 换成整段的帧存储（内容相同），处理链、共模排查和分析窗口从这里开始可用
+        touchFrames() = decoded;
+        session->setPrimaryFile(filePath);
+        archivePlayback.reset();
+        invalidateProcessing();
+        restartCommonModeScan();
+        displayCurrentFrame();
+        updateFrameButtons();
+        updateProgressBar();
+    });
+
+    // 工作线程只读取归档的映射和块索引，播放用的块缓存只在界面线程访问
+    const QSharedPointer<FrameArchiveReader> reader = archivePlayback;
+    const QAtomicInt *cancel = &archiveCancel;
+    archiveWatcher->setFuture(QtConcurrent::run([reader, cancel]() {
+        FrameStore frames;
+        reader->readAll(frames, cancel);
+        return frames;
+    }));
+}
+
+void FunctionPage::cancelArchiveDecode()
+{
+    if (archiveWatcher) {
+        archiveCancel.storeRelaxed(1);
+        archiveWatcher->waitForFinished();
+        delete archiveWatcher;
+        archiveWatcher = nullptr;
+    }
+    archivePlayback.reset();
+}
+
 void FunctionPage::displayCurrentFrame()
 {
     QElapsedTimer timer;
     timer.start();
 
-    if (touchFrames.isEmpty() || currentFrame < 0 || currentFrame >= touchFrames.size()) {
+    const int frameCount = playbackFrameCount();
+    if (frameCount == 0 || currentFrame < 0 || currentFrame >= frameCount) {
         return;
     }
 
-    const QVector<qint16> &frameData = touchFrames[currentFrame];
+    // 对比窗口跟随同一个帧时钟
+    session->setCurrentFrame(currentFrame);
+
+    // 本帧的临时缓冲全部从帧内存池分配，播放稳定后不再产生堆分配
+    frameArena.reset();
+
+    if (nodeSeriesWindow && nodeSeriesWindow->isVisible()) {
+        nodeSeriesWindow->setCurrentFrame(currentFrame);
+    }
+
+    const qint16 *frameData = playbackFrame(currentFrame);
+    const int frameSize = playbackFrameSize();
+    if (!frameData) {
+        return;                             // 归档中该块无法解码
+    }
 
     PERF_DEBUG("======== 显示第" << (currentFrame + 1) << "帧 ========");
 
     if (currentDataMode == RawData) {
         // 原始数据：以16进制显示
         PERF_DEBUG("[性能] 当前模式: 原始数据 (16进制)");
-        displayDataInTable(frameData, true);
+        displayData(frameData, frameSize, true);
     } else if (currentDataMode == SignalData) {
         // 信号数据：根据选择框决定计算逻辑，以10进制显示
         PERF_DEBUG("[性能] 当前模式: 信号数据 (10进制)");
-        if (baselineData.size() == frameData.size()) {
+        if (baselineData.size() == frameSize && processedSignal.frameCount() == frameCount) {
+            // 已按处理链整段处理好的信号
+            displayData(processedSignal.frame(currentFrame), frameSize, false);
+        } else if (baselineData.size() == frameSize) {
             QElapsedTimer calcTimer;
             calcTimer.start();
-            QVector<qint16> signalData;
+            qint16 *signalData = frameArena.allocate<qint16>(frameSize);
 
             // 获取信号计算模式：0 = base-raw, 1 = raw-base
             int calcMode = ui->signalCalcComboBox->currentIndex();
-
-            for (int i = 0; i < frameData.size(); ++i) {
-                if (calcMode == 0) {
-                    // base-raw: 基线数据 - 原始数据
-                    signalData.append(baselineData[i] - frameData[i]);
-                } else {
-                    // raw-base: 原始数据 - 基线数据
-                    signalData.append(frameData[i] - baselineData[i]);
-                }
+            if (calcMode == 0) {
+                // base-raw: 基线数据 - 原始数据
+                SimdKernels::subtractWrap(baselineData.constData(), frameData, signalData, frameSize);
+            } else {
+                // raw-base: 原始数据 - 基线数据
+                SimdKernels::subtractWrap(frameData, baselineData.constData(), signalData, frameSize);
             }
             PERF_DEBUG("[性能] 计算信号数据耗时:" << calcTimer.elapsed() << "ms");
-            displayDataInTable(signalData, false);
+            displayData(signalData, frameSize, false);
         } else {
             QMessageBox::warning(this, tr("数据不匹配"), tr("基线数据尚未读取或大小不匹配！"));
         }
@@ -1170,7 +1847,7 @@ void FunctionPage::displayCurrentFrame()
         // 基线数据：以16进制显示
         PERF_DEBUG("[性能] 当前模式: 基线数据 (16进制)");
         if (!baselineData.isEmpty()) {
-            displayDataInTable(baselineData, true);
+            displayData(baselineData.constData(), baselineData.size(), true);
         }
     }
 
@@ -1178,13 +1855,225 @@ void FunctionPage::displayCurrentFrame()
     PERF_DEBUG("");
 }
 
+ProcessingConfig FunctionPage::currentProcessingConfig() const
+{
+    static const int kMedianFrames[] = {0, 3, 5};
+
+    ProcessingConfig config;
+    config.commonMode = ui->commonModeComboBox->currentIndex();     // 0=关闭, 1=行, 2=列, 3=行和列
+    config.commonModeLimit = ui->signalThresholdSpinBox->value();
+    config.medianFrames = kMedianFrames[qBound(0, ui->medianComboBox->currentIndex(), 2)];
+    config.iirShift = ui->iirComboBox->currentIndex();              // 0=关闭, n=1/2^n
+    config.spatialSmooth = ui->smoothCheckBox->isChecked();
+    return config;
+}
+
+QString FunctionPage::processingCacheKey(const ProcessingConfig &config) const
+{
+    return QString("%1|%2x%3|%4").arg(ui->signalCalcComboBox->currentIndex())
+        .arg(ui->rxSpinBox->value()).arg(ui->txSpinBox->value()).arg(config.key());
+}
+
+void FunctionPage::onProcessingOptionChanged()
+{
+    saveConfig();
+    updateProcessing();
+    displayCurrentFrame();
+}
+
+void FunctionPage::updateProcessing()
+{
+    // 处理链只作用于信号数据；未缓存的配置在后台整段处理，完成前先显示未处理的信号
+    const ProcessingConfig config = currentProcessingConfig();
+    const FrameStore &frames = touchFrames();
+    if (!config.isEnabled() || frames.isEmpty() || baselineData.size() != frames.frameSize()) {
+        processedSignal = FrameStore();
+        processedKey.clear();
+        ui->processingStatusLabel->clear();
+        return;
+    }
+
+    const QString key = processingCacheKey(config);
+    if (key == processedKey) {
+        return;
+    }
+    if (processedCache.find(key, processedSignal)) {
+        processedKey = key;
+        ui->processingStatusLabel->clear();
+        return;
+    }
+
+    processedSignal = FrameStore();
+    processedKey.clear();
+    ui->processingStatusLabel->setText(tr("处理中..."));
+
+    // 同一时间只处理一个配置，当前任务完成后会重新检查
+    if (!processingWatcher) {
+        startProcessing(config, key);
+    }
+}
+
+void FunctionPage::invalidateProcessing()
+{
+    processingGeneration++;
+    processedCache.clear();
+    processedSignal = FrameStore();
+    processedKey.clear();
+    updateProcessing();
+}
+
+void FunctionPage::startProcessing(const ProcessingConfig &config, const QString &key)
+{
+    const int generation = processingGeneration;
+    processingWatcher = new QFutureWatcher<FrameStore>(this);
+    connect(processingWatcher, &QFutureWatcherBase::finished, this, [this, key, generation]() {
+        QFutureWatcher<FrameStore> *watcher = processingWatcher;
+        processingWatcher = nullptr;
+        if (generation == processingGeneration) {
+            processedCache.insert(key, watcher->result());
+        }
+        watcher->deleteLater();
+
+        // 期间配置可能已改变：命中缓存则直接显示，否则开始处理新配置
+        updateProcessing();
+        if (currentDataMode == SignalData && processedKey == key) {
+            displayCurrentFrame();
+        }
+    });
+
+    // 帧数据和基线隐式共享，工作线程处理期间重新读取数据不影响本次结果
+    const FrameStore frames = touchFrames();
+    const QVector<qint16> baseline = baselineData;
+    const bool baseMinusRaw = (ui->signalCalcComboBox->currentIndex() == 0);
+    const int width = ui->rxSpinBox->value();
+    const int height = ui->txSpinBox->value();
+    processingWatcher->setFuture(QtConcurrent::run([config, frames, baseline, baseMinusRaw, width, height]() {
+        return ProcessingChain::processAll(config, frames, baseline, baseMinusRaw, width, height);
+    }));
+}
+
+FrameStore &FunctionPage::touchFrames()
+{
+    return session->primaryFrames();
+}
+
+int FunctionPage::playbackFrameCount()
+{
+    return archivePlayback ? archivePlayback->frameCount() : touchFrames().frameCount();
+}
+
+int FunctionPage::playbackFrameSize()
+{
+    return archivePlayback ? archivePlayback->frameSize() : touchFrames().frameSize();
+}
+
+const qint16 *FunctionPage::playbackFrame(int index)
+{
+    // 归档只解码当前帧所在的块，跳到任意帧都不用等整段解码
+    return archivePlayback ? archivePlayback->frame(index) : touchFrames().frame(index);
+}
+
+qint64 FunctionPage::evictProcessedSignal(qint64 bytes)
+{
+    // 先丢弃其他配置的处理结果（需要时可重新计算），再换出当前结果中离当前帧较远的块
+    qint64 moved = processedCache.evict(bytes);
+    if (moved < bytes && !processedKey.isEmpty()) {
+        // 缓存中只剩当前结果，它和节点时序窗口与 processedSignal 共享数据块，换出期间先放下
+        processedCache.clear();
+        releaseWindowFrames();
+        moved += processedSignal.spillColdChunks(bytes - moved, currentFrame);
+        processedCache.insert(processedKey, processedSignal);
+        shareWindowFrames();
+    }
+    return moved;
+}
+
+qint64 FunctionPage::evictTouchFrames(qint64 bytes)
+{
+    // 未显示的扫描类型整段都是冷数据，先换出
+    qint64 moved = 0;
+    for (int i = 0; i < streamFrames.size() && moved < bytes; ++i) {
+        if (i != currentStream) {
+            moved += streamFrames[i].spillColdChunks(bytes - moved, currentFrame);
+        }
+    }
+    if (moved < bytes) {
+        // 当前扫描类型和打开的分析窗口与主采集共享数据块，换出期间先放下这些副本，换出后重新共享
+        const bool sharesStream = (currentStream >= 0 && currentStream < streamFrames.size());
+        if (sharesStream) {
+            streamFrames[currentStream] = FrameStore();
+        }
+        releaseWindowFrames();
+        moved += session->spillColdFrames(bytes - moved);
+        if (sharesStream) {
+            streamFrames[currentStream] = touchFrames();
+        }
+        shareWindowFrames();
+    }
+    return moved;
+}
+
+void FunctionPage::closeFrameWindows()
+{
+    // 窗口显示的是之前的数据；关闭后它们不再持有旧的帧存储，重新打开时使用新数据
+    if (nodeSeriesWindow) {
+        nodeSeriesWindow->hide();
+    }
+    if (spectrumWindow) {
+        spectrumWindow->hide();
+    }
+    if (analysisWindow) {
+        analysisWindow->hide();
+    }
+}
+
+void FunctionPage::releaseWindowFrames()
+{
+    if (nodeSeriesWindow) {
+        nodeSeriesWindow->releaseFrames();
+    }
+    if (spectrumWindow) {
+        spectrumWindow->releaseFrames();
+    }
+    if (analysisWindow) {
+        analysisWindow->releaseFrames();
+    }
+}
+
+void FunctionPage::shareWindowFrames()
+{
+    // 只有打开的窗口需要数据，隐藏的窗口重新打开时由页面重新设置
+    const FrameStore &frames = touchFrames();
+    if (nodeSeriesWindow && nodeSeriesWindow->isVisible()) {
+        nodeSeriesWindow->shareFrames(frames, (processedSignal.frameCount() == frames.frameCount())
+                                                  ? processedSignal : FrameStore());
+    }
+    if (spectrumWindow && spectrumWindow->isVisible()) {
+        spectrumWindow->shareFrames(frames);
+    }
+    if (analysisWindow && analysisWindow->isVisible()) {
+        analysisWindow->shareFrames(frames);
+    }
+}
+
+void FunctionPage::updateMemoryStatus()
+{
+    if (MemoryBudget::enforce() > 0) {
+        PERF_DEBUG("[性能] 内存超出预算，已换出" << MemoryBudget::spilledBytes() / (1024 * 1024) << "MB");
+    }
+    ui->memoryUsageLabel->setText(MemoryBudget::usageText());
+    ui->memoryUsageLabel->setToolTip(MemoryBudget::usageDetails());
+}
+
 void FunctionPage::updateFrameButtons()
 {
-    bool hasFrames = !touchFrames.isEmpty();
+    bool hasFrames = playbackFrameCount() > 0;
+    // 频谱和插件分析整段数据，归档整段解码完成后才可用
+    bool hasStore = !touchFrames().isEmpty();
 
     // 只在状态改变时才更新，减少不必要的 UI 刷新
     bool prevEnabled = hasFrames && currentFrame > 0;
-    bool nextEnabled = hasFrames && currentFrame < touchFrames.size() - 1;
+    bool nextEnabled = hasFrames && currentFrame < playbackFrameCount() - 1;
 
     if (ui->prevFrameButton->isEnabled() != prevEnabled) {
         ui->prevFrameButton->setEnabled(prevEnabled);
@@ -1198,6 +2087,17 @@ void FunctionPage::updateFrameButtons()
     if (ui->replayButton->isEnabled() != hasFrames) {
         ui->replayButton->setEnabled(hasFrames);
     }
+
+    bool hasTiming = hasStore && (touchFrames().hasTimestamps() || touchFrames().hasSequences());
+    if (ui->timingReportButton->isEnabled() != hasTiming) {
+        ui->timingReportButton->setEnabled(hasTiming);
+    }
+    if (ui->spectrumButton->isEnabled() != hasStore) {
+        ui->spectrumButton->setEnabled(hasStore);
+    }
+    if (ui->pluginButton->isEnabled() != hasStore) {
+        ui->pluginButton->setEnabled(hasStore);
+    }
 }
 
 void FunctionPage::updateProgressBar()
@@ -1205,24 +2105,21 @@ void FunctionPage::updateProgressBar()
     QElapsedTimer timer;
     timer.start();
 
-    static int lastCurrentValue = -1;
-    static int lastMaxValue = -1;
-
-    if (touchFrames.isEmpty()) {
+    if (playbackFrameCount() == 0) {
         // 没有数据时显示 0 / 0
-        if (lastCurrentValue != 0 || lastMaxValue != 0) {
+        if (shownFrameValue != 0 || shownFrameMax != 0) {
             ui->frameInfoLabel->setText("0 / 0");
             ui->progressBarFill->setMaximumWidth(0);
-            lastCurrentValue = 0;
-            lastMaxValue = 0;
+            shownFrameValue = 0;
+            shownFrameMax = 0;
         }
     } else {
         // 有数据时显示当前帧 / 总帧数
-        int maxValue = touchFrames.size();
+        int maxValue = playbackFrameCount();
         int currentValue = currentFrame + 1; // +1 因为显示从1开始
 
         // 只在值改变时才更新
-        if (currentValue != lastCurrentValue || maxValue != lastMaxValue) {
+        if (currentValue != shownFrameValue || maxValue != shownFrameMax) {
             // 更新文本
             ui->frameInfoLabel->setText(QString("%1 / %2").arg(currentValue).arg(maxValue));
             // 更新自定义进度条宽度（通过百分比）
@@ -1233,8 +2130,8 @@ void FunctionPage::updateProgressBar()
                 ui->progressBarFill->setMinimumWidth(fillWidth);
                 ui->progressBarFill->setMaximumWidth(fillWidth);
             }
-            lastCurrentValue = currentValue;
-            lastMaxValue = maxValue;
+            shownFrameValue = currentValue;
+            shownFrameMax = maxValue;
         }
     }
     PERF_DEBUG("[性能] updateProgressBar 总耗时:" << timer.elapsed() << "ms");
@@ -1242,10 +2139,10 @@ void FunctionPage::updateProgressBar()
 
 void FunctionPage::startPlayback()
 {
-    if (!touchFrames.isEmpty()) {
+    if (playbackFrameCount() > 0) {
         isPlaying = true;
         ui->playPauseButton->setText("暂停");
-        playTimer->start();
+        restartPlayTimer();
     }
 }
 
@@ -1254,6 +2151,28 @@ void FunctionPage::stopPlayback()
     isPlaying = false;
     ui->playPauseButton->setText("播放");
     playTimer->stop();
+
+    // 停止时立即显示最后到达的帧，而不是等下一个刷新周期
+    uiScheduler->flushNow();
+}
+
+void FunctionPage::requestPlaybackUpdate()
+{
+    // 只记录需要刷新，实际更新在下一个屏幕刷新周期统一执行
+    uiScheduler->request(UiUpdateScheduler::AllParts);
+}
+
+void FunctionPage::onUiFlush(UiUpdateScheduler::Parts parts)
+{
+    if (parts & UiUpdateScheduler::FramePart) {
+        displayCurrentFrame();
+    }
+    if (parts & UiUpdateScheduler::ButtonsPart) {
+        updateFrameButtons();
+    }
+    if (parts & UiUpdateScheduler::ProgressPart) {
+        updateProgressBar();
+    }
 }
 
 void FunctionPage::onTouchReadButtonClicked()
@@ -1265,7 +2184,7 @@ void FunctionPage::onTouchReadButtonClicked()
 
 void FunctionPage::onPlayPauseClicked()
 {
-    if (touchFrames.isEmpty()) {
+    if (playbackFrameCount() == 0) {
         return;
     }
 
@@ -1278,7 +2197,7 @@ void FunctionPage::onPlayPauseClicked()
 
 void FunctionPage::onReplayClicked()
 {
-    if (touchFrames.isEmpty()) {
+    if (playbackFrameCount() == 0) {
         return;
     }
 
@@ -1287,9 +2206,7 @@ void FunctionPage::onReplayClicked()
 
     // 从第一帧开始播放
     currentFrame = 0;
-    displayCurrentFrame();
-    updateFrameButtons();
-    updateProgressBar();
+    requestPlaybackUpdate();
     startPlayback();
 }
 
@@ -1298,21 +2215,12 @@ void FunctionPage::onPrevFrameClicked()
     QElapsedTimer timer;
     timer.start();
 
-    if (touchFrames.isEmpty() || currentFrame <= 0) {
+    if (playbackFrameCount() == 0 || currentFrame <= 0) {
         return;
     }
 
     currentFrame--;
-
-    QElapsedTimer btnTimer;
-    btnTimer.start();
-    updateFrameButtons();
-
-    QElapsedTimer progTimer;
-    progTimer.start();
-    updateProgressBar();
-
-    displayCurrentFrame();
+    requestPlaybackUpdate();
 
     PERF_DEBUG("[按钮] 上一帧按钮点击处理总耗时:" << timer.elapsed() << "ms\n");
 }
@@ -1322,21 +2230,12 @@ void FunctionPage::onNextFrameClicked()
     QElapsedTimer timer;
     timer.start();
 
-    if (touchFrames.isEmpty() || currentFrame >= touchFrames.size() - 1) {
+    if (currentFrame >= playbackFrameCount() - 1) {
         return;
     }
 
     currentFrame++;
-
-    QElapsedTimer btnTimer;
-    btnTimer.start();
-    updateFrameButtons();
-
-    QElapsedTimer progTimer;
-    progTimer.start();
-    updateProgressBar();
-
-    displayCurrentFrame();
+    requestPlaybackUpdate();
 
     PERF_DEBUG("[按钮] 下一帧按钮点击处理总耗时:" << timer.elapsed() << "ms\n");
 }
@@ -1346,24 +2245,407 @@ void FunctionPage::onPlayTimerTimeout()
     QElapsedTimer timer;
     timer.start();
 
-    if (touchFrames.isEmpty()) {
+    if (playbackFrameCount() == 0) {
         stopPlayback();
         return;
     }
 
-    // 移动到下一帧
-    currentFrame++;
+    // 移动到下一帧；按采集时间播放时跳到当前采集时刻对应的帧（倍速较高时跳过中间帧）
+    const bool timed = isTimedPlayback();
+    int target = timed ? FrameTiming::frameAtTime(touchFrames(), playbackCaptureTime()) : currentFrame + 1;
+    if (target > currentFrame) {
+        currentFrame = target;
+    } else {
+        // 长空档被截断后提前触发：推进一帧并以该帧重新对齐时钟
+        currentFrame++;
+        if (timed && currentFrame < touchFrames().frameCount()) {
+            syncPlayClock();
+        }
+    }
 
-    // 如果到达最后一帧，停止播放
-    if (currentFrame >= touchFrames.size()) {
-        currentFrame = touchFrames.size() - 1;
+    // 界面更新按刷新率合并，定时器间隔小于刷新周期时中间帧只推进不绘制
+    requestPlaybackUpdate();
+
+    // 如果到达最后一帧，停止播放（停止时会立即刷新界面）
+    if (currentFrame >= playbackFrameCount()) {
+        currentFrame = playbackFrameCount() - 1;
         stopPlayback();
+    } else if (timed) {
+        scheduleTimedFrame();
     }
 
+    PERF_DEBUG("[播放] 定时器触发处理总耗时:" << timer.elapsed() << "ms (播放速度设置:" << playTimer->interval() << "ms)\n");
+}
+
+void FunctionPage::onCompareButtonClicked()
+{
+    if (session->isLoading()) {
+        QMessageBox::information(this, tr("正在加载"), tr("对比文件仍在加载中，请稍候！"));
+        return;
+    }
+
+    QStringList fileNames = QFileDialog::getOpenFileNames(
+        this,
+        tr("选择对比数据文件"),
+        "",
+        tr("数据文件 (*.csv *.rgdf);;CSV文件 (*.csv);;RGD归档 (*.rgdf);;所有文件 (*.*)")
+    );
+
+    if (!fileNames.isEmpty()) {
+        // 每个文件在独立的工作线程中解析，使用与主数据相同的解析参数
+        session->clearComparisons();
+        session->loadComparisons(fileNames, currentParseSettings());
+    }
+
+    if (session->captureCount() <= 1) {
+        return;
+    }
+
+    if (!compareWindow) {
+        compareWindow = new CompareWindow(session, this);
+    }
+    compareWindow->rebuildViews();
+    syncCompareWindow();
+    compareWindow->show();
+    compareWindow->raise();
+    compareWindow->activateWindow();
+}
+
+void FunctionPage::onComparisonLoadingFinished()
+{
+    QStringList failedFiles;
+    for (int i = 1; i < session->captureCount(); ++i) {
+        const Capture *capture = session->capture(i);
+        if (!capture->loaded) {
+            failedFiles << capture->filePath;
+        }
+    }
+
+    if (!failedFiles.isEmpty()) {
+        QMessageBox::warning(this, tr("对比文件读取失败"),
+            tr("以下文件未找到符合筛选条件的数据：\n%1").arg(failedFiles.join("\n")));
+    }
+}
+
+void FunctionPage::syncCompareWindow()
+{
+    if (compareWindow) {
+        compareWindow->setPanelLayout(ui->rxSpinBox->value(), ui->txSpinBox->value(),
+                                      ui->reverseRxCheckBox->isChecked());
+    }
+}
+
+void FunctionPage::onExportButtonClicked()
+{
+    if (touchFrames().isEmpty()) {
+        QMessageBox::warning(this, tr("没有数据"), tr("请先读取触摸数据！"));
+        return;
+    }
+
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName(
+        this,
+        tr("导出触摸数据"),
+        QFileInfo(ui->touchFileLineEdit->text()).absoluteDir().filePath("touchData.rgdf"),
+        FrameExporter::fileDialogFilter(),
+        &selectedFilter
+    );
+
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    FrameExporter::Format format = FrameExporter::formatForFilter(selectedFilter, fileName);
+    auto *watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, watcher, fileName]() {
+        ui->exportButton->setEnabled(true);
+        if (watcher->result()) {
+            QMessageBox::information(this, tr("导出成功"), tr("数据已导出到：%1").arg(fileName));
+        } else {
+            QMessageBox::warning(this, tr("导出失败"), tr("无法写入文件：%1").arg(fileName));
+        }
+        watcher->deleteLater();
+    });
+
+    ui->exportButton->setEnabled(false);
+    watcher->setFuture(FrameExporter::exportInBackground(touchFrames(), ui->rxSpinBox->value(),
+                                                         ui->txSpinBox->value(), fileName, format,
+                                                         baselineData));
+}
+
+void FunctionPage::onHeatmapButtonToggled(bool checked)
+{
+    // 热力图与表格共用数据区，切换后按当前模式重新显示
+    ui->dataTable->setVisible(!checked);
+    heatmapView->setVisible(checked);
+    ui->overlayButton->setEnabled(checked);
+    if (!checked) {
+        heatmapView->clearFrame();
+    }
+    displayCurrentFrame();
+}
+
+void FunctionPage::onOverlayButtonToggled(bool checked)
+{
+    Q_UNUSED(checked);
+    displayCurrentFrame();
+}
+
+void FunctionPage::updateScanTypeList()
+{
+    // 只有一种扫描类型时隐藏选择框
+    ui->scanTypeComboBox->blockSignals(true);
+    ui->scanTypeComboBox->clear();
+    if (streamFrames.size() > 1) {
+        const QVector<QVector<QString>> patterns = scanPatterns();
+        for (int i = 0; i < streamFrames.size(); ++i) {
+            QStringList bytes;
+            if (i < patterns.size()) {
+                for (const QString &byte : patterns[i]) {
+                    bytes << byte.toUpper();
+                }
+            }
+            ui->scanTypeComboBox->addItem(tr("帧头 %1 (%2帧)").arg(bytes.join(' ')).arg(streamFrames[i].frameCount()));
+        }
+        ui->scanTypeComboBox->setCurrentIndex(currentStream);
+    }
+    ui->scanTypeComboBox->setVisible(streamFrames.size() > 1);
+    ui->scanTypeComboBox->blockSignals(false);
+}
+
+void FunctionPage::selectScanStream(int index)
+{
+    if (index < 0 || index >= streamFrames.size() || index == currentStream) {
+        return;
+    }
+
+    stopPlayback();
+    closeFrameWindows();
+    currentStream = index;
+
+    // FrameStore 隐式共享，切换只复制引用
+    touchFrames() = streamFrames[index];
+    if (index < streamBaselines.size() && !streamBaselines[index].isEmpty()) {
+        baselineData = streamBaselines[index];
+    }
+    invalidateProcessing();
+    restartCommonModeScan();
+
+    currentFrame = qBound(0, currentFrame, qMax(0, touchFrames().frameCount() - 1));
     displayCurrentFrame();
     updateFrameButtons();
-    PERF_DEBUG("[性能] updateFrameButtons 耗时:" << timer.elapsed() << "ms");
     updateProgressBar();
+    syncCompareWindow();
+}
 
-    PERF_DEBUG("[播放] 定时器触发处理总耗时:" << timer.elapsed() << "ms (播放速度设置:" << playTimer->interval() << "ms)\n");
+void FunctionPage::onScanTypeChanged(int index)
+{
+    selectScanStream(index);
+}
+
+void FunctionPage::onTimingReportClicked()
+{
+    const FrameStore &frames = touchFrames();
+    if (frames.isEmpty() || (!frames.hasTimestamps() && !frames.hasSequences())) {
+        QMessageBox::warning(this, tr("没有时序信息"), tr("请先设置时间戳或帧序号位置并重新读取触摸数据！"));
+        return;
+    }
+
+    FrameTimingReport report = FrameTiming::analyze(frames);
+    QStringList lines;
+    lines << tr("共 %1 帧").arg(report.frameCount);
+
+    if (report.hasSequences) {
+        if (report.sequenceGaps == 0 && report.repeatedFrames == 0) {
+            lines << tr("帧序号连续，没有丢帧");
+        } else {
+            lines << tr("帧序号跳号 %1 处，共丢失 %2 帧；重复或倒退 %3 处")
+                         .arg(report.sequenceGaps).arg(report.droppedFrames).arg(report.repeatedFrames);
+        }
+        if (!report.gapFrames.isEmpty()) {
+            QStringList positions;
+            for (int index : report.gapFrames) {
+                positions << QString::number(index + 1);
+            }
+            QString more = report.sequenceGaps > report.gapFrames.size() ? tr(" 等") : QString();
+            lines << tr("跳号位置（帧）: %1%2").arg(positions.join(", ")).arg(more);
+        }
+    }
+
+    if (report.hasTimestamps && report.frameCount > 1) {
+        lines << tr("上报间隔: 平均 %1 ms（约 %2 Hz），标准差 %3 ms")
+                     .arg(report.meanIntervalUs / 1000.0, 0, 'f', 3)
+                     .arg(report.reportRateHz, 0, 'f', 1)
+                     .arg(report.stdDevIntervalUs / 1000.0, 0, 'f', 3);
+        lines << tr("最小 %1 ms，最大 %2 ms，超过平均间隔 1.5 倍 %3 次")
+                     .arg(report.minIntervalUs / 1000.0, 0, 'f', 3)
+                     .arg(report.maxIntervalUs / 1000.0, 0, 'f', 3)
+                     .arg(report.lateFrames);
+    }
+
+    if (report.sequenceGaps > 0) {
+        QMessageBox::warning(this, tr("时序报告"), lines.join('\n'));
+    } else {
+        QMessageBox::information(this, tr("时序报告"), lines.join('\n'));
+    }
+}
+
+void FunctionPage::onSpectrumButtonClicked()
+{
+    const FrameStore &frames = touchFrames();
+    if (frames.isEmpty()) {
+        QMessageBox::warning(this, tr("没有数据"), tr("请先读取触摸数据！"));
+        return;
+    }
+    if (frames.frameSize() != ui->rxSpinBox->value() * ui->txSpinBox->value()) {
+        QMessageBox::warning(this, tr("参数错误"), tr("RX × TX 与数据的节点数不一致！"));
+        return;
+    }
+
+    // 有时间戳时按实际上报率换算频率，否则沿用窗口中上次填写的帧率
+    double sampleRate = 0.0;
+    if (frames.hasTimestamps()) {
+        sampleRate = FrameTiming::analyze(frames).reportRateHz;
+    }
+
+    if (!spectrumWindow) {
+        spectrumWindow = new NoiseSpectrumWindow(this);
+    }
+    spectrumWindow->setSource(frames, currentFrame, sampleRate, ui->rxSpinBox->value(), ui->txSpinBox->value(),
+                              ui->reverseRxCheckBox->isChecked());
+    spectrumWindow->show();
+    spectrumWindow->raise();
+    spectrumWindow->activateWindow();
+}
+
+void FunctionPage::onPluginButtonClicked()
+{
+    const FrameStore &frames = touchFrames();
+    if (frames.isEmpty()) {
+        QMessageBox::warning(this, tr("没有数据"), tr("请先读取触摸数据！"));
+        return;
+    }
+
+    if (!analysisWindow) {
+        analysisWindow = new AnalysisPluginWindow(this);
+        connect(analysisWindow, &AnalysisPluginWindow::frameRequested, this, &FunctionPage::onFrameRequested);
+    }
+    analysisWindow->setSource(frames, baselineData, ui->signalCalcComboBox->currentIndex(),
+                              ui->rxSpinBox->value(), ui->txSpinBox->value(), collectParameters());
+    analysisWindow->show();
+    analysisWindow->raise();
+    analysisWindow->activateWindow();
+}
+
+void FunctionPage::updateDiagnosticsButton()
+{
+    ui->diagnosticsButton->setEnabled(!parseDiagnostics.isEmpty());
+    ui->diagnosticsButton->setToolTip(parseDiagnostics.isEmpty()
+        ? tr("上次读取没有被丢弃的行")
+        : tr("上次读取有 %1 行被丢弃：%2").arg(parseDiagnostics.totalCount()).arg(parseDiagnostics.summary()));
+}
+
+void FunctionPage::onDiagnosticsButtonClicked()
+{
+    if (parseDiagnostics.isEmpty()) {
+        return;
+    }
+
+    // 扫描类型以帧头字节命名，与选择框一致
+    QStringList streamNames;
+    for (const QVector<QString> &pattern : scanPatterns()) {
+        QStringList bytes;
+        for (const QString &byte : pattern) {
+            bytes << byte.toUpper();
+        }
+        streamNames << tr("帧头 %1").arg(bytes.join(' '));
+    }
+
+    if (!diagnosticsWindow) {
+        diagnosticsWindow = new ParseDiagnosticsWindow(this);
+        connect(diagnosticsWindow, &ParseDiagnosticsWindow::frameRequested,
+                this, &FunctionPage::onDiagnosticFrameRequested);
+    }
+    diagnosticsWindow->setDiagnostics(diagnosticsFilePath, parseDiagnostics, streamNames);
+    diagnosticsWindow->show();
+    diagnosticsWindow->raise();
+    diagnosticsWindow->activateWindow();
+}
+
+void FunctionPage::showNodeSeries(int column, int row)
+{
+    const FrameStore &frames = touchFrames();
+    if (frames.isEmpty() || frames.frameSize() != ui->rxSpinBox->value() * ui->txSpinBox->value()) {
+        return;
+    }
+
+    // 视图中的格子（概览时每格 viewFactor×viewFactor 个节点，取左上角的节点）换算回节点坐标
+    const QRect base = activeRoi();
+    const int rx = qMin(base.left() + column * viewFactor, base.right());
+    const int tx = qMin(base.top() + row * viewFactor, base.bottom());
+
+    if (!nodeSeriesWindow) {
+        nodeSeriesWindow = new NodeSeriesWindow(this);
+        connect(nodeSeriesWindow, &NodeSeriesWindow::frameRequested, this, &FunctionPage::onFrameRequested);
+    }
+    const FrameStore signal = (processedSignal.frameCount() == frames.frameCount()) ? processedSignal : FrameStore();
+    nodeSeriesWindow->setSource(frames, signal, baselineData, ui->signalCalcComboBox->currentIndex(),
+                                ui->rxSpinBox->value(), ui->txSpinBox->value());
+    nodeSeriesWindow->setCurrentFrame(currentFrame);
+    nodeSeriesWindow->showNode(rx, tx, currentDataMode == SignalData);
+    nodeSeriesWindow->show();
+    nodeSeriesWindow->raise();
+}
+
+void FunctionPage::onTableNodeClicked(const QModelIndex &index)
+{
+    // 时序窗口已打开时单击即切换节点，否则需要双击打开
+    if (nodeSeriesWindow && nodeSeriesWindow->isVisible()) {
+        onTableNodeDoubleClicked(index);
+    }
+}
+
+void FunctionPage::onTableNodeDoubleClicked(const QModelIndex &index)
+{
+    if (!index.isValid()) {
+        return;
+    }
+    const int columns = tableModel->columnCount();
+    const int column = ui->reverseRxCheckBox->isChecked() ? columns - 1 - index.column() : index.column();
+    showNodeSeries(column, index.row());
+}
+
+void FunctionPage::onHeatmapNodeClicked(int rx, int tx)
+{
+    showNodeSeries(rx, tx);
+}
+
+void FunctionPage::onFrameRequested(int frame)
+{
+    if (playbackFrameCount() == 0) {
+        return;
+    }
+    stopPlayback();
+    currentFrame = qBound(0, frame, playbackFrameCount() - 1);
+    displayCurrentFrame();
+    updateFrameButtons();
+    updateProgressBar();
+}
+
+void FunctionPage::onDiagnosticFrameRequested(int stream, int frame)
+{
+    // 出错行属于另一种扫描类型时先切换过去（选择框的信号会完成切换）
+    if (streamFrames.size() > 1 && stream != currentStream && stream < streamFrames.size()) {
+        ui->scanTypeComboBox->setCurrentIndex(stream);
+    }
+    if (playbackFrameCount() == 0) {
+        return;
+    }
+
+    // frame 是出错行之后的第一帧
+    stopPlayback();
+    currentFrame = qBound(0, frame, playbackFrameCount() - 1);
+    displayCurrentFrame();
+    updateFrameButtons();
+    updateProgressBar();
 }
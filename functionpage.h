@@ -2,8 +2,23 @@
 #define FUNCTIONPAGE_H
 
 #include <QWidget>
+#include <QAtomicInt>
+#include <QSharedPointer>
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
 #include <QVector>
+#include <QJsonObject>
+#include <QRect>
+#include "touchdataparser.h"
+#include "peakdetector.h"
+#include "uiupdatescheduler.h"
+#include "framearena.h"
+#include "framestore.h"
+#include "processingchain.h"
+#include "linereducer.h"
+#include "touchfileprefetcher.h"
+#include "parsediagnostics.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -11,9 +26,24 @@ class FunctionPage;
 }
 QT_END_NAMESPACE
 
+class CaptureSession;
+class FrameArchiveReader;
+class CompareWindow;
+class NoiseSpectrumWindow;
+class ParseDiagnosticsWindow;
+class NodeSeriesWindow;
+class AnalysisPluginWindow;
+class HeatmapView;
+class ConfigService;
+class FrameTableModel;
+class LineProfileStrip;
+class CommonModeScanner;
+
 class FunctionPage : public QWidget
 {
     Q_OBJECT
+    friend class PlaybackBenchmark;          // 端到端基准直接驱动读取和播放路径
+    friend class PlaybackSelfCheck;          // 显示路径自检注入帧并检查显示结果
 
 public:
     explicit FunctionPage(QWidget *parent = nullptr);
@@ -28,6 +58,9 @@ public:
 signals:
     void backToMainPage();
 
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     void onBackButtonClicked();
     void onRxCountChanged(int value);
@@ -49,35 +82,155 @@ private slots:
     void onBaselineReadButtonClicked();
     void onTouchReadButtonClicked();
     void onPlayTimerTimeout();
+    void onCompareButtonClicked();
+    void onComparisonLoadingFinished();
+    void onExportButtonClicked();
+    void onHeatmapButtonToggled(bool checked);
+    void onOverlayButtonToggled(bool checked);
+    void onUiFlush(UiUpdateScheduler::Parts parts);
+    void onPresetActivated(int index);
+    void onScanTypeChanged(int index);
+    void onSavePresetClicked();
+    void onDeletePresetClicked();
+    void onPlayClockChanged(int index);
+    void onTimingReportClicked();
+    void onSpectrumButtonClicked();
+    void onDiagnosticsButtonClicked();
+    void onDiagnosticFrameRequested(int stream, int frame);
+    void onOverviewChanged();
+    void onRoiButtonClicked();
+    void onHeatmapRegionSelected(const QRect &cells);
+    void onTableNodeClicked(const QModelIndex &index);
+    void onTableNodeDoubleClicked(const QModelIndex &index);
+    void onHeatmapNodeClicked(int rx, int tx);
+    void onFrameRequested(int frame);
+    void onPluginButtonClicked();
+    void onProcessingOptionChanged();
+    void onLineStatsChanged(int index);
+    void onWorstFrameActivated(int index);
+    void onCommonModeScanProgress();
 
 private:
     void initializeTable();
     void updateTableSize();
+    void revalidateData();
     void loadConfig();
     void saveConfig();
+    void applyParameters(const QJsonObject &params);
+    QJsonObject collectParameters() const;
+    void refreshPresetList();
     void updateDataModeButtons();
     bool readBaselineData();
+    bool readTextBaseline(const QString &filePath, QVector<qint16> &baseline,
+                          QVector<QVector<qint16>> &baselines);                 // 失败时已提示原因
+    bool readArchiveBaseline(const QString &filePath, QVector<qint16> &baseline);   // 失败时已提示原因
     bool readTouchData();
-    QVector<qint16> parseCSVLine(const QString &line, int startPos, int count, bool isBigEndian);
-    bool matchFilterPattern(const QStringList &data, int startPos, const QVector<QString> &pattern);
-    void displayDataInTable(const QVector<qint16> &data, bool asHex);
-    void applySignalDataColors(const QVector<qint16> &data, int rxCount, int txCount);
+    TouchDataParser::Status readArchiveData(const QString &filePath);   // 尺寸超出范围或数据损坏时已提示，返回 SizeMismatch
+    void startArchiveDecode(const QString &filePath);
+    void cancelArchiveDecode();
+    ParseSettings currentParseSettings() const;
+    QVector<QVector<QString>> scanPatterns() const;
+    void updateScanTypeList();
+    void selectScanStream(int index);
+    void displayData(const qint16 *data, int count, bool asHex);
+    void displayDataInTable(const qint16 *data, int rxCount, int txCount, bool asHex, bool withPeaks);
+    void displayDataInHeatmap(const qint16 *data, int rxCount, int txCount, bool asHex, bool withPeaks);
+    void updateLineProfiles(const qint16 *data, int rxCount, int txCount, bool asHex);
+    QRect activeRoi() const;
+    void setRoi(const QRect &region);
+    int overviewFactor(int rxCount, int txCount) const;
+    void updateTableLayout();
+    void showNodeSeries(int column, int row);
+    void restartCommonModeScan();
+    void startTouchPrefetch();
+    void updateDiagnosticsButton();
     void displayCurrentFrame();
+    ProcessingConfig currentProcessingConfig() const;
+    QString processingCacheKey(const ProcessingConfig &config) const;
+    void updateProcessing();
+    void invalidateProcessing();
+    void startProcessing(const ProcessingConfig &config, const QString &key);
     void updateFrameButtons();
     void updateProgressBar();
+    void requestPlaybackUpdate();
     void updatePlaySpeed();
+    double playRate() const;
+    bool isTimedPlayback() const;
+    void restartPlayTimer();
+    void syncPlayClock();
+    qint64 playbackCaptureTime() const;
+    void scheduleTimedFrame();
     void startPlayback();
     void stopPlayback();
+    void syncCompareWindow();
+    FrameStore &touchFrames();
+    // 播放用的帧：归档整段解码完成前来自归档的块缓存，否则来自 touchFrames()
+    int playbackFrameCount();
+    int playbackFrameSize();
+    const qint16 *playbackFrame(int index);
+    qint64 evictProcessedSignal(qint64 bytes);
+    qint64 evictTouchFrames(qint64 bytes);
+    void closeFrameWindows();
+    void releaseWindowFrames();
+    void shareWindowFrames();
+    void updateMemoryStatus();
 
     Ui::FunctionPage *ui;
+    ConfigService *config;                   // config.json（内存模型 + 延迟后台写盘）
+    FrameTableModel *tableModel;             // 数据表格模型
     bool isPlaying;
     DataMode currentDataMode;
 
     // 数据存储
     QVector<qint16> baselineData;           // 基线数据
-    QVector<QVector<qint16>> touchFrames;   // 触摸数据帧
+    CaptureSession *session;                 // 采集会话（采集 0 为触摸数据帧）
+    QVector<FrameStore> streamFrames;        // 多种扫描类型分流后的帧（只有一种类型时为空）
+    QVector<QVector<qint16>> streamBaselines;// 各扫描类型的基线
+    QString baselineReport;                  // 上次读取基线的质量评估
+    int currentStream;                       // 当前显示的扫描类型
     int currentFrame;                        // 当前帧索引
     QTimer *playTimer;                       // 播放定时器
+    QElapsedTimer playClock;                 // 按采集时间播放时的墙钟
+    qint64 playClockOriginUs;                // playClock 起点对应的采集时间（微秒）
+    CompareWindow *compareWindow;            // 多文件对比窗口（首次使用时创建）
+    NoiseSpectrumWindow *spectrumWindow;     // 噪声频谱窗口（首次使用时创建）
+    ParseDiagnosticsWindow *diagnosticsWindow;  // 解析诊断窗口（首次使用时创建）
+    NodeSeriesWindow *nodeSeriesWindow;      // 节点时序窗口（首次使用时创建）
+    AnalysisPluginWindow *analysisWindow;    // 分析插件窗口（首次使用时创建）
+    HeatmapView *heatmapView;                // 热力图视图（与表格二选一显示）
+    PeakDetector peakDetector;               // 信号峰值检测（缓冲跨帧复用）
+    QRect roiRect;                           // 只显示和分析的区域（节点坐标，空表示整个面板）
+    int viewFactor;                          // 当前显示的概览合并倍数（1 表示逐节点）
+    QVector<quint8> pooledStates;            // 概览时合并后的格子状态
+    QVector<QPoint> pooledPeaks;             // 概览时峰值所在的格子
+    FrameArena frameArena;                   // 每帧显示用的临时缓冲（每帧开始时回收）
+    UiUpdateScheduler *uiScheduler;          // 播放相关界面更新按刷新率合并
+    LineReducer lineReducer;                 // 当前帧的行/列统计（缓冲跨帧复用）
+    LineProfileStrip *rowStrip;              // 网格右侧的每行统计
+    LineProfileStrip *columnStrip;           // 网格下方的每列统计
+    CommonModeScanner *commonModeScanner;    // 整段采集的共模最差帧排查（后台分批）
+    TouchFilePrefetcher touchPrefetcher;     // 上次使用的触摸数据文件的后台预读
+    QFuture<bool> dumpFuture;                // 最近一次后台写出 touchData.txt / baseLine.txt（后一次排在前一次之后）
+    ParseDiagnostics parseDiagnostics;       // 上次读取触摸数据时被丢弃的行
+    QString diagnosticsFilePath;             // parseDiagnostics 对应的文件
+    int shownFrameValue;                     // 进度条当前显示的帧号（-1 表示未显示）
+    int shownFrameMax;                       // 进度条当前显示的总帧数
+
+    // 信号处理链：整段信号按当前配置在后台处理一次，结果按配置缓存
+    ProcessedFrameCache processedCache;
+    FrameStore processedSignal;              // 当前配置的处理结果（未就绪时为空）
+    QString processedKey;                    // processedSignal 对应的配置
+    QFutureWatcher<FrameStore> *processingWatcher;  // 正在进行的后台处理（空闲时为 nullptr）
+    int processingGeneration;                // 数据或基线变化时递增，丢弃过期的处理结果
+
+    // 归档：打开后立即按块解码播放，整段在后台解码到帧存储，完成后才用于处理链、共模排查和分析窗口
+    QSharedPointer<FrameArchiveReader> archivePlayback;  // 整段解码完成前的播放来源（否则为空）
+    QFutureWatcher<FrameStore> *archiveWatcher;  // 正在进行的后台整段解码（空闲时为 nullptr）
+    QAtomicInt archiveCancel;                // 置位后后台解码跳过剩下的块
+
+    // 内存预算：超出上限时把冷数据换出到临时文件
+    QTimer *memoryTimer;                     // 定期检查用量并刷新状态
+    QVector<int> memoryConsumers;            // 在 MemoryBudget 中登记的使用者
 };
 
 #endif // FUNCTIONPAGE_H
@@ -0,0 +1,105 @@
+#include "heatmaprenderer.h"
+#include "simdkernels.h"
+#include <algorithm>
+
+namespace {
+
+QRgb lerpColor(QRgb a, QRgb b, double t)
+{
+    return qRgb(int(qRed(a) + (qRed(b) - qRed(a)) * t),
+                int(qGreen(a) + (qGreen(b) - qGreen(a)) * t),
+                int(qBlue(a) + (qBlue(b) - qBlue(a)) * t));
+}
+
+// 256 级调色板（只构建一次），查找表从这里取色
+const QRgb *palette(HeatmapRenderer::ColorScale scale)
+{
+    static QRgb sequential[256];
+    static QRgb diverging[256];
+    static bool built = false;
+
+    if (!built) {
+        // 与表格配色一致：浅底色 -> 青绿 -> 粉色
+        const QRgb stops[] = { qRgb(0xFF, 0xFF, 0xEF), qRgb(0x32, 0xC8, 0xB4), qRgb(0xFA, 0x78, 0xE0) };
+        for (int i = 0; i < 256; ++i) {
+            double t = i / 255.0;
+            sequential[i] = t < 0.5 ? lerpColor(stops[0], stops[1], t * 2.0)
+                                    : lerpColor(stops[1], stops[2], (t - 0.5) * 2.0);
+            diverging[i] = t < 0.5 ? lerpColor(qRgb(0x3B, 0x4C, 0xC0), qRgb(0xFF, 0xFF, 0xFF), t * 2.0)
+                                   : lerpColor(qRgb(0xFF, 0xFF, 0xFF), qRgb(0xB4, 0x04, 0x26), (t - 0.5) * 2.0);
+        }
+        built = true;
+    }
+    return scale == HeatmapRenderer::Diverging ? diverging : sequential;
+}
+
+} // namespace
+
+HeatmapRenderer::HeatmapRenderer()
+{
+    // 按最大可能的表长预留，值域变化重建查找表时不再分配
+    table.reserve(65536);
+}
+
+void HeatmapRenderer::render(const qint16 *data, int rxCount, int txCount, ColorScale scale, bool reverseRx,
+                             QImage &image)
+{
+    const int count = rxCount * txCount;
+    if (image.width() != rxCount || image.height() != txCount || image.format() != QImage::Format_RGB32) {
+        image = QImage(rxCount, txCount, QImage::Format_RGB32);
+    }
+
+    SimdKernels::minMax(data, count, lastMin, lastMax);
+    updateRange(lastMin, lastMax, scale);
+
+    // RGB32 每行 rx*4 字节，天然 4 字节对齐，整帧可以一次查表写入
+    quint32 *pixels = reinterpret_cast<quint32 *>(image.bits());
+    SimdKernels::lookupClamped(data, count, qint16(low), qint16(high), table.constData(), pixels);
+
+    if (reverseRx) {
+        for (int tx = 0; tx < txCount; ++tx) {
+            quint32 *line = pixels + tx * rxCount;
+            std::reverse(line, line + rxCount);
+        }
+    }
+}
+
+void HeatmapRenderer::updateRange(int frameLow, int frameHigh, ColorScale scale)
+{
+    // 发散色阶的范围至少为 [-1, 1]：全零帧（如两份相同采集的差值）时 0 仍落在中间色
+    if (scale == Diverging) {
+        int bound = qBound(1, qMax(qAbs(frameLow), qAbs(frameHigh)), 32767);
+        frameLow = -bound;
+        frameHigh = bound;
+    }
+
+    const int frameSpan = qMax(1, frameHigh - frameLow);
+    const bool covered = high >= low && frameLow >= low && frameHigh <= high;
+    const bool tooWide = (high - low) > frameSpan * 4;
+    if (covered && !tooWide && scale == tableScale) {
+        return;
+    }
+
+    // 两端各留 1/8 余量，帧间小幅波动不会触发重建
+    const int padding = frameSpan / 8;
+    low = qMax(-32768, frameLow - padding);
+    high = qMin(32767, frameHigh + padding);
+    if (scale == Diverging) {
+        int bound = qMax(1, qMin(-low, high));
+        low = -bound;
+        high = bound;
+    }
+    tableScale = scale;
+    rebuildTable();
+}
+
+void HeatmapRenderer::rebuildTable()
+{
+    const QRgb *colors = palette(tableScale);
+    const int entries = high - low + 1;
+    const int span = qMax(1, high - low);
+    table.resize(entries);
+    for (int i = 0; i < entries; ++i) {
+        table[i] = colors[i * 255 / span];
+    }
+}
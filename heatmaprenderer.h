@@ -0,0 +1,37 @@
+#ifndef HEATMAPRENDERER_H
+#define HEATMAPRENDERER_H
+
+#include <QImage>
+#include <QVector>
+
+// 热力图渲染：qint16 帧经颜色查找表（按当前值域裁剪，最多 65536 项）映射到预分配的 RGB32 图像
+// 值域带滞回：帧范围落在已有表内且不过宽时复用查找表，播放时不会每帧重建
+class HeatmapRenderer
+{
+public:
+    enum ColorScale {
+        Sequential,     // 最小值 -> 最大值
+        Diverging       // 以 0 为中心（用于差值）
+    };
+
+    HeatmapRenderer();
+
+    // 渲染一帧到 image（尺寸为 rx*tx，不匹配时重新分配）
+    void render(const qint16 *data, int rxCount, int txCount, ColorScale scale, bool reverseRx, QImage &image);
+
+    qint16 frameMin() const { return lastMin; }
+    qint16 frameMax() const { return lastMax; }
+
+private:
+    void updateRange(int frameLow, int frameHigh, ColorScale scale);
+    void rebuildTable();
+
+    QVector<quint32> table;          // table[v - low] 为值 v 的颜色
+    ColorScale tableScale = Sequential;
+    int low = 0;
+    int high = -1;                   // high < low 表示查找表尚未建立
+    qint16 lastMin = 0;
+    qint16 lastMax = 0;
+};
+
+#endif // HEATMAPRENDERER_H
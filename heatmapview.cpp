@@ -0,0 +1,210 @@
+#include "heatmapview.h"
+#include "celltextcache.h"
+#include <QApplication>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QRubberBand>
+#include <algorithm>
+
+HeatmapView::HeatmapView(QWidget *parent)
+    : QWidget(parent)
+    , rangeMin(0)
+    , rangeMax(0)
+    , reversed(false)
+    , overlayEnabled(false)
+    , overlayHex(false)
+    , rubberBand(nullptr)
+    , pressed(false)
+    , dragging(false)
+{
+    setMinimumSize(120, 120);
+}
+
+void HeatmapView::setTitle(const QString &text)
+{
+    title = text;
+    update();
+}
+
+void HeatmapView::setFrame(const qint16 *data, int rxCount, int txCount, HeatmapRenderer::ColorScale scale,
+                           bool reverseRx)
+{
+    const int count = rxCount * txCount;
+    if (!data || count <= 0) {
+        clearFrame();
+        return;
+    }
+
+    renderer.render(data, rxCount, txCount, scale, reverseRx, image);
+    reversed = reverseRx;
+    if (overlayEnabled) {
+        values.resize(count);
+        std::copy(data, data + count, values.begin());
+    }
+
+    rangeMin = renderer.frameMin();
+    rangeMax = renderer.frameMax();
+    update();
+}
+
+void HeatmapView::setPeaks(const QVector<QPoint> &points)
+{
+    peaks.resize(points.size());
+    std::copy(points.constBegin(), points.constEnd(), peaks.begin());
+    update();
+}
+
+void HeatmapView::setValueOverlay(bool enabled, bool asHex)
+{
+    overlayEnabled = enabled;
+    overlayHex = asHex;
+    if (!enabled) {
+        values.clear();
+    }
+    update();
+}
+
+void HeatmapView::clearFrame()
+{
+    image = QImage();
+    peaks.clear();
+    values.clear();
+    update();
+}
+
+QRect HeatmapView::gridRect() const
+{
+    const int textHeight = fontMetrics().height();
+    return QRect(0, textHeight + 4, width(), height() - 2 * (textHeight + 4));
+}
+
+void HeatmapView::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#FFFFFF"));
+    painter.setPen(QColor("#003D7A"));
+
+    const int textHeight = fontMetrics().height();
+    QRect titleRect(0, 0, width(), textHeight + 4);
+    QRect rangeRect(0, height() - textHeight - 4, width(), textHeight + 4);
+    painter.drawText(titleRect, Qt::AlignCenter, title);
+    if (!image.isNull()) {
+        painter.drawText(rangeRect, Qt::AlignCenter, QString("%1 ~ %2").arg(rangeMin).arg(rangeMax));
+    }
+
+    if (image.isNull()) {
+        painter.drawText(rect(), Qt::AlignCenter, tr("无数据"));
+        return;
+    }
+
+    // 最近邻放大，保证每个节点是清晰的色块
+    const QRect target = gridRect();
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(target, image);
+
+    const int rxCount = image.width();
+    const int txCount = image.height();
+    const double cellWidth = double(target.width()) / rxCount;
+    const double cellHeight = double(target.height()) / txCount;
+    auto cellRect = [&](int rx, int tx) {
+        int column = reversed ? (rxCount - 1 - rx) : rx;
+        return QRectF(target.left() + column * cellWidth, target.top() + tx * cellHeight, cellWidth, cellHeight);
+    };
+
+    // 数值叠加：格子放得下文字时才绘制，否则只显示颜色
+    if (overlayEnabled && values.size() == rxCount * txCount) {
+        const int textWidth = fontMetrics().horizontalAdvance(overlayHex ? QStringLiteral("FFFF")
+                                                                         : QStringLiteral("-00000"));
+        if (cellWidth >= textWidth + 2 && cellHeight >= textHeight) {
+            painter.setPen(QColor("#003D7A"));
+            for (int tx = 0; tx < txCount; ++tx) {
+                for (int rx = 0; rx < rxCount; ++rx) {
+                    qint16 value = values[tx * rxCount + rx];
+                    QString text = overlayHex ? CellTextCache::hex(value) : CellTextCache::decimal(value);
+                    painter.drawText(cellRect(rx, tx), Qt::AlignCenter, text);
+                }
+            }
+        }
+    }
+
+    // 峰值标记
+    if (!peaks.isEmpty()) {
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.setPen(QPen(QColor("#003D7A"), 2));
+        painter.setBrush(Qt::NoBrush);
+        const double radius = qMax(3.0, qMin(cellWidth, cellHeight) * 0.35);
+        for (const QPoint &peak : peaks) {
+            painter.drawEllipse(cellRect(peak.x(), peak.y()).center(), radius, radius);
+        }
+        painter.setRenderHint(QPainter::Antialiasing, false);
+    }
+
+    painter.setPen(QColor("#66CCFF"));
+    painter.drawRect(target.adjusted(0, 0, -1, -1));
+}
+
+QPoint HeatmapView::cellAt(const QPoint &pos) const
+{
+    const QRect target = gridRect();
+    const int rxCount = image.width();
+    const int txCount = image.height();
+    const int column = qBound(0, (pos.x() - target.left()) * rxCount / qMax(1, target.width()), rxCount - 1);
+    const int tx = qBound(0, (pos.y() - target.top()) * txCount / qMax(1, target.height()), txCount - 1);
+    return QPoint(reversed ? (rxCount - 1 - column) : column, tx);
+}
+
+void HeatmapView::mousePressEvent(QMouseEvent *event)
+{
+    if (image.isNull() || event->button() != Qt::LeftButton || !gridRect().contains(event->pos())) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    pressPos = event->pos();
+    pressed = true;
+    dragging = false;
+}
+
+void HeatmapView::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!pressed) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
+    // 移动超过拖动距离后进入框选
+    if (!dragging && (event->pos() - pressPos).manhattanLength() >= QApplication::startDragDistance()) {
+        dragging = true;
+        if (!rubberBand) {
+            rubberBand = new QRubberBand(QRubberBand::Rectangle, this);
+        }
+        rubberBand->show();
+    }
+    if (dragging) {
+        rubberBand->setGeometry(QRect(pressPos, event->pos()).normalized().intersected(gridRect()));
+    }
+}
+
+void HeatmapView::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (!pressed || event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+    pressed = false;
+    if (image.isNull()) {
+        return;
+    }
+
+    const QPoint first = cellAt(pressPos);
+    if (!dragging) {
+        emit cellClicked(first.x(), first.y());
+        return;
+    }
+
+    dragging = false;
+    rubberBand->hide();
+    const QPoint last = cellAt(event->pos());
+    emit regionSelected(QRect(first, last).normalized());
+}
@@ -0,0 +1,59 @@
+#ifndef HEATMAPVIEW_H
+#define HEATMAPVIEW_H
+
+#include <QWidget>
+#include <QImage>
+#include <QPoint>
+#include <QVector>
+#include "heatmaprenderer.h"
+
+class QRubberBand;
+
+// 热力图视图：把一帧数据映射成 rx*tx 像素的图像，按最近邻放大到控件大小
+// 可叠加峰值标记，格子足够大时可叠加数值；单击发出 cellClicked，拖动框选发出 regionSelected
+class HeatmapView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit HeatmapView(QWidget *parent = nullptr);
+
+    void setTitle(const QString &text);
+    void setFrame(const qint16 *data, int rxCount, int txCount, HeatmapRenderer::ColorScale scale,
+                  bool reverseRx = false);
+    void setPeaks(const QVector<QPoint> &points);      // x = rx, y = tx（未反转的坐标）
+    void setValueOverlay(bool enabled, bool asHex);
+    void clearFrame();
+
+    QRect gridRect() const;            // 格子区域（标题与范围文字之间）
+
+signals:
+    void cellClicked(int rx, int tx);  // 未反转的坐标
+    void regionSelected(const QRect &cells);   // 框选的格子范围，x = rx，y = tx（未反转的坐标）
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+private:
+    HeatmapRenderer renderer;
+    QImage image;
+    QString title;
+    qint16 rangeMin;
+    qint16 rangeMax;
+    QVector<QPoint> peaks;             // 自有副本，不与检测器共享（共享会让检测器下一帧重新分配）
+    QVector<qint16> values;            // 仅在叠加数值时保存
+    bool reversed;
+    bool overlayEnabled;
+    bool overlayHex;
+    QRubberBand *rubberBand;           // 拖动框选时创建
+    QPoint pressPos;
+    bool pressed;
+    bool dragging;
+
+    QPoint cellAt(const QPoint &pos) const;    // 控件坐标 -> 格子（未反转，已限制在范围内）
+};
+
+#endif // HEATMAPVIEW_H
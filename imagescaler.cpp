@@ -0,0 +1,95 @@
+#include "imagescaler.h"
+#include <QtConcurrent>
+
+ImageScaler::ImageScaler(QObject *parent)
+    : QObject(parent)
+    , sourceGeneration(0)
+    , runningGeneration(0)
+{
+    settleTimer.setSingleShot(true);
+    settleTimer.setInterval(kSettleDelayMs);
+    connect(&settleTimer, &QTimer::timeout, this, &ImageScaler::startSmoothScaling);
+    connect(&watcher, &QFutureWatcher<QImage>::finished, this, &ImageScaler::onSmoothScalingFinished);
+}
+
+ImageScaler::~ImageScaler()
+{
+    watcher.waitForFinished();
+}
+
+void ImageScaler::setSource(const QImage &image)
+{
+    source = image;
+    ++sourceGeneration;
+    cache.clear();
+    pendingSize = QSize();
+    settleTimer.stop();
+}
+
+bool ImageScaler::findCached(const QSize &size, QPixmap &pixmap)
+{
+    for (int i = 0; i < cache.size(); ++i) {
+        if (cache[i].first == size) {
+            if (i > 0) {
+                cache.move(i, 0);
+            }
+            pixmap = cache[0].second;
+            return true;
+        }
+    }
+    return false;
+}
+
+QPixmap ImageScaler::request(const QSize &size)
+{
+    QPixmap pixmap;
+    if (source.isNull() || size.isEmpty()) {
+        return pixmap;
+    }
+    if (findCached(size, pixmap)) {
+        // 拖回已缓存的尺寸，之前安排的平滑缩放不再需要
+        pendingSize = QSize();
+        settleTimer.stop();
+        return pixmap;
+    }
+
+    // 拖动缩放时每次尺寸变化都重新计时，只有停下来的尺寸才做平滑缩放
+    pendingSize = size;
+    settleTimer.start();
+    return QPixmap::fromImage(source.scaled(size, Qt::IgnoreAspectRatio, Qt::FastTransformation));
+}
+
+void ImageScaler::startSmoothScaling()
+{
+    // 同一时间只做一次平滑缩放，上一次结束后会按最新尺寸继续
+    if (watcher.isRunning() || pendingSize.isEmpty()) {
+        return;
+    }
+
+    runningSize = pendingSize;
+    runningGeneration = sourceGeneration;
+    pendingSize = QSize();
+    const QImage image = source;
+    const QSize size = runningSize;
+    watcher.setFuture(QtConcurrent::run([image, size]() {
+        return image.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }));
+}
+
+void ImageScaler::onSmoothScalingFinished()
+{
+    const QImage result = watcher.result();
+    if (runningGeneration == sourceGeneration && !result.isNull()) {
+        QPixmap pixmap = QPixmap::fromImage(result);
+        cache.prepend(qMakePair(runningSize, pixmap));
+        while (cache.size() > kMaxCachedSizes) {
+            cache.removeLast();
+        }
+        emit scaled(runningSize, pixmap);
+    }
+
+    // 缩放期间又有新的尺寸请求，且已经稳定下来
+    if (!pendingSize.isEmpty() && !settleTimer.isActive()) {
+        startSmoothScaling();
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef IMAGESCALER_H
+#define IMAGESCALER_H
+
+#include <QObject>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QPair>
+#include <QPixmap>
+#include <QSize>
+#include <QTimer>
+#include <QVector>
+
+// 图片缩放服务：同一张源图按不同尺寸缩放，平滑缩放的结果按尺寸缓存（最近使用的几个）
+// 未缓存的尺寸先返回快速缩放的预览；尺寸停止变化一段时间后在工作线程中平滑缩放，完成后发出 scaled()
+class ImageScaler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ImageScaler(QObject *parent = nullptr);
+    ~ImageScaler();
+
+    void setSource(const QImage &image);     // 清空缓存
+    bool hasSource() const { return !source.isNull(); }
+
+    // 已缓存时返回平滑缩放的结果，否则返回快速预览并安排平滑缩放
+    QPixmap request(const QSize &size);
+
+    static const int kSettleDelayMs = 150;   // 尺寸停止变化多久后开始平滑缩放
+    static const int kMaxCachedSizes = 3;    // 常用的是默认尺寸、最大化和全屏
+
+signals:
+    void scaled(const QSize &size, const QPixmap &pixmap);
+
+private slots:
+    void startSmoothScaling();
+    void onSmoothScalingFinished();
+
+private:
+    bool findCached(const QSize &size, QPixmap &pixmap);
+
+    QImage source;
+    QVector<QPair<QSize, QPixmap>> cache;    // 最近使用的在前
+    QSize pendingSize;                       // 最近一次请求的未缓存尺寸
+    QSize runningSize;                       // 正在后台缩放的尺寸
+    int sourceGeneration;                    // setSource() 时递增，丢弃旧源图的缩放结果
+    int runningGeneration;
+    QTimer settleTimer;
+    QFutureWatcher<QImage> watcher;
+};
+
+#endif // IMAGESCALER_H
@@ -0,0 +1,100 @@
+#include "lineprofilestrip.h"
+#include <QPainter>
+#include <algorithm>
+
+// 条形图的厚度（垂直于网格方向）
+static const int kStripThickness = 44;
+
+LineProfileStrip::LineProfileStrip(Qt::Orientation orientation, QWidget *parent)
+    : QWidget(parent)
+    , orientation(orientation)
+    , reversed(false)
+    , leadingMargin(0)
+    , trailingMargin(0)
+{
+    if (orientation == Qt::Horizontal) {
+        setFixedHeight(kStripThickness);
+    } else {
+        setFixedWidth(kStripThickness);
+    }
+}
+
+QSize LineProfileStrip::sizeHint() const
+{
+    return orientation == Qt::Horizontal ? QSize(120, kStripThickness) : QSize(kStripThickness, 120);
+}
+
+void LineProfileStrip::setValues(const QVector<qint32> &lineValues, bool reverse)
+{
+    if (values.size() != lineValues.size()) {
+        values.resize(lineValues.size());
+    }
+    std::copy(lineValues.constBegin(), lineValues.constEnd(), values.begin());
+    reversed = reverse;
+    update();
+}
+
+void LineProfileStrip::setSpan(int leading, int trailing)
+{
+    if (leading == leadingMargin && trailing == trailingMargin) {
+        return;
+    }
+    leadingMargin = leading;
+    trailingMargin = trailing;
+    update();
+}
+
+void LineProfileStrip::clearValues()
+{
+    values.clear();
+    update();
+}
+
+void LineProfileStrip::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#FFFFFF"));
+    if (values.isEmpty()) {
+        return;
+    }
+
+    // 以本帧绝对值最大的线为满刻度，并在角落标出该值
+    qint32 peak = 0;
+    for (qint32 value : values) {
+        peak = qMax(peak, qAbs(value));
+    }
+
+    const bool horizontal = (orientation == Qt::Horizontal);
+    const int length = (horizontal ? width() : height()) - leadingMargin - trailingMargin;
+    const int thickness = horizontal ? height() : width();
+    const double step = double(length) / values.size();
+    const double center = thickness / 2.0;
+    const double scale = peak > 0 ? (thickness / 2.0 - 2) / peak : 0.0;
+
+    painter.setPen(QColor("#C0C0C0"));
+    if (horizontal) {
+        painter.drawLine(QPointF(leadingMargin, center), QPointF(leadingMargin + length, center));
+    } else {
+        painter.drawLine(QPointF(center, leadingMargin), QPointF(center, leadingMargin + length));
+    }
+
+    painter.setPen(Qt::NoPen);
+    for (int i = 0; i < values.size(); ++i) {
+        const int position = reversed ? (values.size() - 1 - i) : i;
+        const double start = leadingMargin + position * step + step * 0.15;
+        const double extent = values[i] * scale;
+        painter.setBrush(values[i] >= 0 ? QColor("#FA78E0") : QColor("#32C8B4"));
+        if (horizontal) {
+            // 正值向上
+            painter.drawRect(QRectF(start, center - qMax(0.0, extent), step * 0.7, qAbs(extent)));
+        } else {
+            // 正值向右
+            painter.drawRect(QRectF(center + qMin(0.0, extent), start, qAbs(extent), step * 0.7));
+        }
+    }
+
+    painter.setPen(QColor("#003D7A"));
+    painter.drawText(rect().adjusted(2, 0, -2, 0), Qt::AlignRight | Qt::AlignTop, QString::number(peak));
+}
@@ -0,0 +1,34 @@
+#ifndef LINEPROFILESTRIP_H
+#define LINEPROFILESTRIP_H
+
+#include <QWidget>
+#include <QVector>
+
+// 行/列统计的边栏条形图：沿网格排列，每条线一根以 0 为基准的条
+// Qt::Horizontal 放在网格下方（每列一根竖条），Qt::Vertical 放在网格右侧（每行一根横条）
+// 条的排列范围由 setSpan 指定，使其与表格/热力图的格子对齐
+class LineProfileStrip : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit LineProfileStrip(Qt::Orientation orientation, QWidget *parent = nullptr);
+
+    void setValues(const QVector<qint32> &lineValues, bool reversed = false);
+    void setSpan(int leading, int trailing);      // 网格两端相对本控件的留白（像素）
+    void clearValues();
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    Qt::Orientation orientation;
+    QVector<qint32> values;            // 自有副本，尺寸不变时不重新分配
+    bool reversed;
+    int leadingMargin;
+    int trailingMargin;
+};
+
+#endif // LINEPROFILESTRIP_H
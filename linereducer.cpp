@@ -0,0 +1,72 @@
+#include "linereducer.h"
+#include "simdkernels.h"
+#include <algorithm>
+
+namespace {
+
+qint32 roundedDivide(qint32 sum, int count)
+{
+    qint32 half = count / 2;
+    return sum >= 0 ? (sum + half) / count : (sum - half) / count;
+}
+
+// 偶数个时取两个中间值的平均
+qint32 medianOf(qint16 *values, int count)
+{
+    qint16 *middle = values + count / 2;
+    std::nth_element(values, middle, values + count);
+    if (count % 2 != 0) {
+        return *middle;
+    }
+    qint16 lower = *std::max_element(values, middle);
+    return roundedDivide(qint32(lower) + qint32(*middle), 2);
+}
+
+} // namespace
+
+void LineReducer::reduce(const qint16 *frame, int width, int height, Statistic statistic)
+{
+    if (rows.size() != height) {
+        rows.resize(height);
+    }
+    if (columns.size() != width) {
+        columns.resize(width);
+    }
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    if (statistic != Median) {
+        SimdKernels::rowSums(frame, width, height, rows.data());
+        SimdKernels::columnSums(frame, width, height, columns.data());
+        if (statistic == Mean) {
+            for (qint32 &value : rows) {
+                value = roundedDivide(value, width);
+            }
+            for (qint32 &value : columns) {
+                value = roundedDivide(value, height);
+            }
+        }
+        return;
+    }
+
+    // 中值：行直接复制，列转置后连续存放，然后逐段部分排序
+    const int count = width * height;
+    if (scratch.size() != count) {
+        scratch.resize(count);
+    }
+    qint16 *buffer = scratch.data();
+    std::copy(frame, frame + count, buffer);
+    for (int y = 0; y < height; ++y) {
+        rows[y] = medianOf(buffer + y * width, width);
+    }
+    for (int y = 0; y < height; ++y) {
+        const qint16 *row = frame + y * width;
+        for (int x = 0; x < width; ++x) {
+            buffer[x * height + y] = row[x];
+        }
+    }
+    for (int x = 0; x < width; ++x) {
+        columns[x] = medianOf(buffer + x * height, height);
+    }
+}
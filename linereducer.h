@@ -0,0 +1,29 @@
+#ifndef LINEREDUCER_H
+#define LINEREDUCER_H
+
+#include <QVector>
+
+// 每帧按行（TX）和列（RX）归约：总和、均值或中值
+// 内部缓冲在多次调用之间复用，尺寸不变时不会重新分配
+class LineReducer
+{
+public:
+    enum Statistic {
+        Sum,
+        Mean,
+        Median
+    };
+
+    // frame 按 height 行、width 列排列（与帧数据相同，行 = TX，列 = RX）
+    void reduce(const qint16 *frame, int width, int height, Statistic statistic);
+
+    const QVector<qint32> &rowValues() const { return rows; }         // height 项
+    const QVector<qint32> &columnValues() const { return columns; }   // width 项
+
+private:
+    QVector<qint32> rows;
+    QVector<qint32> columns;
+    QVector<qint16> scratch;      // 求中值时的副本（列按转置存放）
+};
+
+#endif // LINEREDUCER_H
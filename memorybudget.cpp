@@ -0,0 +1,270 @@
+#include "memorybudget.h"
+#include <QAtomicInteger>
+#include <QCoreApplication>
+#include <QDir>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QStringList>
+#include <QTemporaryFile>
+#include <QVector>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const qint64 kSpillGranularity = 64 * 1024;    // Windows 的映射偏移必须按 64KB 对齐
+const qint64 kSegmentBytes = qint64(64) * 1024 * 1024;
+
+QAtomicInteger<qint64> heapTotal(0);
+QAtomicInteger<qint64> spillTotal(0);
+QAtomicInteger<qint64> limitBytes(MemoryBudget::kDefaultLimit);
+
+// 换出文件分成多个固定大小的段，每段是一个临时文件，创建时一次设好大小，之后不再改变：
+// Windows 上同一个文件的所有视图共用第一次映射时按当时文件大小创建的映射对象，
+// 在已有映射时加长文件，新加的部分无法映射
+// 段内释放的区域按大小记录下来重复使用，段内的区域全部释放后删除该段，归还磁盘空间
+struct SpillSegment
+{
+    QTemporaryFile *file = nullptr;
+    qint64 size = 0;
+    qint64 used = 0;                           // 已分配过的末尾
+    int mapped = 0;                            // 正在使用的区域数
+    QMultiMap<qint64, qint64> freeRegions;     // 区域大小 -> 偏移
+};
+
+struct SpillRegion
+{
+    SpillSegment *segment;
+    qint64 offset;
+};
+
+struct SpillFile
+{
+    QMutex mutex;
+    QVector<SpillSegment *> segments;
+    QMap<void *, SpillRegion> regions;         // 映射地址 -> 所在的段和偏移
+};
+
+SpillFile &spillFile()
+{
+    static SpillFile spill;
+    return spill;
+}
+
+struct Consumer
+{
+    int id;
+    QString name;
+    int priority;
+    std::function<qint64()> usage;
+    std::function<qint64(qint64)> evict;
+};
+
+QVector<Consumer> consumers;
+int nextConsumerId = 1;
+
+qint64 regionSize(qint64 bytes)
+{
+    return (bytes + kSpillGranularity - 1) / kSpillGranularity * kSpillGranularity;
+}
+
+// 在已有的段中找一块区域，没有空间时新建一段（区域大于段的大小时单独成段）
+SpillSegment *allocateRegion(SpillFile &spill, qint64 size, qint64 &offset)
+{
+    for (SpillSegment *segment : spill.segments) {
+        auto reusable = segment->freeRegions.find(size);
+        if (reusable != segment->freeRegions.end()) {
+            offset = reusable.value();
+            segment->freeRegions.erase(reusable);
+            return segment;
+        }
+    }
+    for (SpillSegment *segment : spill.segments) {
+        if (segment->used + size <= segment->size) {
+            offset = segment->used;
+            segment->used += size;
+            return segment;
+        }
+    }
+
+    SpillSegment *segment = new SpillSegment;
+    segment->file = new QTemporaryFile(QDir::tempPath() + QStringLiteral("/rgd_spill_XXXXXX.bin"));
+    segment->size = qMax(kSegmentBytes, size);
+    if (!segment->file->open() || !segment->file->resize(segment->size)) {
+        delete segment->file;
+        delete segment;
+        return nullptr;
+    }
+    spill.segments.append(segment);
+    offset = 0;
+    segment->used = size;
+    return segment;
+}
+
+QString megabytes(qint64 bytes)
+{
+    return QString::number(bytes / (1024.0 * 1024.0), 'f', 0);
+}
+
+} // namespace
+
+namespace MemoryBudget {
+
+void setLimit(qint64 bytes)
+{
+    limitBytes.storeRelaxed(qMax(qint64(0), bytes));
+}
+
+qint64 limit()
+{
+    return limitBytes.loadRelaxed();
+}
+
+qint64 heapBytes()
+{
+    return heapTotal.loadRelaxed();
+}
+
+qint64 spilledBytes()
+{
+    return spillTotal.loadRelaxed();
+}
+
+bool reserveHeap(qint64 bytes)
+{
+    // 先登记再检查，多个线程同时分配时不会一起越过上限
+    if (heapTotal.fetchAndAddRelaxed(bytes) + bytes <= limitBytes.loadRelaxed()) {
+        return true;
+    }
+    heapTotal.fetchAndAddRelaxed(-bytes);
+    return false;
+}
+
+void forceHeap(qint64 bytes)
+{
+    heapTotal.fetchAndAddRelaxed(bytes);
+}
+
+void releaseHeap(qint64 bytes)
+{
+    heapTotal.fetchAndAddRelaxed(-bytes);
+}
+
+void *mapSpill(qint64 bytes)
+{
+    if (bytes <= 0) {
+        return nullptr;
+    }
+
+    SpillFile &spill = spillFile();
+    QMutexLocker locker(&spill.mutex);
+    const qint64 size = regionSize(bytes);
+    qint64 offset = 0;
+    SpillSegment *segment = allocateRegion(spill, size, offset);
+    if (!segment) {
+        return nullptr;
+    }
+
+    uchar *data = segment->file->map(offset, size);
+    if (!data) {
+        segment->freeRegions.insert(size, offset);
+        return nullptr;
+    }
+    // 重复使用的区域里还留着以前的数据
+    std::memset(data, 0, size_t(bytes));
+    segment->mapped++;
+    spill.regions.insert(data, SpillRegion{ segment, offset });
+    spillTotal.fetchAndAddRelaxed(size);
+    return data;
+}
+
+void unmapSpill(void *data, qint64 bytes)
+{
+    if (!data) {
+        return;
+    }
+
+    SpillFile &spill = spillFile();
+    QMutexLocker locker(&spill.mutex);
+    const qint64 size = regionSize(bytes);
+    const SpillRegion region = spill.regions.take(data);
+    SpillSegment *segment = region.segment;
+    segment->file->unmap(static_cast<uchar *>(data));
+    segment->freeRegions.insert(size, region.offset);
+    spillTotal.fetchAndAddRelaxed(-size);
+    if (--segment->mapped == 0) {
+        // 段内没有区域在用了，删除临时文件归还磁盘空间
+        spill.segments.removeOne(segment);
+        delete segment->file;
+        delete segment;
+    }
+}
+
+int addConsumer(const QString &name, int priority, std::function<qint64()> usage,
+                std::function<qint64(qint64)> evict)
+{
+    Consumer consumer;
+    consumer.id = nextConsumerId++;
+    consumer.name = name;
+    consumer.priority = priority;
+    consumer.usage = usage;
+    consumer.evict = evict;
+    consumers.append(consumer);
+    std::stable_sort(consumers.begin(), consumers.end(), [](const Consumer &a, const Consumer &b) {
+        return a.priority < b.priority;
+    });
+    return consumer.id;
+}
+
+void removeConsumer(int id)
+{
+    for (int i = 0; i < consumers.size(); ++i) {
+        if (consumers[i].id == id) {
+            consumers.remove(i);
+            return;
+        }
+    }
+}
+
+qint64 enforce()
+{
+    const qint64 high = limit() / 10 * 9;
+    const qint64 low = limit() / 4 * 3;
+    if (heapBytes() <= high) {
+        return 0;
+    }
+
+    // 工作线程持有的副本会让换出的块暂时留在堆上，按各使用者报告的换出量计算，避免反复换出
+    const qint64 excess = heapBytes() - low;
+    qint64 evicted = 0;
+    for (const Consumer &consumer : consumers) {
+        if (evicted >= excess) {
+            break;
+        }
+        evicted += consumer.evict(excess - evicted);
+    }
+    return evicted;
+}
+
+QString usageText()
+{
+    QString text = QCoreApplication::translate("MemoryBudget", "内存 %1 / %2 MB")
+                       .arg(megabytes(heapBytes()), megabytes(limit()));
+    if (spilledBytes() > 0) {
+        text += QCoreApplication::translate("MemoryBudget", "，换出 %1 MB").arg(megabytes(spilledBytes()));
+    }
+    return text;
+}
+
+QString usageDetails()
+{
+    QStringList lines;
+    for (const Consumer &consumer : consumers) {
+        lines << QStringLiteral("%1: %2 MB").arg(consumer.name, megabytes(consumer.usage()));
+    }
+    lines << QCoreApplication::translate("MemoryBudget", "换出文件: %1 MB").arg(megabytes(spilledBytes()));
+    return lines.join('\n');
+}
+
+} // namespace MemoryBudget
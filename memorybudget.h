@@ -0,0 +1,43 @@
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include <QString>
+#include <functional>
+
+// 内存预算：所有帧存储的数据块在分配时向这里登记，堆上的总量超过上限后新的块改为放入
+// 内存映射的临时文件（换出文件），大采集只是跳帧时稍慢，不会因内存不足而崩溃
+// 帧存储、缓存等以“使用者”的身份登记用量和换出方法，enforce() 在界面线程中按优先级让它们把冷数据换出
+// 分配和释放可在任意线程中调用；使用者的登记和 enforce() 只能在界面线程调用
+namespace MemoryBudget {
+
+const qint64 kDefaultLimit = qint64(2048) * 1024 * 1024;
+
+void setLimit(qint64 bytes);
+qint64 limit();
+qint64 heapBytes();                      // 当前在堆上的数据块字节数
+qint64 spilledBytes();                   // 当前在换出文件中的字节数
+
+// 预算内时登记并返回 true；超出预算时不登记，返回 false
+bool reserveHeap(qint64 bytes);
+void forceHeap(qint64 bytes);            // 换出失败时仍在堆上分配，只登记
+void releaseHeap(qint64 bytes);
+
+// 在换出文件中映射一块可读写的区域（内容清零），失败时返回 nullptr
+void *mapSpill(qint64 bytes);
+void unmapSpill(void *data, qint64 bytes);
+
+// 使用者：usage 返回它在堆上的字节数，evict(bytes) 尽量换出 bytes 字节并返回实际换出的字节数
+// priority 小的先被换出（可重新计算的缓存应小于原始数据）
+int addConsumer(const QString &name, int priority, std::function<qint64()> usage,
+                std::function<qint64(qint64)> evict);
+void removeConsumer(int id);
+
+// 堆用量超过上限的 90% 时让使用者换出冷数据，直到降到 75%；返回换出的字节数
+qint64 enforce();
+
+QString usageText();                     // 状态栏用的一行摘要
+QString usageDetails();                  // 各使用者的用量（用于提示文字）
+
+} // namespace MemoryBudget
+
+#endif // MEMORYBUDGET_H
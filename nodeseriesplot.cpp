@@ -0,0 +1,319 @@
+#include "nodeseriesplot.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPolygonF>
+#include <QWheelEvent>
+#include <algorithm>
+#include <cmath>
+
+// 坐标轴文字所占的留白
+static const int kLeftMargin = 56;
+static const int kBottomMargin = 22;
+static const int kTopMargin = 22;
+static const int kRightMargin = 12;
+
+// 块内最值的块大小，以及放大后最少显示的帧数
+static const int kBlockFrames = 64;
+static const int kMinViewFrames = 16;
+
+NodeSeriesPlot::NodeSeriesPlot(QWidget *parent)
+    : QWidget(parent)
+    , firstFrame(0)
+    , endFrame(0)
+    , currentFrame(-1)
+    , pressFirstFrame(0)
+    , pressed(false)
+    , dragging(false)
+    , renderUs(0)
+{
+    setMinimumSize(320, 200);
+}
+
+QSize NodeSeriesPlot::sizeHint() const
+{
+    return QSize(900, 320);
+}
+
+void NodeSeriesPlot::setSeries(const QVector<int> &values, bool keepView)
+{
+    const bool sameLength = (values.size() == series.size());
+    series = values;
+
+    const int blocks = (series.size() + kBlockFrames - 1) / kBlockFrames;
+    blockMin.resize(blocks);
+    blockMax.resize(blocks);
+    for (int b = 0; b < blocks; ++b) {
+        const int *first = series.constData() + b * kBlockFrames;
+        const int *last = series.constData() + qMin(series.size(), (b + 1) * kBlockFrames);
+        const auto range = std::minmax_element(first, last);
+        blockMin[b] = *range.first;
+        blockMax[b] = *range.second;
+    }
+
+    if (keepView && sameLength) {
+        update();
+    } else {
+        setView(0, series.size());
+    }
+}
+
+void NodeSeriesPlot::setLabel(const QString &text)
+{
+    label = text;
+    update();
+}
+
+void NodeSeriesPlot::setCurrentFrame(int frame)
+{
+    if (currentFrame != frame) {
+        currentFrame = frame;
+        update();
+    }
+}
+
+void NodeSeriesPlot::clearSeries()
+{
+    series.clear();
+    blockMin.clear();
+    blockMax.clear();
+    firstFrame = 0;
+    endFrame = 0;
+    update();
+}
+
+QRect NodeSeriesPlot::plotRect() const
+{
+    return QRect(kLeftMargin, kTopMargin, width() - kLeftMargin - kRightMargin,
+                 height() - kTopMargin - kBottomMargin);
+}
+
+int NodeSeriesPlot::frameAt(int x) const
+{
+    const QRect area = plotRect();
+    const int span = endFrame - firstFrame;
+    if (span <= 0 || area.width() <= 0) {
+        return -1;
+    }
+    const int offset = qBound(0, x - area.left(), area.width() - 1);
+    if (span > area.width()) {
+        return firstFrame + int(qint64(offset) * span / area.width());
+    }
+    const int steps = qMax(1, area.width() - 1);
+    return firstFrame + int((qint64(offset) * (span - 1) + steps / 2) / steps);
+}
+
+void NodeSeriesPlot::setView(qint64 begin, qint64 end)
+{
+    const qint64 total = series.size();
+    const qint64 span = qBound<qint64>(qMin<qint64>(kMinViewFrames, total), end - begin, total);
+    begin = qBound<qint64>(0, begin, total - span);
+    if (firstFrame != int(begin) || endFrame != int(begin + span)) {
+        firstFrame = int(begin);
+        endFrame = int(begin + span);
+        emit viewChanged(firstFrame, endFrame);
+    }
+    update();
+}
+
+void NodeSeriesPlot::rangeMinMax(int begin, int end, int &low, int &high) const
+{
+    // 两端不满一块的部分逐帧比较，中间整块直接用块内最值
+    low = series[begin];
+    high = series[begin];
+    const int firstBlock = (begin + kBlockFrames - 1) / kBlockFrames;
+    const int lastBlock = end / kBlockFrames;
+    if (firstBlock >= lastBlock) {
+        for (int i = begin; i < end; ++i) {
+            low = qMin(low, series[i]);
+            high = qMax(high, series[i]);
+        }
+        return;
+    }
+    for (int i = begin; i < firstBlock * kBlockFrames; ++i) {
+        low = qMin(low, series[i]);
+        high = qMax(high, series[i]);
+    }
+    for (int b = firstBlock; b < lastBlock; ++b) {
+        low = qMin(low, blockMin[b]);
+        high = qMax(high, blockMax[b]);
+    }
+    for (int i = lastBlock * kBlockFrames; i < end; ++i) {
+        low = qMin(low, series[i]);
+        high = qMax(high, series[i]);
+    }
+}
+
+void NodeSeriesPlot::wheelEvent(QWheelEvent *event)
+{
+    const QRect area = plotRect();
+    const int span = endFrame - firstFrame;
+    if (series.isEmpty() || area.width() <= 0 || event->angleDelta().y() == 0) {
+        QWidget::wheelEvent(event);
+        return;
+    }
+
+    // 以光标处的帧为中心缩放，每格滚轮缩放 20%
+    const int x = int(event->position().x());
+    const double fraction = qBound(0.0, double(x - area.left()) / area.width(), 1.0);
+    const double anchor = firstFrame + fraction * span;
+    const double newSpan = span * std::pow(0.8, event->angleDelta().y() / 120.0);
+    const qint64 begin = qint64(std::floor(anchor - fraction * newSpan));
+    setView(begin, begin + qMax<qint64>(1, qint64(std::ceil(newSpan))));
+    event->accept();
+}
+
+void NodeSeriesPlot::mousePressEvent(QMouseEvent *event)
+{
+    if (series.isEmpty() || event->button() != Qt::LeftButton || !plotRect().contains(event->pos())) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    pressPos = event->pos();
+    pressFirstFrame = firstFrame;
+    pressed = true;
+    dragging = false;
+}
+
+void NodeSeriesPlot::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!pressed) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+
+    // 移动超过拖动距离后按像素换算帧数平移
+    const int dx = event->pos().x() - pressPos.x();
+    if (!dragging && qAbs(dx) >= QApplication::startDragDistance()) {
+        dragging = true;
+        setCursor(Qt::ClosedHandCursor);
+    }
+    if (dragging) {
+        const int span = endFrame - firstFrame;
+        const qint64 begin = pressFirstFrame - qint64(dx) * span / qMax(1, plotRect().width());
+        setView(begin, begin + span);
+    }
+}
+
+void NodeSeriesPlot::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (!pressed || event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+    pressed = false;
+    if (dragging) {
+        dragging = false;
+        unsetCursor();
+        return;
+    }
+
+    const int frame = frameAt(pressPos.x());
+    if (frame >= 0) {
+        emit frameSelected(frame);
+    }
+}
+
+void NodeSeriesPlot::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton && !series.isEmpty()) {
+        setView(0, series.size());
+    }
+}
+
+void NodeSeriesPlot::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#FFFFFF"));
+    const QRect area = plotRect();
+    painter.setPen(QColor("#66CCFF"));
+    painter.drawRect(area.adjusted(0, 0, -1, -1));
+
+    painter.setPen(QColor("#003D7A"));
+    const int span = endFrame - firstFrame;
+    if (span <= 0 || area.width() <= 1 || area.height() <= 1) {
+        painter.drawText(rect(), Qt::AlignCenter, tr("无数据"));
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 帧数多于像素时先算出每列的最值，纵轴范围取所有列的最值
+    const int columns = area.width();
+    const bool decimated = span > columns;
+    int low = 0;
+    int high = 0;
+    if (decimated) {
+        columnLow.resize(columns);
+        columnHigh.resize(columns);
+        for (int x = 0; x < columns; ++x) {
+            // 每列多包含前一列的最后一帧，相邻列的竖线首尾相连
+            const int first = firstFrame + int(qint64(x) * span / columns);
+            const int last = firstFrame + int(qint64(x + 1) * span / columns);
+            rangeMinMax(qMax(firstFrame, first - 1), last, columnLow[x], columnHigh[x]);
+        }
+        low = *std::min_element(columnLow.constBegin(), columnLow.constEnd());
+        high = *std::max_element(columnHigh.constBegin(), columnHigh.constEnd());
+    } else {
+        rangeMinMax(firstFrame, endFrame, low, high);
+    }
+    const double bottomValue = (low == high) ? low - 1.0 : double(low);
+    const double topValue = (low == high) ? high + 1.0 : double(high);
+    const double scale = (area.height() - 1) / (topValue - bottomValue);
+    auto yOf = [&](double value) { return area.bottom() - (value - bottomValue) * scale; };
+
+    painter.setPen(QPen(QColor("#0078D4"), 1));
+    if (decimated) {
+        columnLines.resize(columns);
+        for (int x = 0; x < columns; ++x) {
+            columnLines[x] = QLine(area.left() + x, int(yOf(columnHigh[x])), area.left() + x, int(yOf(columnLow[x])));
+        }
+        painter.drawLines(columnLines.constData(), columnLines.size());
+    } else {
+        QPolygonF points;
+        points.reserve(span);
+        const double step = (span > 1) ? double(columns - 1) / (span - 1) : 0.0;
+        for (int i = 0; i < span; ++i) {
+            points.append(QPointF(area.left() + i * step, yOf(series[firstFrame + i])));
+        }
+        painter.setRenderHint(QPainter::Antialiasing, true);
+        painter.drawPolyline(points);
+        painter.setRenderHint(QPainter::Antialiasing, false);
+    }
+    renderUs = timer.nsecsElapsed() / 1000;
+
+    // 主窗口当前帧
+    if (currentFrame >= firstFrame && currentFrame < endFrame) {
+        const double x = decimated
+            ? area.left() + double(currentFrame - firstFrame) * columns / span
+            : area.left() + (span > 1 ? double(currentFrame - firstFrame) * (columns - 1) / (span - 1) : 0.0);
+        painter.setPen(QPen(QColor("#FA78E0"), 1, Qt::DashLine));
+        painter.drawLine(QPointF(x, area.top()), QPointF(x, area.bottom()));
+    }
+
+    // 坐标轴刻度：首尾帧号（从 1 开始）和纵轴上下限
+    const int textHeight = fontMetrics().height();
+    painter.setPen(QColor("#003D7A"));
+    painter.drawText(QRect(area.left(), area.bottom() + 2, area.width() / 2, textHeight),
+                     Qt::AlignLeft | Qt::AlignTop, tr("第 %1 帧").arg(firstFrame + 1));
+    painter.drawText(QRect(area.center().x(), area.bottom() + 2, area.width() / 2, textHeight),
+                     Qt::AlignRight | Qt::AlignTop, tr("第 %1 帧").arg(endFrame));
+    painter.drawText(QRect(0, area.top(), kLeftMargin - 4, textHeight), Qt::AlignRight | Qt::AlignTop,
+                     QString::number(high));
+    painter.drawText(QRect(0, area.bottom() - textHeight, kLeftMargin - 4, textHeight),
+                     Qt::AlignRight | Qt::AlignBottom, QString::number(low));
+
+    QString legend = label;
+    if (decimated) {
+        legend += tr("  （每像素 %1 帧，取最小/最大值）").arg(double(span) / columns, 0, 'f', 1);
+    }
+    painter.drawText(QRect(area.left(), 0, area.width(), kTopMargin), Qt::AlignLeft | Qt::AlignVCenter, legend);
+    if (currentFrame >= 0 && currentFrame < series.size()) {
+        painter.drawText(QRect(area.left(), 0, area.width(), kTopMargin), Qt::AlignRight | Qt::AlignVCenter,
+                         tr("第 %1 帧: %2").arg(currentFrame + 1).arg(series[currentFrame]));
+    }
+}
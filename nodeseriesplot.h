@@ -0,0 +1,67 @@
+#ifndef NODESERIESPLOT_H
+#define NODESERIESPLOT_H
+
+#include <QWidget>
+#include <QVector>
+#include <QLine>
+
+// 单个节点在整段采集上的时序曲线：帧数多于像素时每个像素列画出该列覆盖帧的最小值到最大值（min-max 抽取），
+// 单帧的毛刺不会被抽样漏掉；按 64 帧一块预先算好块内最值，每次绘制只与像素列数有关，与帧数基本无关
+// 滚轮以光标处为中心缩放，左键拖动平移，单击选择帧，双击恢复显示全部帧
+class NodeSeriesPlot : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit NodeSeriesPlot(QWidget *parent = nullptr);
+
+    // 设置新的曲线并显示全部帧；keepView 为 true 且帧数不变时保留当前缩放范围
+    void setSeries(const QVector<int> &values, bool keepView = false);
+    void setLabel(const QString &text);
+    void setCurrentFrame(int frame);
+    void clearSeries();
+
+    int viewBegin() const { return firstFrame; }
+    int viewEnd() const { return endFrame; }
+    qint64 lastRenderUs() const { return renderUs; }
+
+    QSize sizeHint() const override;
+
+signals:
+    void frameSelected(int frame);
+    void viewChanged(int begin, int end);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+
+private:
+    QRect plotRect() const;
+    int frameAt(int x) const;
+    void setView(qint64 begin, qint64 end);
+    void rangeMinMax(int begin, int end, int &low, int &high) const;
+
+    QVector<int> series;
+    QVector<int> blockMin;           // 每 kBlockFrames 帧的最小值
+    QVector<int> blockMax;           // 每 kBlockFrames 帧的最大值
+    int firstFrame;                  // 显示范围 [firstFrame, endFrame)
+    int endFrame;
+    int currentFrame;                // 主窗口当前帧，-1 表示不显示
+    QString label;
+
+    QPoint pressPos;
+    int pressFirstFrame;
+    bool pressed;
+    bool dragging;
+    qint64 renderUs;                 // 上一次绘制曲线的耗时（微秒）
+
+    QVector<int> columnLow;          // 绘制缓冲，跨帧复用
+    QVector<int> columnHigh;
+    QVector<QLine> columnLines;
+};
+
+#endif // NODESERIESPLOT_H
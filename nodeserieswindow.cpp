@@ -0,0 +1,189 @@
+#include "nodeserieswindow.h"
+#include "nodeseriesplot.h"
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QHBoxLayout>
+#include <QHideEvent>
+#include <QLabel>
+#include <QSpinBox>
+#include <QVBoxLayout>
+#include <algorithm>
+#include <cmath>
+
+NodeSeriesWindow::NodeSeriesWindow(QWidget *parent)
+    : QWidget(parent, Qt::Window)
+    , signalCalcMode(0)
+    , rxCount(0)
+{
+    setWindowTitle(tr("节点时序"));
+    resize(1000, 420);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    QHBoxLayout *toolLayout = new QHBoxLayout;
+    toolLayout->addWidget(new QLabel(tr("TX:"), this));
+    txSpinBox = new QSpinBox(this);
+    toolLayout->addWidget(txSpinBox);
+    toolLayout->addWidget(new QLabel(tr("RX:"), this));
+    rxSpinBox = new QSpinBox(this);
+    toolLayout->addWidget(rxSpinBox);
+    toolLayout->addWidget(new QLabel(tr("数据:"), this));
+    dataComboBox = new QComboBox(this);
+    dataComboBox->addItem(tr("原始数据"));
+    dataComboBox->addItem(tr("信号数据"));
+    toolLayout->addWidget(dataComboBox);
+    toolLayout->addStretch();
+    statusLabel = new QLabel(this);
+    toolLayout->addWidget(statusLabel);
+    mainLayout->addLayout(toolLayout);
+
+    plot = new NodeSeriesPlot(this);
+    plot->setToolTip(tr("滚轮缩放，拖动平移，双击显示全部帧，单击跳到该帧"));
+    mainLayout->addWidget(plot, 1);
+
+    connect(txSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &NodeSeriesWindow::refreshSeries);
+    connect(rxSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, &NodeSeriesWindow::refreshSeries);
+    connect(dataComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &NodeSeriesWindow::refreshSeries);
+    connect(plot, &NodeSeriesPlot::frameSelected, this, &NodeSeriesWindow::frameRequested);
+}
+
+void NodeSeriesWindow::setSource(const FrameStore &raw, const FrameStore &processed, const QVector<qint16> &baseline,
+                                 int calcMode, int rx, int tx)
+{
+    rawFrames = raw;
+    signalFrames = processed;
+    baselineData = baseline;
+    signalCalcMode = calcMode;
+    rxCount = rx;
+    sourceKey.clear();
+
+    // 没有基线也没有处理结果时只能看原始数据
+    const bool hasSignal = (signalFrames.frameCount() == rawFrames.frameCount() && !signalFrames.isEmpty())
+                           || baselineData.size() == rawFrames.frameSize();
+    dataComboBox->setItemData(1, hasSignal ? QVariant() : QVariant(0), Qt::UserRole - 1);
+
+    const QSignalBlocker txBlocker(txSpinBox);
+    const QSignalBlocker rxBlocker(rxSpinBox);
+    txSpinBox->setRange(0, qMax(0, tx - 1));
+    rxSpinBox->setRange(0, qMax(0, rx - 1));
+}
+
+void NodeSeriesWindow::releaseFrames()
+{
+    rawFrames = FrameStore();
+    signalFrames = FrameStore();
+    sourceKey.clear();
+}
+
+void NodeSeriesWindow::shareFrames(const FrameStore &raw, const FrameStore &processed)
+{
+    rawFrames = raw;
+    signalFrames = processed;
+}
+
+void NodeSeriesWindow::hideEvent(QHideEvent *event)
+{
+    // 关闭后不再持有帧数据，重新打开时页面会重新设置；最小化时保留
+    if (!event->spontaneous()) {
+        releaseFrames();
+    }
+    QWidget::hideEvent(event);
+}
+
+void NodeSeriesWindow::showNode(int rx, int tx, bool signal)
+{
+    {
+        const QSignalBlocker txBlocker(txSpinBox);
+        const QSignalBlocker rxBlocker(rxSpinBox);
+        const QSignalBlocker dataBlocker(dataComboBox);
+        txSpinBox->setValue(tx);
+        rxSpinBox->setValue(rx);
+        // 信号数据不可用时退回原始数据
+        const bool signalEnabled = dataComboBox->itemData(1, Qt::UserRole - 1).isNull();
+        dataComboBox->setCurrentIndex(signal && signalEnabled ? 1 : 0);
+    }
+    refreshSeries();
+}
+
+void NodeSeriesWindow::setCurrentFrame(int frame)
+{
+    plot->setCurrentFrame(frame);
+}
+
+bool NodeSeriesWindow::extractSeries(QVector<int> &series)
+{
+    const int frameCount = rawFrames.frameCount();
+    const int node = txSpinBox->value() * rxCount + rxSpinBox->value();
+    if (frameCount == 0 || node >= rawFrames.frameSize()) {
+        return false;
+    }
+
+    // 从帧存储中跨步取出该节点的值：原始数据按无符号显示，信号数据按有符号显示
+    gatherBuffer.resize(frameCount);
+    series.resize(frameCount);
+    const bool signal = (dataComboBox->currentIndex() == 1);
+    if (signal && signalFrames.frameCount() == frameCount) {
+        signalFrames.gatherNode(node, 0, frameCount, gatherBuffer.data());
+    } else {
+        rawFrames.gatherNode(node, 0, frameCount, gatherBuffer.data());
+    }
+
+    if (!signal) {
+        for (int i = 0; i < frameCount; ++i) {
+            series[i] = quint16(gatherBuffer[i]);
+        }
+    } else if (signalFrames.frameCount() == frameCount) {
+        std::copy(gatherBuffer.constBegin(), gatherBuffer.constEnd(), series.begin());
+    } else if (baselineData.size() == rawFrames.frameSize()) {
+        // 与主界面的信号计算相同，按 16 位回绕
+        const qint16 base = baselineData[node];
+        for (int i = 0; i < frameCount; ++i) {
+            series[i] = (signalCalcMode == 0) ? qint16(base - gatherBuffer[i]) : qint16(gatherBuffer[i] - base);
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void NodeSeriesWindow::refreshSeries()
+{
+    const QString key = QStringLiteral("%1,%2,%3")
+        .arg(txSpinBox->value()).arg(rxSpinBox->value()).arg(dataComboBox->currentIndex());
+    if (key == sourceKey) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QVector<int> series;
+    if (!extractSeries(series)) {
+        sourceKey.clear();
+        plot->clearSeries();
+        statusLabel->setText(tr("没有数据"));
+        return;
+    }
+    const qint64 extractUs = timer.nsecsElapsed() / 1000;
+    sourceKey = key;
+
+    // 切换节点时保留当前的缩放范围，方便对比相邻节点
+    plot->setSeries(series, true);
+    plot->setLabel(tr("TX%1 / RX%2 %3").arg(txSpinBox->value()).arg(rxSpinBox->value())
+                   .arg(dataComboBox->currentText()));
+
+    double sum = 0.0;
+    double squares = 0.0;
+    int low = series[0];
+    int high = series[0];
+    for (int value : series) {
+        sum += value;
+        squares += double(value) * value;
+        low = qMin(low, value);
+        high = qMax(high, value);
+    }
+    const double mean = sum / series.size();
+    const double deviation = std::sqrt(qMax(0.0, squares / series.size() - mean * mean));
+    statusLabel->setText(tr("%1 帧  最小 %2  最大 %3  均值 %4  标准差 %5  提取 %6 ms")
+                         .arg(series.size()).arg(low).arg(high)
+                         .arg(mean, 0, 'f', 1).arg(deviation, 0, 'f', 2)
+                         .arg(extractUs / 1000.0, 0, 'f', 1));
+}
@@ -0,0 +1,61 @@
+#ifndef NODESERIESWINDOW_H
+#define NODESERIESWINDOW_H
+
+#include <QWidget>
+#include <QVector>
+#include "framestore.h"
+
+class NodeSeriesPlot;
+class QComboBox;
+class QHideEvent;
+class QLabel;
+class QSpinBox;
+
+// 节点时序窗口：显示一个节点在整段采集中每一帧的原始值或信号值，
+// 在主界面表格中双击节点或在热力图上单击节点时打开；单击曲线让主界面跳到该帧
+class NodeSeriesWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit NodeSeriesWindow(QWidget *parent = nullptr);
+
+    // 设置数据（帧存储为隐式共享，复制开销很小）；processed 为处理链整段处理好的信号，
+    // 帧数与 raw 不一致时按 baseline 和 calcMode（0 = base-raw，1 = raw-base）逐帧计算信号
+    void setSource(const FrameStore &raw, const FrameStore &processed, const QVector<qint16> &baseline,
+                   int calcMode, int rx, int tx);
+    void showNode(int rx, int tx, bool signal);
+    void setCurrentFrame(int frame);
+
+    // 页面换出冷数据前放下帧存储的副本，换出后再共享内容相同的帧存储，原来的数据块才能释放
+    void releaseFrames();
+    void shareFrames(const FrameStore &raw, const FrameStore &processed);
+
+signals:
+    void frameRequested(int frame);
+
+protected:
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void refreshSeries();
+
+private:
+    bool extractSeries(QVector<int> &series);
+
+    FrameStore rawFrames;
+    FrameStore signalFrames;
+    QVector<qint16> baselineData;
+    int signalCalcMode;
+    int rxCount;
+    QString sourceKey;                 // 当前曲线对应的节点和数据，相同时切换不重新提取
+    QVector<qint16> gatherBuffer;      // 提取缓冲，跨节点复用
+
+    QSpinBox *txSpinBox;
+    QSpinBox *rxSpinBox;
+    QComboBox *dataComboBox;
+    QLabel *statusLabel;
+    NodeSeriesPlot *plot;
+};
+
+#endif // NODESERIESWINDOW_H
@@ -0,0 +1,226 @@
+#include "noisespectrum.h"
+#include "framestore.h"
+#include <QElapsedTimer>
+#include <QtConcurrent>
+#include <cmath>
+
+// 每个并行任务处理的节点数（偶数，两两拼成一次复数 FFT）
+static const int kNodeBlock = 32;
+
+// 转置时每次处理的帧数：kFrameBlock 帧 x kNodeBlock 节点的小块在缓存内完成读写
+static const int kFrameBlock = 64;
+
+// 最大 FFT 点数（结果按节点保存完整频谱，40x70 时约 90 MB）
+static const int kMaxWindowFrames = 1 << 14;
+
+namespace {
+
+// 固定点数的 FFT 参数，所有节点共用
+struct FftPlan
+{
+    explicit FftPlan(int n);
+
+    int size;
+    QVector<int> bitReverse;
+    QVector<float> twiddleRe;      // e^{-2πik/n}，k < n/2
+    QVector<float> twiddleIm;
+    QVector<float> window;         // Hann 窗
+    float amplitudeScale;          // 单边幅度 = |X[k]| * amplitudeScale（直流和奈奎斯特点再减半）
+};
+
+FftPlan::FftPlan(int n)
+    : size(n)
+    , bitReverse(n)
+    , twiddleRe(n / 2)
+    , twiddleIm(n / 2)
+    , window(n)
+{
+    int bits = 0;
+    while ((1 << bits) < n) {
+        ++bits;
+    }
+    for (int i = 0; i < n; ++i) {
+        int reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            reversed |= ((i >> b) & 1) << (bits - 1 - b);
+        }
+        bitReverse[i] = reversed;
+    }
+
+    const double pi = 3.14159265358979323846;
+    for (int k = 0; k < n / 2; ++k) {
+        twiddleRe[k] = float(std::cos(2.0 * pi * k / n));
+        twiddleIm[k] = float(-std::sin(2.0 * pi * k / n));
+    }
+
+    double windowSum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        window[i] = float(0.5 - 0.5 * std::cos(2.0 * pi * i / n));
+        windowSum += window[i];
+    }
+    amplitudeScale = float(2.0 / windowSum);
+}
+
+// 原位基 2 FFT，输入已按位反转顺序排列
+void transform(const FftPlan &plan, float *re, float *im)
+{
+    const int n = plan.size;
+    const float *wr = plan.twiddleRe.constData();
+    const float *wi = plan.twiddleIm.constData();
+    for (int length = 2; length <= n; length <<= 1) {
+        const int half = length / 2;
+        const int step = n / length;
+        for (int start = 0; start < n; start += length) {
+            float *aRe = re + start;
+            float *aIm = im + start;
+            float *bRe = aRe + half;
+            float *bIm = aIm + half;
+            for (int k = 0; k < half; ++k) {
+                const float cr = wr[k * step];
+                const float ci = wi[k * step];
+                const float tr = bRe[k] * cr - bIm[k] * ci;
+                const float ti = bRe[k] * ci + bIm[k] * cr;
+                bRe[k] = aRe[k] - tr;
+                bIm[k] = aIm[k] - ti;
+                aRe[k] += tr;
+                aIm[k] += ti;
+            }
+        }
+    }
+}
+
+// 去均值、加窗并按位反转顺序写入
+void loadSeries(const FftPlan &plan, const float *series, float *out)
+{
+    const int n = plan.size;
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        sum += series[i];
+    }
+    const float mean = float(sum / n);
+    for (int i = 0; i < n; ++i) {
+        out[plan.bitReverse[i]] = (series[i] - mean) * plan.window[i];
+    }
+}
+
+// 处理 [nodeBegin, nodeEnd) 的节点：分块转置成节点优先序列，再两两做复数 FFT 并拆出各自的幅度谱
+void processNodes(const FrameStore &frames, const FftPlan &plan, int firstFrame, int nodeBegin, int nodeEnd,
+                  float *spectra, int *dominantBins)
+{
+    const int n = plan.size;
+    const int bins = n / 2 + 1;
+    const int count = nodeEnd - nodeBegin;
+
+    QVector<float> series(count * n);
+    for (int f0 = 0; f0 < n; f0 += kFrameBlock) {
+        const int f1 = qMin(n, f0 + kFrameBlock);
+        for (int f = f0; f < f1; ++f) {
+            const qint16 *row = frames.frame(firstFrame + f) + nodeBegin;
+            float *column = series.data() + f;
+            for (int j = 0; j < count; ++j) {
+                column[j * n] = row[j];
+            }
+        }
+    }
+
+    QVector<float> re(n);
+    QVector<float> im(n);
+    for (int j = 0; j < count; j += 2) {
+        const bool hasPair = (j + 1 < count);
+        loadSeries(plan, series.constData() + j * n, re.data());
+        if (hasPair) {
+            loadSeries(plan, series.constData() + (j + 1) * n, im.data());
+        } else {
+            im.fill(0.0f);
+        }
+        transform(plan, re.data(), im.data());
+
+        // z = x + iy：X[k] = (Z[k] + conj(Z[n-k])) / 2，Y[k] = (Z[k] - conj(Z[n-k])) / 2i
+        float *first = spectra + qint64(j) * bins;
+        float *second = hasPair ? first + bins : nullptr;
+        for (int k = 0; k < bins; ++k) {
+            const int mirror = (n - k) & (n - 1);
+            const float edgeScale = (k == 0 || k == n / 2) ? 0.5f : 1.0f;
+            const float scale = 0.5f * plan.amplitudeScale * edgeScale;
+            const float xr = re[k] + re[mirror];
+            const float xi = im[k] - im[mirror];
+            first[k] = scale * std::sqrt(xr * xr + xi * xi);
+            if (second) {
+                const float yr = im[k] + im[mirror];
+                const float yi = re[mirror] - re[k];
+                second[k] = scale * std::sqrt(yr * yr + yi * yi);
+            }
+        }
+
+        for (int node = j; node < j + (hasPair ? 2 : 1); ++node) {
+            const float *spectrum = spectra + qint64(node) * bins;
+            int best = 1;
+            for (int k = 2; k < bins; ++k) {
+                if (spectrum[k] > spectrum[best]) {
+                    best = k;
+                }
+            }
+            dominantBins[node] = best;
+        }
+    }
+}
+
+} // namespace
+
+bool NoiseSpectrum::isValidWindow(int windowFrames)
+{
+    return windowFrames >= 4 && windowFrames <= kMaxWindowFrames && (windowFrames & (windowFrames - 1)) == 0;
+}
+
+NoiseSpectrumResult NoiseSpectrum::analyze(const FrameStore &frames, int firstFrame, int windowFrames,
+                                           double sampleRateHz)
+{
+    NoiseSpectrumResult result;
+    const int nodeCount = frames.frameSize();
+    if (!isValidWindow(windowFrames) || sampleRateHz <= 0.0 || nodeCount <= 0
+        || firstFrame < 0 || firstFrame + windowFrames > frames.frameCount()) {
+        return result;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    const int bins = windowFrames / 2 + 1;
+    result.firstFrame = firstFrame;
+    result.windowFrames = windowFrames;
+    result.sampleRateHz = sampleRateHz;
+    result.nodeCount = nodeCount;
+    result.binCount = bins;
+    result.nodeSpectra.resize(nodeCount * bins);
+    result.dominantBins.resize(nodeCount);
+
+    const FftPlan plan(windowFrames);
+    QVector<int> blockStarts;
+    for (int node = 0; node < nodeCount; node += kNodeBlock) {
+        blockStarts.append(node);
+    }
+
+    // 各块写入互不重叠的区域；并行前取出可写指针，避免在工作线程中分离共享数据
+    float *spectra = result.nodeSpectra.data();
+    int *dominantBins = result.dominantBins.data();
+    QtConcurrent::blockingMap(blockStarts, [&](int &nodeBegin) {
+        const int nodeEnd = qMin(nodeCount, nodeBegin + kNodeBlock);
+        processNodes(frames, plan, firstFrame, nodeBegin, nodeEnd,
+                     spectra + qint64(nodeBegin) * bins, dominantBins + nodeBegin);
+    });
+
+    result.meanSpectrum.fill(0.0f, bins);
+    float *mean = result.meanSpectrum.data();
+    for (int node = 0; node < nodeCount; ++node) {
+        const float *spectrum = spectra + qint64(node) * bins;
+        for (int k = 0; k < bins; ++k) {
+            mean[k] += spectrum[k];
+        }
+    }
+    for (int k = 0; k < bins; ++k) {
+        mean[k] /= nodeCount;
+    }
+
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
@@ -0,0 +1,38 @@
+#ifndef NOISESPECTRUM_H
+#define NOISESPECTRUM_H
+
+#include <QVector>
+
+class FrameStore;
+
+// 一段帧窗口内每个节点的噪声频谱（幅度，单位与数据相同）
+struct NoiseSpectrumResult
+{
+    int firstFrame = 0;
+    int windowFrames = 0;          // FFT 点数（2 的幂）
+    double sampleRateHz = 0.0;
+    int nodeCount = 0;
+    int binCount = 0;              // windowFrames / 2 + 1
+    QVector<float> nodeSpectra;    // 按节点排列，每个节点 binCount 项
+    QVector<float> meanSpectrum;   // 所有节点的平均幅度
+    QVector<int> dominantBins;     // 每个节点除直流外幅度最大的频点
+    qint64 elapsedMs = 0;
+
+    bool isValid() const { return binCount > 0 && nodeCount > 0; }
+    double binFrequency(int bin) const { return bin * sampleRateHz / windowFrames; }
+    const float *nodeSpectrum(int node) const { return nodeSpectra.constData() + qint64(node) * binCount; }
+};
+
+// 逐节点噪声频谱：窗口内的帧按节点分块转置成节点优先的序列（块内连续读写，适合缓存），
+// 去均值并加 Hann 窗后做实数 FFT；两个节点拼成一次复数 FFT，各节点块在线程池中并行处理
+class NoiseSpectrum
+{
+public:
+    static bool isValidWindow(int windowFrames);
+
+    // 分析 frames 中 [firstFrame, firstFrame + windowFrames) 的帧；窗口越界或点数不是 2 的幂时返回无效结果
+    static NoiseSpectrumResult analyze(const FrameStore &frames, int firstFrame, int windowFrames,
+                                       double sampleRateHz);
+};
+
+#endif // NOISESPECTRUM_H
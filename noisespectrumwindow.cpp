@@ -0,0 +1,267 @@
+#include "noisespectrumwindow.h"
+#include "heatmapview.h"
+#include "spectrumplot.h"
+#include <QComboBox>
+#include <QDoubleSpinBox>
+#include <QHBoxLayout>
+#include <QHideEvent>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+
+// 可选的 FFT 点数范围（2 的幂）
+static const int kMinWindowFrames = 256;
+static const int kMaxWindowFrames = 16384;
+static const int kDefaultWindowFrames = 4096;
+
+// 热力图的数值以 0.1 为单位保存到 qint16
+static const double kMapScale = 10.0;
+
+NoiseSpectrumWindow::NoiseSpectrumWindow(QWidget *parent)
+    : QWidget(parent, Qt::Window)
+    , rxCount(0)
+    , txCount(0)
+    , reverseRx(false)
+    , selectedNode(-1)
+    , selectedBin(-1)
+    , watcher(nullptr)
+{
+    setWindowTitle(tr("噪声频谱"));
+    resize(1100, 480);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    QHBoxLayout *toolLayout = new QHBoxLayout;
+    toolLayout->addWidget(new QLabel(tr("窗口帧数:"), this));
+    windowComboBox = new QComboBox(this);
+    for (int frames = kMinWindowFrames; frames <= kMaxWindowFrames; frames *= 2) {
+        windowComboBox->addItem(QString::number(frames), frames);
+    }
+    windowComboBox->setCurrentIndex(windowComboBox->findData(kDefaultWindowFrames));
+    toolLayout->addWidget(windowComboBox);
+    toolLayout->addWidget(new QLabel(tr("起始帧:"), this));
+    startFrameSpinBox = new QSpinBox(this);
+    startFrameSpinBox->setMinimum(1);
+    toolLayout->addWidget(startFrameSpinBox);
+    toolLayout->addWidget(new QLabel(tr("帧率 (Hz):"), this));
+    sampleRateSpinBox = new QDoubleSpinBox(this);
+    sampleRateSpinBox->setRange(1.0, 100000.0);
+    sampleRateSpinBox->setDecimals(1);
+    sampleRateSpinBox->setValue(120.0);
+    toolLayout->addWidget(sampleRateSpinBox);
+    analyzeButton = new QPushButton(tr("分析"), this);
+    toolLayout->addWidget(analyzeButton);
+    toolLayout->addWidget(new QLabel(tr("热力图:"), this));
+    mapModeComboBox = new QComboBox(this);
+    mapModeComboBox->addItem(tr("主噪声频率"));
+    mapModeComboBox->addItem(tr("选中频点幅度"));
+    toolLayout->addWidget(mapModeComboBox);
+    toolLayout->addStretch();
+    statusLabel = new QLabel(this);
+    toolLayout->addWidget(statusLabel);
+    mainLayout->addLayout(toolLayout);
+
+    QHBoxLayout *viewsLayout = new QHBoxLayout;
+    spectrumPlot = new SpectrumPlot(this);
+    viewsLayout->addWidget(spectrumPlot, 3);
+    heatmapView = new HeatmapView(this);
+    viewsLayout->addWidget(heatmapView, 2);
+    mainLayout->addLayout(viewsLayout, 1);
+
+    // 窗口帧数变化时，起始帧的范围随之变化
+    connect(windowComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this]() {
+        const int window = windowComboBox->currentData().toInt();
+        startFrameSpinBox->setMaximum(qMax(1, frames.frameCount() - window + 1));
+    });
+    connect(analyzeButton, &QPushButton::clicked, this, &NoiseSpectrumWindow::onAnalyzeClicked);
+    connect(mapModeComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &NoiseSpectrumWindow::refreshHeatmap);
+    connect(heatmapView, &HeatmapView::cellClicked, this, &NoiseSpectrumWindow::onNodeClicked);
+    connect(spectrumPlot, &SpectrumPlot::binSelected, this, &NoiseSpectrumWindow::onBinSelected);
+}
+
+NoiseSpectrumWindow::~NoiseSpectrumWindow()
+{
+    if (watcher) {
+        watcher->waitForFinished();
+    }
+}
+
+void NoiseSpectrumWindow::setSource(const FrameStore &source, int currentFrame, double sampleRateHz,
+                                    int rx, int tx, bool reverse)
+{
+    frames = source;
+    rxCount = rx;
+    txCount = tx;
+    reverseRx = reverse;
+
+    // 只允许不超过总帧数的窗口；当前窗口放不下时退到不超过 4096 的最大可用窗口
+    const int frameCount = frames.frameCount();
+    int preferred = -1;
+    for (int i = 0; i < windowComboBox->count(); ++i) {
+        const int window = windowComboBox->itemData(i).toInt();
+        const bool fits = (window <= frameCount);
+        windowComboBox->setItemData(i, fits ? QVariant() : QVariant(0), Qt::UserRole - 1);
+        if (fits && window <= kDefaultWindowFrames) {
+            preferred = i;
+        }
+    }
+    if (preferred >= 0 && windowComboBox->currentData().toInt() > frameCount) {
+        windowComboBox->setCurrentIndex(preferred);
+    }
+
+    const int window = windowComboBox->currentData().toInt();
+    startFrameSpinBox->setMaximum(qMax(1, frameCount - window + 1));
+    startFrameSpinBox->setValue(qBound(1, currentFrame + 1, startFrameSpinBox->maximum()));
+    if (sampleRateHz > 0.0) {
+        sampleRateSpinBox->setValue(sampleRateHz);
+    }
+
+    analyzeButton->setEnabled(preferred >= 0 && watcher == nullptr);
+    if (preferred < 0) {
+        statusLabel->setText(tr("帧数不足 %1，无法分析").arg(kMinWindowFrames));
+    }
+}
+
+void NoiseSpectrumWindow::releaseFrames()
+{
+    frames = FrameStore();
+}
+
+void NoiseSpectrumWindow::shareFrames(const FrameStore &source)
+{
+    frames = source;
+}
+
+void NoiseSpectrumWindow::hideEvent(QHideEvent *event)
+{
+    // 关闭后不再持有帧数据（后台任务有自己的副本），重新打开时页面会重新设置；最小化时保留
+    if (!event->spontaneous()) {
+        releaseFrames();
+    }
+    QWidget::hideEvent(event);
+}
+
+void NoiseSpectrumWindow::onAnalyzeClicked()
+{
+    const int window = windowComboBox->currentData().toInt();
+    const int firstFrame = startFrameSpinBox->value() - 1;
+    if (watcher || firstFrame + window > frames.frameCount()) {
+        return;
+    }
+    if (frames.frameSize() != rxCount * txCount) {
+        QMessageBox::warning(this, tr("参数错误"), tr("RX × TX 与数据的节点数不一致！"));
+        return;
+    }
+
+    const FrameStore source = frames;
+    const double sampleRate = sampleRateSpinBox->value();
+    watcher = new QFutureWatcher<NoiseSpectrumResult>(this);
+    connect(watcher, &QFutureWatcher<NoiseSpectrumResult>::finished, this, &NoiseSpectrumWindow::onAnalysisFinished);
+    watcher->setFuture(QtConcurrent::run([source, firstFrame, window, sampleRate]() {
+        return NoiseSpectrum::analyze(source, firstFrame, window, sampleRate);
+    }));
+
+    analyzeButton->setEnabled(false);
+    statusLabel->setText(tr("正在分析..."));
+}
+
+void NoiseSpectrumWindow::onAnalysisFinished()
+{
+    result = watcher->result();
+    watcher->deleteLater();
+    watcher = nullptr;
+    analyzeButton->setEnabled(true);
+
+    if (!result.isValid()) {
+        statusLabel->setText(tr("分析失败"));
+        spectrumPlot->clearSpectra();
+        heatmapView->clearFrame();
+        return;
+    }
+
+    // 默认选中平均谱中最强的频点，以及主频幅度最大的节点
+    selectedBin = 1;
+    for (int k = 2; k < result.binCount; ++k) {
+        if (result.meanSpectrum[k] > result.meanSpectrum[selectedBin]) {
+            selectedBin = k;
+        }
+    }
+    selectedNode = 0;
+    float strongest = -1.0f;
+    for (int node = 0; node < result.nodeCount; ++node) {
+        const float amplitude = result.nodeSpectrum(node)[result.dominantBins[node]];
+        if (amplitude > strongest) {
+            strongest = amplitude;
+            selectedNode = node;
+        }
+    }
+
+    statusLabel->setText(tr("第 %1 ~ %2 帧  分辨率 %3 Hz  耗时 %4 ms")
+        .arg(result.firstFrame + 1)
+        .arg(result.firstFrame + result.windowFrames)
+        .arg(result.binFrequency(1), 0, 'f', 3)
+        .arg(result.elapsedMs));
+    spectrumPlot->setSelectedBin(selectedBin);
+    refreshSpectrum();
+    refreshHeatmap();
+}
+
+void NoiseSpectrumWindow::onNodeClicked(int rx, int tx)
+{
+    if (!result.isValid() || rx >= rxCount || tx >= txCount) {
+        return;
+    }
+    selectedNode = tx * rxCount + rx;
+    refreshSpectrum();
+}
+
+void NoiseSpectrumWindow::onBinSelected(int bin)
+{
+    selectedBin = bin;
+    if (mapModeComboBox->currentIndex() == 1) {
+        refreshHeatmap();
+    }
+}
+
+void NoiseSpectrumWindow::refreshSpectrum()
+{
+    if (!result.isValid()) {
+        return;
+    }
+    const bool hasNode = (selectedNode >= 0 && selectedNode < result.nodeCount);
+    spectrumPlot->setSpectra(result.meanSpectrum.constData(),
+                             hasNode ? result.nodeSpectrum(selectedNode) : nullptr,
+                             result.binCount, result.binFrequency(1));
+    if (hasNode && rxCount > 0) {
+        const int rx = selectedNode % rxCount;
+        const int tx = selectedNode / rxCount;
+        spectrumPlot->setNodeLabel(tr("RX%1 TX%2（主频 %3 Hz）")
+            .arg(rx).arg(tx)
+            .arg(result.binFrequency(result.dominantBins[selectedNode]), 0, 'f', 2));
+    }
+}
+
+void NoiseSpectrumWindow::refreshHeatmap()
+{
+    if (!result.isValid() || result.nodeCount != rxCount * txCount) {
+        heatmapView->clearFrame();
+        return;
+    }
+
+    const bool dominantMode = (mapModeComboBox->currentIndex() == 0);
+    mapData.resize(result.nodeCount);
+    for (int node = 0; node < result.nodeCount; ++node) {
+        const double value = dominantMode ? result.binFrequency(result.dominantBins[node])
+                                          : result.nodeSpectrum(node)[qMax(0, selectedBin)];
+        mapData[node] = qint16(qMin(32767.0, value * kMapScale + 0.5));
+    }
+
+    if (dominantMode) {
+        heatmapView->setTitle(tr("主噪声频率（单位 0.1 Hz）"));
+    } else {
+        heatmapView->setTitle(tr("%1 Hz 处的幅度（单位 0.1）").arg(result.binFrequency(selectedBin), 0, 'f', 2));
+    }
+    heatmapView->setFrame(mapData.constData(), rxCount, txCount, HeatmapRenderer::Sequential, reverseRx);
+}
@@ -0,0 +1,71 @@
+#ifndef NOISESPECTRUMWINDOW_H
+#define NOISESPECTRUMWINDOW_H
+
+#include <QWidget>
+#include <QVector>
+#include <QFutureWatcher>
+#include "framestore.h"
+#include "noisespectrum.h"
+
+class HeatmapView;
+class SpectrumPlot;
+class QComboBox;
+class QHideEvent;
+class QDoubleSpinBox;
+class QLabel;
+class QPushButton;
+class QSpinBox;
+
+// 噪声频谱窗口：对触摸数据的一段帧窗口做逐节点 FFT（后台线程），
+// 左侧显示平均谱和选中节点的谱，右侧热力图显示每个节点的主噪声频率或选中频点的幅度
+class NoiseSpectrumWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit NoiseSpectrumWindow(QWidget *parent = nullptr);
+    ~NoiseSpectrumWindow();
+
+    // 设置分析的数据（帧存储为隐式共享，复制开销很小）；不会自动开始分析
+    void setSource(const FrameStore &frames, int currentFrame, double sampleRateHz,
+                   int rx, int tx, bool reverse);
+
+    // 页面换出冷数据前放下帧存储的副本，换出后再共享内容相同的帧存储，原来的数据块才能释放
+    void releaseFrames();
+    void shareFrames(const FrameStore &source);
+
+protected:
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void onAnalyzeClicked();
+    void onAnalysisFinished();
+    void onNodeClicked(int rx, int tx);
+    void onBinSelected(int bin);
+    void refreshHeatmap();
+
+private:
+    void refreshSpectrum();
+
+    FrameStore frames;
+    int rxCount;
+    int txCount;
+    bool reverseRx;
+
+    NoiseSpectrumResult result;
+    int selectedNode;
+    int selectedBin;
+    QVector<qint16> mapData;           // 热力图数据（0.1 Hz 或 0.1 幅度单位）
+    QFutureWatcher<NoiseSpectrumResult> *watcher;
+
+    QComboBox *windowComboBox;
+    QSpinBox *startFrameSpinBox;
+    QDoubleSpinBox *sampleRateSpinBox;
+    QPushButton *analyzeButton;
+    QComboBox *mapModeComboBox;
+    QLabel *statusLabel;
+    SpectrumPlot *spectrumPlot;
+    HeatmapView *heatmapView;
+};
+
+#endif // NOISESPECTRUMWINDOW_H
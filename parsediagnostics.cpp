@@ -0,0 +1,61 @@
+#include "parsediagnostics.h"
+#include <QCoreApplication>
+#include <QStringList>
+#include <algorithm>
+
+void ParseDiagnostics::clear()
+{
+    items.clear();
+    std::fill(reasonCounts, reasonCounts + ReasonCount, 0);
+    total = 0;
+}
+
+void ParseDiagnostics::record(qint64 offset, quint32 line, int column, Reason reason, int stream, int frame)
+{
+    ++total;
+    ++reasonCounts[reason];
+    if (items.size() >= kMaxEntries) {
+        return;
+    }
+
+    Entry entry;
+    entry.offset = offset;
+    entry.line = line;
+    entry.frame = frame;
+    entry.column = quint16(qBound(0, column, 0xFFFF));
+    entry.reason = reason;
+    entry.stream = quint8(qBound(0, stream, 0xFF));
+    items.append(entry);
+}
+
+QString ParseDiagnostics::reasonText(Reason reason)
+{
+    switch (reason) {
+    case MissingDataLine:
+        return QCoreApplication::translate("ParseDiagnostics", "缺少数据行");
+    case EmptyLine:
+        return QCoreApplication::translate("ParseDiagnostics", "数据行为空");
+    case TooFewColumns:
+        return QCoreApplication::translate("ParseDiagnostics", "列数不足");
+    case BadHex:
+        return QCoreApplication::translate("ParseDiagnostics", "非法十六进制");
+    case BadTimestamp:
+        return QCoreApplication::translate("ParseDiagnostics", "时间戳无效");
+    case BadSequence:
+        return QCoreApplication::translate("ParseDiagnostics", "帧序号无效");
+    default:
+        return QString();
+    }
+}
+
+QString ParseDiagnostics::summary() const
+{
+    QStringList parts;
+    for (int reason = None + 1; reason < ReasonCount; ++reason) {
+        if (reasonCounts[reason] > 0) {
+            parts << QCoreApplication::translate("ParseDiagnostics", "%1 %2 行")
+                         .arg(reasonText(Reason(reason))).arg(reasonCounts[reason]);
+        }
+    }
+    return parts.join(QCoreApplication::translate("ParseDiagnostics", "，"));
+}
@@ -0,0 +1,52 @@
+#ifndef PARSEDIAGNOSTICS_H
+#define PARSEDIAGNOSTICS_H
+
+#include <QString>
+#include <QVector>
+
+// 解析诊断：匹配了帧头却没能存成帧的行，按行记录位置和原因（紧凑的定长记录，放在解析结果旁边）
+// 只在出错的慢路径上写入，正常行不经过这里；记录数有上限，超出后只计数
+class ParseDiagnostics
+{
+public:
+    enum Reason : quint8 {
+        None = 0,
+        MissingDataLine,     // 帧头在最后一行，没有下一行数据（下一行模式）
+        EmptyLine,           // 数据行为空
+        TooFewColumns,       // 列数不足 rawDataPos + rx*tx*2
+        BadHex,              // 数据列不是合法的十六进制字节
+        BadTimestamp,        // 时间戳列缺失或不是十六进制
+        BadSequence,         // 帧序号列缺失或不是十六进制
+        ReasonCount
+    };
+
+    struct Entry
+    {
+        qint64 offset;       // 出错行在文件中的字节偏移
+        quint32 line;        // 行号（从 1 开始；二进制格式为记录序号）
+        qint32 frame;        // 出错时该扫描类型已存的帧数，即出错行之后第一帧的索引
+        quint16 column;      // 出错的列（从 0 开始；二进制格式为字节偏移）；整行问题时为 0
+        quint8 reason;
+        quint8 stream;       // 扫描类型（readStreams 中帧头的序号）
+    };
+
+    static const int kMaxEntries = 65536;
+
+    void clear();
+    void record(qint64 offset, quint32 line, int column, Reason reason, int stream, int frame);
+
+    bool isEmpty() const { return total == 0; }
+    qint64 totalCount() const { return total; }                  // 包括超出上限未保存的
+    qint64 count(Reason reason) const { return reasonCounts[reason]; }
+    const QVector<Entry> &entries() const { return items; }
+
+    QString summary() const;                 // 按原因汇总的一行文字，如"列数不足 3 行，非法十六进制 1 行"
+    static QString reasonText(Reason reason);
+
+private:
+    QVector<Entry> items;
+    qint64 reasonCounts[ReasonCount] = {};
+    qint64 total = 0;
+};
+
+#endif // PARSEDIAGNOSTICS_H
@@ -0,0 +1,213 @@
+#include "parsediagnosticswindow.h"
+#include "touchinputreader.h"
+#include <QColor>
+#include <QFile>
+#include <QFontDatabase>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QTableView>
+#include <QVBoxLayout>
+
+// 预览时最多读出的字节数（数据行可能很长，只看开头已足够定位）
+static const int kMaxPreviewBytes = 4096;
+// 二进制记录按逗号分隔的十六进制显示，最多显示的字节数
+static const int kMaxPreviewRecordBytes = 512;
+
+ParseDiagnosticsModel::ParseDiagnosticsModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void ParseDiagnosticsModel::setDiagnostics(const ParseDiagnostics &diagnostics, const QStringList &streamNames)
+{
+    beginResetModel();
+    entries = diagnostics.entries();
+    streams = streamNames;
+    endResetModel();
+}
+
+int ParseDiagnosticsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : entries.size();
+}
+
+int ParseDiagnosticsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 5;
+}
+
+QVariant ParseDiagnosticsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    const ParseDiagnostics::Entry &item = entries[index.row()];
+    switch (index.column()) {
+    case 0:
+        return item.line;
+    case 1:
+        return item.column;
+    case 2:
+        return ParseDiagnostics::reasonText(ParseDiagnostics::Reason(item.reason));
+    case 3:
+        return item.stream < streams.size() ? streams[item.stream] : QString::number(item.stream);
+    case 4:
+        return item.frame + 1;   // 界面上的帧号从 1 开始
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ParseDiagnosticsModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    static const char *const titles[] = {QT_TR_NOOP("行号"), QT_TR_NOOP("列"), QT_TR_NOOP("原因"),
+                                          QT_TR_NOOP("扫描类型"), QT_TR_NOOP("所在帧")};
+    return section >= 0 && section < 5 ? tr(titles[section]) : QVariant();
+}
+
+ParseDiagnosticsWindow::ParseDiagnosticsWindow(QWidget *parent)
+    : QWidget(parent, Qt::Window)
+    , model(new ParseDiagnosticsModel(this))
+{
+    setWindowTitle(tr("解析诊断"));
+    resize(760, 520);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    summaryLabel = new QLabel(this);
+    summaryLabel->setWordWrap(true);
+    mainLayout->addWidget(summaryLabel);
+
+    tableView = new QTableView(this);
+    tableView->setModel(model);
+    tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    tableView->setSelectionMode(QAbstractItemView::SingleSelection);
+    tableView->verticalHeader()->hide();
+    tableView->horizontalHeader()->setStretchLastSection(true);
+    mainLayout->addWidget(tableView, 3);
+
+    lineView = new QPlainTextEdit(this);
+    lineView->setReadOnly(true);
+    lineView->setLineWrapMode(QPlainTextEdit::NoWrap);
+    lineView->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    mainLayout->addWidget(lineView, 1);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout;
+    buttonLayout->addStretch();
+    jumpButton = new QPushButton(tr("跳到该帧附近"), this);
+    jumpButton->setEnabled(false);
+    buttonLayout->addWidget(jumpButton);
+    mainLayout->addLayout(buttonLayout);
+
+    connect(tableView->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, &ParseDiagnosticsWindow::onCurrentRowChanged);
+    connect(tableView, &QTableView::doubleClicked, this, &ParseDiagnosticsWindow::onJumpClicked);
+    connect(jumpButton, &QPushButton::clicked, this, &ParseDiagnosticsWindow::onJumpClicked);
+}
+
+void ParseDiagnosticsWindow::setDiagnostics(const QString &filePath, const ParseDiagnostics &diagnostics,
+                                            const QStringList &streamNames)
+{
+    sourcePath = filePath;
+    model->setDiagnostics(diagnostics, streamNames);
+    lineView->clear();
+    jumpButton->setEnabled(false);
+
+    QString text = tr("共 %1 行被丢弃：%2").arg(diagnostics.totalCount()).arg(diagnostics.summary());
+    if (diagnostics.totalCount() > diagnostics.entries().size()) {
+        text += tr("\n（仅列出前 %1 条）").arg(diagnostics.entries().size());
+    }
+    summaryLabel->setText(text);
+    tableView->resizeColumnsToContents();
+
+    if (model->rowCount() > 0) {
+        tableView->selectRow(0);
+    }
+}
+
+void ParseDiagnosticsWindow::onCurrentRowChanged()
+{
+    const QModelIndex current = tableView->currentIndex();
+    jumpButton->setEnabled(current.isValid());
+    if (!current.isValid()) {
+        lineView->clear();
+        return;
+    }
+
+    const ParseDiagnostics::Entry &item = model->entry(current.row());
+    const QString line = readLine(item.offset);
+    lineView->setPlainText(line);
+
+    // 标出出错的列：按逗号数到第 column 个字段
+    int fieldBegin = 0;
+    for (int column = 0; column < item.column && fieldBegin >= 0; ++column) {
+        fieldBegin = line.indexOf(QLatin1Char(','), fieldBegin);
+        if (fieldBegin >= 0) {
+            ++fieldBegin;
+        }
+    }
+
+    QList<QTextEdit::ExtraSelection> selections;
+    // 字段超出预览范围（行太长）或整行问题时不标记
+    if (fieldBegin >= 0 && fieldBegin < line.size() && item.reason != ParseDiagnostics::MissingDataLine
+        && item.reason != ParseDiagnostics::EmptyLine) {
+        int fieldEnd = line.indexOf(QLatin1Char(','), fieldBegin);
+        if (fieldEnd < 0) {
+            fieldEnd = line.size();
+        }
+        QTextEdit::ExtraSelection selection;
+        selection.format.setBackground(QColor(255, 160, 160));
+        selection.cursor = QTextCursor(lineView->document());
+        selection.cursor.setPosition(fieldBegin);
+        selection.cursor.setPosition(qMax(fieldBegin + 1, fieldEnd), QTextCursor::KeepAnchor);
+        selections.append(selection);
+
+        // 把出错的字段滚动到可见处
+        QTextCursor cursor(lineView->document());
+        cursor.setPosition(fieldBegin);
+        lineView->setTextCursor(cursor);
+        lineView->ensureCursorVisible();
+    }
+    lineView->setExtraSelections(selections);
+}
+
+void ParseDiagnosticsWindow::onJumpClicked()
+{
+    const QModelIndex current = tableView->currentIndex();
+    if (!current.isValid()) {
+        return;
+    }
+    const ParseDiagnostics::Entry &item = model->entry(current.row());
+    emit frameRequested(item.stream, item.frame);
+}
+
+QString ParseDiagnosticsWindow::readLine(qint64 offset) const
+{
+    QFile file(sourcePath);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(offset)) {
+        return tr("（无法读取文件 %1）").arg(sourcePath);
+    }
+
+    QByteArray bytes = file.read(kMaxPreviewBytes);
+
+    // 二进制记录显示成与文本相同的逗号分隔形式，列号即字节偏移
+    if (TouchInputReader::detectFormat(bytes.constData(), bytes.constData() + bytes.size())
+        == ParseSettings::BinaryFormat) {
+        return QString::fromLatin1(bytes.left(kMaxPreviewRecordBytes).toHex(',').toUpper());
+    }
+
+    const int newline = bytes.indexOf('\n');
+    if (newline >= 0) {
+        bytes.truncate(newline);
+    }
+    if (bytes.endsWith('\r')) {
+        bytes.chop(1);
+    }
+    return QString::fromLocal8Bit(bytes);
+}
@@ -0,0 +1,65 @@
+#ifndef PARSEDIAGNOSTICSWINDOW_H
+#define PARSEDIAGNOSTICSWINDOW_H
+
+#include <QWidget>
+#include <QAbstractTableModel>
+#include <QStringList>
+#include "parsediagnostics.h"
+
+class QLabel;
+class QPlainTextEdit;
+class QPushButton;
+class QTableView;
+
+// 诊断记录的表格模型：文字按需生成，记录再多也不创建单元格对象
+class ParseDiagnosticsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit ParseDiagnosticsModel(QObject *parent = nullptr);
+
+    void setDiagnostics(const ParseDiagnostics &diagnostics, const QStringList &streamNames);
+    const ParseDiagnostics::Entry &entry(int row) const { return entries[row]; }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QVector<ParseDiagnostics::Entry> entries;
+    QStringList streams;
+};
+
+// 解析诊断窗口：列出读取时被丢弃的行，选中一行后从文件中读出该行原文并标出出错的列，
+// 可以跳到出错位置之后的第一帧
+class ParseDiagnosticsWindow : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ParseDiagnosticsWindow(QWidget *parent = nullptr);
+
+    void setDiagnostics(const QString &filePath, const ParseDiagnostics &diagnostics,
+                        const QStringList &streamNames);
+
+signals:
+    void frameRequested(int stream, int frame);
+
+private slots:
+    void onCurrentRowChanged();
+    void onJumpClicked();
+
+private:
+    QString readLine(qint64 offset) const;
+
+    QString sourcePath;
+    ParseDiagnosticsModel *model;
+    QLabel *summaryLabel;
+    QTableView *tableView;
+    QPlainTextEdit *lineView;
+    QPushButton *jumpButton;
+};
+
+#endif // PARSEDIAGNOSTICSWINDOW_H
@@ -0,0 +1,249 @@
+#include "parserselfcheck.h"
+#include "touchdataparser.h"
+#include "framestore.h"
+#include "allocationcounter.h"
+#include <QRandomGenerator>
+#include <QTemporaryFile>
+#include <QVector>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+const int kMaxFailuresReported = 20;
+
+// 单个字段：大部分是合法的两位十六进制数，其余覆盖旧版解析会跳过或截断的各种写法
+QString randomField(QRandomGenerator &rng)
+{
+    static const char *const oddFields[] = {
+        "", " ", "0x", "0X1f", "0x0x12", "+1A", "+0x7", "-1", "-0", "1 2", "GG", "0xZZ", "123", "1ff",
+        "ffffffff", "100000000", "000000001", "\t3C\t", " 0a ", "0", "f", "0xf", "0X", "x1", "+", "++1"
+    };
+
+    const int kind = rng.bounded(10);
+    if (kind < 6) {
+        const char *digits = rng.bounded(2) ? "0123456789ABCDEF" : "0123456789abcdef";
+        quint32 value = rng.bounded(256);
+        return QString("%1%2").arg(QChar(digits[value >> 4])).arg(QChar(digits[value & 0xF]));
+    }
+    if (kind < 8) {
+        return QString::number(rng.bounded(256), 16).prepend(rng.bounded(2) ? "0x" : "");
+    }
+    return QString::fromLatin1(oddFields[rng.bounded(int(sizeof(oddFields) / sizeof(oddFields[0])))]);
+}
+
+// 按字节随机变异（只用 ASCII，且不含换行，与按行切分后的输入一致）
+void mutate(QByteArray &line, QRandomGenerator &rng)
+{
+    static const char alphabet[] = "0123456789abcdefABCDEFxX+-, \t\r\v\fGz";
+    const int mutations = rng.bounded(4);
+    for (int m = 0; m < mutations; ++m) {
+        const int op = rng.bounded(3);
+        const char c = alphabet[rng.bounded(int(sizeof(alphabet) - 1))];
+        if (op == 0 || line.isEmpty()) {
+            line.insert(line.isEmpty() ? 0 : rng.bounded(line.size() + 1), c);
+        } else if (op == 1) {
+            line[rng.bounded(line.size())] = c;
+        } else {
+            line.remove(rng.bounded(line.size()), 1 + rng.bounded(3));
+        }
+    }
+}
+
+QString describe(const QByteArray &line, int startPos, int count, const QVector<QString> &pattern)
+{
+    QStringList values;
+    for (const QString &value : pattern) {
+        values << value;
+    }
+    return QString("line=\"%1\" startPos=%2 count=%3 pattern=[%4]")
+        .arg(QString::fromLatin1(line)).arg(startPos).arg(count).arg(values.join(' '));
+}
+
+} // namespace
+
+ParserSelfCheck::Result ParserSelfCheck::run(int iterations, quint32 seed)
+{
+    Result result;
+    QRandomGenerator rng(seed);
+    QVector<qint16> decoded(64);
+
+    for (int iteration = 0; iteration < iterations; ++iteration) {
+        // 随机的一组解析参数
+        const int rawDataPos = rng.bounded(4);
+        const int count = 2 * (1 + rng.bounded(8));
+        const int filterStartPos = rng.bounded(3);
+        QVector<QString> pattern;
+        for (int i = rng.bounded(4); i > 0; --i) {
+            pattern.append(randomField(rng));
+        }
+        const bool isBigEndian = rng.bounded(2);
+
+        // 生成一行：字段数在 count 附近浮动，覆盖列数不足的情况
+        QStringList fields;
+        const int fieldCount = qMax(0, rawDataPos + count + rng.bounded(5) - 2);
+        for (int i = 0; i < fieldCount; ++i) {
+            fields << randomField(rng);
+        }
+        QByteArray line = fields.join(',').toLatin1();
+        mutate(line, rng);
+
+        const QString text = QString::fromLatin1(line);
+        const QVector<QByteArray> normalized = TouchDataParser::normalizePattern(pattern);
+        const char *begin = line.constData();
+        const char *end = begin + line.size();
+
+        // 快速路径（统计分配）
+        AllocationScope scope;
+        const bool fastMatch = TouchDataParser::matchLine(begin, end, filterStartPos, normalized);
+        const int fastCount = TouchDataParser::decodeLine(begin, end, rawDataPos, count, isBigEndian,
+                                                          decoded.data());
+        const quint64 allocations = scope.allocations();
+
+        // 诊断：整行都能解析时不应报告错误，反之必须指出一个错误
+        int column = 0;
+        const bool diagnosedOk = TouchDataParser::diagnoseLine(begin, end, rawDataPos, count, column)
+                                 == ParseDiagnostics::None;
+        const bool diagnoseSame = diagnosedOk == (fastCount == count / 2);
+
+        // 参考实现
+        const bool referenceMatch = TouchDataParser::matchFilterPattern(text.split(','), filterStartPos, pattern);
+        const QVector<qint16> reference = TouchDataParser::parseCSVLine(text, rawDataPos, count, isBigEndian);
+
+        bool same = fastMatch == referenceMatch && fastCount == reference.size()
+            && std::memcmp(decoded.constData(), reference.constData(), size_t(fastCount) * sizeof(qint16)) == 0;
+
+        ++result.casesRun;
+        if (!same) {
+            ++result.mismatches;
+        }
+        if (!diagnoseSame) {
+            ++result.diagnoseMismatches;
+        }
+        if (allocations > 0) {
+            ++result.allocatingCases;
+        }
+        if ((!same || !diagnoseSame || allocations > 0) && result.failures.size() < kMaxFailuresReported) {
+            result.failures << QString("%1%2%3 %4")
+                .arg(same ? "" : "MISMATCH")
+                .arg(diagnoseSame ? "" : " DIAGNOSE")
+                .arg(allocations > 0 ? QString(" ALLOC(%1)").arg(allocations) : QString())
+                .arg(describe(line, rawDataPos, count, pattern));
+        }
+    }
+    return result;
+}
+
+void ParserSelfCheck::checkInputFormats(int files, quint32 seed, Result &result)
+{
+    QRandomGenerator rng(seed ^ 0x5A5A5A5Au);
+
+    for (int file = 0; file < files; ++file) {
+        // 文本的每一列对应二进制记录的一个字节，同一组参数对两种格式都成立
+        ParseSettings settings;
+        settings.rxCount = 1 + rng.bounded(20);
+        settings.txCount = 1 + rng.bounded(40);
+        settings.isBigEndian = rng.bounded(2);
+        settings.filterStartPos = rng.bounded(3);
+        settings.timestampPos = settings.filterStartPos + 2;
+        settings.timestampBytes = 1 + rng.bounded(4);
+        settings.sequencePos = settings.timestampPos + settings.timestampBytes;
+        settings.sequenceBytes = 2;
+        settings.rawDataPos = settings.sequencePos + settings.sequenceBytes + rng.bounded(2);
+        const QVector<QVector<QString>> patterns = {{"AA", "55"}, {"aa", "0x66"}};
+        const int recordSize = settings.rawDataPos + settings.frameSize() * 2;
+
+        // 两种扫描类型交织，夹杂无关的行（二进制中为记录之间的附加字节），文件末尾留一条不完整的记录
+        QByteArray text;
+        QByteArray binary;
+        const int records = 50 + rng.bounded(200);
+        for (int r = 0; r < records; ++r) {
+            QByteArray record(recordSize, '\0');
+            for (int i = 0; i < recordSize; ++i) {
+                record[i] = char(rng.bounded(256));
+            }
+            record[settings.filterStartPos] = char(0xAA);
+            record[settings.filterStartPos + 1] = char(rng.bounded(2) ? 0x66 : 0x55);
+            if (settings.filterStartPos > 0) {
+                record[0] = char(0x11);   // 避免帧头前的字节与帧头组成另一个匹配
+            }
+
+            QStringList fields;
+            for (int i = 0; i < recordSize; ++i) {
+                fields << QString("%1").arg(uint(uchar(record[i])), 2, 16, QChar('0'));
+            }
+            text += fields.join(',').toLatin1() + "\r\n";
+            binary += record;
+            if (rng.bounded(8) == 0) {
+                text += "noise,line\n";
+                binary += QByteArray("\x01\x02\x03", 3);
+            }
+        }
+        binary += QByteArray("\x11\xAA\x55", 3).mid(settings.filterStartPos > 0 ? 0 : 1);
+
+        QTemporaryFile textFile;
+        QTemporaryFile binaryFile;
+        if (!textFile.open() || !binaryFile.open()) {
+            ++result.formatMismatches;
+            result.failures << QString("FORMAT 无法创建临时文件");
+            return;
+        }
+        textFile.write(text);
+        textFile.flush();
+        binaryFile.write(binary);
+        binaryFile.flush();
+
+        // 文本按显式格式读取，二进制依赖自动识别
+        QVector<FrameStore> textStores(patterns.size());
+        QVector<FrameStore> binaryStores(patterns.size());
+        QVector<FrameStore *> textPointers;
+        QVector<FrameStore *> binaryPointers;
+        for (int i = 0; i < patterns.size(); ++i) {
+            textPointers.append(&textStores[i]);
+            binaryPointers.append(&binaryStores[i]);
+        }
+        settings.inputFormat = ParseSettings::TextFormat;
+        TouchDataParser::readStreams(textFile.fileName(), settings, patterns, textPointers);
+        settings.inputFormat = ParseSettings::AutoFormat;
+        TouchDataParser::readStreams(binaryFile.fileName(), settings, patterns, binaryPointers);
+
+        bool same = true;
+        for (int i = 0; i < patterns.size() && same; ++i) {
+            const FrameStore &a = textStores[i];
+            const FrameStore &b = binaryStores[i];
+            same = a.frameCount() == b.frameCount();
+            for (int f = 0; f < a.frameCount() && same; ++f) {
+                same = std::memcmp(a.frame(f), b.frame(f), size_t(a.frameSize()) * sizeof(qint16)) == 0
+                    && a.timestamp(f) == b.timestamp(f) && a.sequence(f) == b.sequence(f);
+            }
+        }
+        if (!same) {
+            ++result.formatMismatches;
+            if (result.failures.size() < kMaxFailuresReported) {
+                result.failures << QString("FORMAT rx=%1 tx=%2 rawDataPos=%3 filterStartPos=%4 bigEndian=%5 records=%6")
+                    .arg(settings.rxCount).arg(settings.txCount).arg(settings.rawDataPos)
+                    .arg(settings.filterStartPos).arg(settings.isBigEndian).arg(records);
+            }
+        }
+    }
+}
+
+int ParserSelfCheck::runFromCommandLine(int argc, char *argv[])
+{
+    int iterations = argc > 2 ? QByteArray(argv[2]).toInt() : 100000;
+    quint32 seed = argc > 3 ? QByteArray(argv[3]).toUInt() : QRandomGenerator::global()->generate();
+    if (iterations <= 0) {
+        iterations = 100000;
+    }
+
+    Result result = run(iterations, seed);
+    checkInputFormats(qBound(1, iterations / 10000, 20), seed, result);
+    std::fprintf(stderr, "parser self-check: seed=%u cases=%d mismatches=%d diagnose=%d formats=%d allocating=%d "
+                 "(allocation counter %s)\n",
+                 seed, result.casesRun, result.mismatches, result.diagnoseMismatches, result.formatMismatches,
+                 result.allocatingCases, AllocationCounter::isEnabled() ? "on" : "off");
+    for (const QString &failure : result.failures) {
+        std::fprintf(stderr, "  %s\n", failure.toLocal8Bit().constData());
+    }
+    return result.passed() ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+#ifndef PARSERSELFCHECK_H
+#define PARSERSELFCHECK_H
+
+#include <QString>
+#include <QStringList>
+
+// 解析器自检：随机生成并变异 CSV 行，同时交给参考实现（parseCSVLine / matchFilterPattern）
+// 和快速路径（matchLine / decodeLine），要求两者结果完全一致；诊断（diagnoseLine）找到的错误
+// 与 decodeLine 是否解析出整行一致；同一组记录分别写成文本和二进制文件，两种读取器读出的帧必须相同；
+// 启用分配计数时（RGD_COUNT_ALLOCATIONS）同时检查快速路径每行零堆分配
+// 通过命令行 --self-check [次数] [种子] 运行
+class ParserSelfCheck
+{
+public:
+    struct Result {
+        int casesRun = 0;
+        int mismatches = 0;
+        int diagnoseMismatches = 0;   // diagnoseLine 与 decodeLine 的结论不一致
+        int formatMismatches = 0;     // 文本与二进制读取结果不一致的文件
+        int allocatingCases = 0;
+        QStringList failures;         // 前若干个失败用例（可直接复现）
+
+        bool passed() const { return mismatches == 0 && diagnoseMismatches == 0 && formatMismatches == 0 && allocatingCases == 0; }
+    };
+
+    static Result run(int iterations, quint32 seed);
+    static void checkInputFormats(int files, quint32 seed, Result &result);
+    static int runFromCommandLine(int argc, char *argv[]);   // 返回进程退出码
+};
+
+#endif // PARSERSELFCHECK_H
@@ -0,0 +1,75 @@
+#include "peakdetector.h"
+#include <cstring>
+
+void PeakDetector::detect(const qint16 *data, int rxCount, int txCount, int threshold)
+{
+    const int count = rxCount * txCount;
+    if (cellStates.size() != count) {
+        cellStates.resize(count);
+        visited.resize(count);
+        queue.resize(count);
+    }
+    std::memset(cellStates.data(), Normal, size_t(count));
+    std::memset(visited.data(), 0, size_t(count));
+    peakCells.clear();
+    aboveCount = 0;
+
+    // 8邻域方向（上、下、左、右、左上、右上、左下、右下）
+    static const int dx[] = {-1, 1, 0, 0, -1, -1, 1, 1};
+    static const int dy[] = {0, 0, -1, 1, -1, 1, -1, 1};
+
+    int *cells = queue.data();
+    for (int start = 0; start < count; ++start) {
+        if (visited[start] || data[start] <= threshold) {
+            continue;
+        }
+
+        // BFS 遍历连通域；队列中已出队的部分就是连通域本身
+        int head = 0;
+        int tail = 0;
+        cells[tail++] = start;
+        visited[start] = 1;
+        while (head < tail) {
+            int current = cells[head++];
+            int ctx = current / rxCount;
+            int crx = current % rxCount;
+            for (int d = 0; d < 8; ++d) {
+                int ntx = ctx + dx[d];
+                int nrx = crx + dy[d];
+                if (ntx >= 0 && ntx < txCount && nrx >= 0 && nrx < rxCount) {
+                    int neighbor = ntx * rxCount + nrx;
+                    if (!visited[neighbor] && data[neighbor] > threshold) {
+                        visited[neighbor] = 1;
+                        cells[tail++] = neighbor;
+                    }
+                }
+            }
+        }
+
+        // 在当前连通域中检测峰值
+        for (int i = 0; i < tail; ++i) {
+            int cell = cells[i];
+            int ctx = cell / rxCount;
+            int crx = cell % rxCount;
+            qint16 centerValue = data[cell];
+            bool isLocalPeak = true;
+            for (int d = 0; d < 8; ++d) {
+                int ntx = ctx + dx[d];
+                int nrx = crx + dy[d];
+                if (ntx >= 0 && ntx < txCount && nrx >= 0 && nrx < rxCount
+                    && data[ntx * rxCount + nrx] > centerValue) {
+                    isLocalPeak = false;
+                    break;
+                }
+            }
+
+            aboveCount++;
+            if (isLocalPeak) {
+                cellStates[cell] = Peak;
+                peakCells.append(QPoint(crx, ctx));
+            } else {
+                cellStates[cell] = AboveThreshold;
+            }
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef PEAKDETECTOR_H
+#define PEAKDETECTOR_H
+
+#include <QPoint>
+#include <QVector>
+
+// 信号峰值检测：超过阈值的格子按 8 邻域划分连通域，连通域内不小于所有邻居的格子为峰值
+// 内部缓冲在多次调用之间复用，尺寸不变时不会重新分配
+class PeakDetector
+{
+public:
+    enum CellState : quint8 {
+        Normal = 0,
+        AboveThreshold = 1,
+        Peak = 2
+    };
+
+    void detect(const qint16 *data, int rxCount, int txCount, int threshold);
+
+    const QVector<quint8> &states() const { return cellStates; }    // 按 tx 行、rx 列排列
+    const QVector<QPoint> &peaks() const { return peakCells; }      // x = rx, y = tx
+    int aboveThresholdCount() const { return aboveCount; }
+
+private:
+    QVector<quint8> cellStates;
+    QVector<quint8> visited;
+    QVector<int> queue;           // BFS 队列（同时保存当前连通域的所有格子）
+    QVector<QPoint> peakCells;
+    int aboveCount = 0;
+};
+
+#endif // PEAKDETECTOR_H
@@ -0,0 +1,15 @@
+#include "perfdebug.h"
+
+namespace {
+bool perfDebugEnabled = qEnvironmentVariableIntValue("RGD_PERF_DEBUG") != 0;
+}
+
+bool PerfDebug::isEnabled()
+{
+    return perfDebugEnabled;
+}
+
+void PerfDebug::setEnabled(bool enabled)
+{
+    perfDebugEnabled = enabled;
+}
@@ -0,0 +1,22 @@
+#ifndef PERFDEBUG_H
+#define PERFDEBUG_H
+
+#include <QDebug>
+
+// 性能调试输出：默认关闭，设置环境变量 RGD_PERF_DEBUG=1 后逐帧打印各阶段耗时
+// 关闭时 PERF_DEBUG 只做一次判断，不构造 qDebug 流，显示路径不会因此产生分配
+namespace PerfDebug {
+
+bool isEnabled();
+void setEnabled(bool enabled);      // 基准和自检运行时强制关闭
+
+} // namespace PerfDebug
+
+// 统计堆分配时编译期去掉调试输出，否则 qDebug 自身的分配会计入显示路径
+#if defined(RGD_COUNT_ALLOCATIONS)
+    #define PERF_DEBUG(msg) do {} while (0)
+#else
+    #define PERF_DEBUG(msg) do { if (PerfDebug::isEnabled()) { qDebug() << msg; } } while (0)
+#endif
+
+#endif // PERFDEBUG_H
@@ -0,0 +1,260 @@
+#include "playbackbenchmark.h"
+#include "functionpage.h"
+#include "./ui_functionpage.h"
+#include "perfdebug.h"
+#include <QApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+const int kBaselineFrames = 64;
+
+// 把 FunctionPage 的解析参数设置为与生成的文件一致
+void configurePage(Ui::FunctionPage *ui, const SyntheticCaptureConfig &capture,
+                   const QString &touchPath, const QString &baselinePath)
+{
+    const ParseSettings settings = capture.parseSettings();
+    ui->prefetchCheckBox->setChecked(false);
+    ui->rxSpinBox->setValue(capture.rxCount);
+    ui->txSpinBox->setValue(capture.txCount);
+
+    QLineEdit *const hexInputs[] = { ui->hexInput1, ui->hexInput2, ui->hexInput3, ui->hexInput4, ui->hexInput5 };
+    ui->autoFilterSpinBox->setValue(settings.pattern.size());
+    for (int i = 0; i < 5; ++i) {
+        hexInputs[i]->setText(i < settings.pattern.size() ? settings.pattern[i] : QString());
+    }
+    ui->extraPatternsLineEdit->clear();
+    ui->filterStartLineEdit->setText(QString::number(settings.filterStartPos));
+    ui->filterModeComboBox->setCurrentIndex(0);
+    ui->rawDataPosLineEdit->setText(QString::number(settings.rawDataPos));
+    ui->byteOrderComboBox->setCurrentIndex(settings.isBigEndian ? 0 : 1);
+    ui->inputFormatComboBox->setCurrentIndex(0);       // 自动识别，同时覆盖格式识别
+    ui->maxRowsLineEdit->setText(QString::number(capture.frameCount));
+
+    if (settings.timestampPos >= 0) {
+        ui->timestampPosLineEdit->setText(QString::number(settings.timestampPos));
+    } else {
+        ui->timestampPosLineEdit->clear();
+    }
+    ui->timestampBytesSpinBox->setValue(settings.timestampBytes);
+    ui->timestampUnitComboBox->setCurrentIndex(0);
+    if (settings.sequencePos >= 0) {
+        ui->sequencePosLineEdit->setText(QString::number(settings.sequencePos));
+    } else {
+        ui->sequencePosLineEdit->clear();
+    }
+    ui->sequenceBytesSpinBox->setValue(settings.sequenceBytes);
+
+    // 固定间隔播放：每次定时器触发正好推进一帧
+    ui->playClockComboBox->setCurrentIndex(0);
+    ui->touchFileLineEdit->setText(touchPath);
+    ui->baselineFileLineEdit->setText(baselinePath);
+    ui->baselineStartSpinBox->setValue(1);
+    ui->baselineFramesSpinBox->setValue(kBaselineFrames);
+}
+
+double percentileMs(const QVector<qint64> &sortedNs, double fraction)
+{
+    if (sortedNs.isEmpty()) {
+        return 0.0;
+    }
+    const int index = qBound(0, int(std::ceil(fraction * sortedNs.size())) - 1, sortedNs.size() - 1);
+    return sortedNs[index] / 1e6;
+}
+
+} // namespace
+
+QVector<PlaybackBenchmark::Scenario> PlaybackBenchmark::defaultScenarios(int frameCount, quint32 seed)
+{
+    // 界面上 RX/TX 最大为 512；覆盖三种文件格式、两种数据模式、两种显示方式和一个大面板
+    QVector<Scenario> scenarios;
+    Scenario scenario;
+    scenario.capture.frameCount = frameCount;
+    scenario.capture.seed = seed;
+
+    scenario.name = QStringLiteral("csv 16x28 raw table");
+    scenario.capture.rxCount = 16;
+    scenario.capture.txCount = 28;
+    scenarios.append(scenario);
+
+    scenario.name = QStringLiteral("csv 48x48 raw table");
+    scenario.capture.rxCount = 48;
+    scenario.capture.txCount = 48;
+    scenarios.append(scenario);
+
+    scenario.name = QStringLiteral("csv 200x120 raw table");
+    scenario.capture.rxCount = 200;
+    scenario.capture.txCount = 120;
+    scenarios.append(scenario);
+
+    scenario.name = QStringLiteral("csv 40x48 signal table noisy");
+    scenario.capture.rxCount = 40;
+    scenario.capture.txCount = 48;
+    scenario.capture.commonModeSigma = 8.0;
+    scenario.capture.periodicAmplitude = 20.0;
+    scenario.capture.malformedRate = 0.01;
+    scenario.signal = true;
+    scenarios.append(scenario);
+
+    scenario.name = QStringLiteral("binary 40x48 signal heatmap");
+    scenario.capture.format = SyntheticCaptureConfig::BinaryFormat;
+    scenario.capture.isBigEndian = false;
+    scenario.capture.timestamps = true;
+    scenario.capture.sequences = true;
+    scenario.heatmap = true;
+    scenarios.append(scenario);
+
+    scenario.name = QStringLiteral("rgdf 48x48 signal heatmap");
+    scenario.capture = SyntheticCaptureConfig();
+    scenario.capture.frameCount = frameCount;
+    scenario.capture.seed = seed;
+    scenario.capture.rxCount = 48;
+    scenario.capture.txCount = 48;
+    scenario.capture.touchCount = 5;
+    scenario.capture.format = SyntheticCaptureConfig::ArchiveFormat;
+    scenarios.append(scenario);
+
+    return scenarios;
+}
+
+PlaybackBenchmark::Result PlaybackBenchmark::run(const Scenario &scenario, const QString &directory)
+{
+    Result result;
+    result.name = scenario.name;
+
+    // 生成数据文件；信号模式另外生成一个无触摸的基线文件（同一种子下节点基线相同），归档自带基线
+    const SyntheticCaptureConfig &capture = scenario.capture;
+    const QString touchPath = QDir(directory).filePath(QStringLiteral("capture.%1").arg(capture.suffix()));
+    QString baselinePath;
+    QString error;
+    result.expectedFrames = SyntheticCapture::write(touchPath, capture, &error);
+    if (result.expectedFrames < 0) {
+        std::fprintf(stderr, "benchmark %s: %s\n", qPrintable(scenario.name), qPrintable(error));
+        return result;
+    }
+    const bool needsBaseline = scenario.signal && capture.format != SyntheticCaptureConfig::ArchiveFormat;
+    if (needsBaseline) {
+        SyntheticCaptureConfig baselineCapture = capture;
+        baselineCapture.frameCount = kBaselineFrames;
+        baselineCapture.touchCount = 0;
+        baselineCapture.malformedRate = 0.0;
+        baselinePath = QDir(directory).filePath(QStringLiteral("baseline.%1").arg(capture.suffix()));
+        SyntheticCapture::write(baselinePath, baselineCapture, &error);
+    }
+
+    FunctionPage page;
+    page.resize(1600, 1000);
+    page.show();
+    QApplication::processEvents();
+    configurePage(page.ui, capture, touchPath, baselinePath);
+
+    // 读取结果通过模态对话框报告，基准运行中立即关闭
+    QTimer dismisser;
+    dismisser.setInterval(1);
+    QObject::connect(&dismisser, &QTimer::timeout, []() {
+        if (QWidget *modal = QApplication::activeModalWidget()) {
+            modal->close();
+        }
+    });
+    dismisser.start();
+
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    if (needsBaseline) {
+        page.readBaselineData();
+    }
+    page.readTouchData();
+    // 归档读取后在后台整段解码，等解码完成并换入帧存储后再计时
+    while (page.archiveWatcher) {
+        page.archiveWatcher->waitForFinished();
+        QApplication::processEvents();
+    }
+    result.loadMs = loadTimer.elapsed();
+    dismisser.stop();
+    // 读取后在后台导出 touchData.txt，等它写完再计时，也避免临时目录删除时还在写入
+    page.dumpFuture.waitForFinished();
+    result.loadedFrames = page.touchFrames().frameCount();
+    if (result.loadedFrames != result.expectedFrames || result.loadedFrames == 0) {
+        return result;
+    }
+
+    if (scenario.signal) {
+        page.onSignalDataButtonClicked();
+    } else {
+        page.onRawDataButtonClicked();
+    }
+    page.ui->heatmapButton->setChecked(scenario.heatmap);
+    page.currentFrame = 0;
+    page.displayCurrentFrame();
+    page.repaint();
+    QApplication::processEvents();
+    result.playedFrames = 1;
+
+    // 与播放定时器触发时相同的路径：推进一帧并请求刷新；不等刷新周期，立即刷新并同步绘制
+    QVector<qint64> frameNs;
+    frameNs.reserve(result.loadedFrames);
+    QElapsedTimer total;
+    total.start();
+    for (int frame = 1; frame < result.loadedFrames; ++frame) {
+        QElapsedTimer timer;
+        timer.start();
+        page.onPlayTimerTimeout();
+        page.uiScheduler->flushNow();
+        page.repaint();
+        QApplication::processEvents();
+        frameNs.append(timer.nsecsElapsed());
+        if (page.currentFrame != frame) {
+            break;
+        }
+        result.playedFrames++;
+    }
+    const qint64 totalNs = total.nsecsElapsed();
+    page.stopPlayback();
+
+    std::sort(frameNs.begin(), frameNs.end());
+    result.fps = totalNs > 0 ? frameNs.size() * 1e9 / totalNs : 0.0;
+    result.p50Ms = percentileMs(frameNs, 0.50);
+    result.p99Ms = percentileMs(frameNs, 0.99);
+    result.maxMs = frameNs.isEmpty() ? 0.0 : frameNs.last() / 1e6;
+    return result;
+}
+
+int PlaybackBenchmark::runFromCommandLine(int argc, char *argv[])
+{
+    int frameCount = argc > 2 ? QByteArray(argv[2]).toInt() : 2000;
+    const quint32 seed = argc > 3 ? QByteArray(argv[3]).toUInt() : 1;
+    if (frameCount <= 1) {
+        frameCount = 2000;
+    }
+
+    // FunctionPage 在工作目录读写 config.json，基准期间切换到临时目录
+    QTemporaryDir directory;
+    if (!directory.isValid()) {
+        std::fprintf(stderr, "benchmark: cannot create a temporary directory\n");
+        return 1;
+    }
+    const QString previousDirectory = QDir::currentPath();
+    QDir::setCurrent(directory.path());
+    PerfDebug::setEnabled(false);
+
+    std::fprintf(stderr, "playback benchmark: %d frames per scenario, seed=%u, platform=%s\n",
+                 frameCount, seed, qPrintable(QApplication::platformName()));
+    bool passed = true;
+    for (const Scenario &scenario : defaultScenarios(frameCount, seed)) {
+        const Result result = run(scenario, directory.path());
+        std::fprintf(stderr, "  %-30s frames=%d/%d load=%lld ms fps=%.1f p50=%.2f ms p99=%.2f ms max=%.2f ms%s\n",
+                     qPrintable(result.name), result.playedFrames, result.expectedFrames,
+                     static_cast<long long>(result.loadMs), result.fps, result.p50Ms, result.p99Ms, result.maxMs,
+                     result.passed() ? "" : "  FAILED");
+        passed = passed && result.passed();
+    }
+
+    QDir::setCurrent(previousDirectory);
+    return passed ? 0 : 1;
+}
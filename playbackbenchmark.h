@@ -0,0 +1,40 @@
+#ifndef PLAYBACKBENCHMARK_H
+#define PLAYBACKBENCHMARK_H
+
+#include <QString>
+#include "syntheticcapture.h"
+
+// 端到端播放基准：用合成采集（SyntheticCapture）生成文件，经 FunctionPage 的界面读取，
+// 再逐帧走播放路径（推进帧、刷新显示、同步重绘），报告每种配置的读取耗时、达到的帧率和帧耗时分位数
+// 不经过刷新率合并，帧率反映的是显示路径的处理能力；在 QT_QPA_PLATFORM=offscreen 下运行，不需要显示器
+// 通过命令行 --benchmark [帧数] [种子] 运行，工作目录切换到临时目录，不会改动用户的 config.json
+class PlaybackBenchmark
+{
+public:
+    struct Scenario {
+        QString name;
+        SyntheticCaptureConfig capture;
+        bool signal = false;           // 显示信号数据（需要基线），否则显示原始数据
+        bool heatmap = false;          // 热力图，否则表格
+    };
+
+    struct Result {
+        QString name;
+        int expectedFrames = 0;
+        int loadedFrames = 0;
+        int playedFrames = 0;
+        qint64 loadMs = 0;
+        double fps = 0.0;
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+
+        bool passed() const { return loadedFrames == expectedFrames && playedFrames == expectedFrames; }
+    };
+
+    static QVector<Scenario> defaultScenarios(int frameCount, quint32 seed);
+    static Result run(const Scenario &scenario, const QString &directory);
+    static int runFromCommandLine(int argc, char *argv[]);   // 返回进程退出码，需已创建 QApplication
+};
+
+#endif // PLAYBACKBENCHMARK_H
@@ -0,0 +1,234 @@
+#include "playbackselfcheck.h"
+#include "allocationcounter.h"
+#include "functionpage.h"
+#include "./ui_functionpage.h"
+#include "capturesession.h"
+#include "frametablemodel.h"
+#include "lineprofilestrip.h"
+#include "perfdebug.h"
+#include <QApplication>
+#include <QDir>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QtMath>
+#include <cstdio>
+
+namespace {
+
+const int kFrameCount = 120;
+const int kWarmupFrames = 8;
+
+// 每种情况对应界面上的一组显示选项
+struct DisplayCase
+{
+    const char *name;
+    int rxCount;
+    int txCount;
+    QRect roi;              // 节点坐标，空表示整个面板
+    int overview;           // overviewComboBox：0=逐节点, 2=2×2, 3=4×4
+    bool heatmap;
+    bool reverseRx;
+    int lineStats;          // lineStatsComboBox：0=关闭, 1=均值, 2=中值, 3=总和
+};
+
+const DisplayCase kCases[] = {
+    { "table 48x32",                   48,  32, QRect(),                 0, false, false, 1 },
+    { "table 48x32 roi reversed",      48,  32, QRect(6, 4, 30, 20),     0, false, true,  2 },
+    { "table 200x120 pooled 2x2",      200, 120, QRect(),                2, false, true,  3 },
+    { "heatmap 200x120 roi pooled 4x4", 200, 120, QRect(20, 10, 150, 100), 3, true,  false, 3 },
+};
+
+// 合成帧：基线附近的噪声 + 两个移动的触摸点
+void buildFrames(int rxCount, int txCount, FrameStore &frames, QVector<qint16> &baseline)
+{
+    const int frameSize = rxCount * txCount;
+    baseline.resize(frameSize);
+    for (int i = 0; i < frameSize; ++i) {
+        baseline[i] = qint16(2000 + (i * 37) % 50);
+    }
+
+    frames.reset(frameSize);
+    for (int f = 0; f < kFrameCount; ++f) {
+        qint16 *frame = frames.appendFrame();
+        const double phase = f * 0.05;
+        const double x1 = rxCount * (0.5 + 0.4 * qSin(phase));
+        const double y1 = txCount * (0.5 + 0.4 * qCos(phase));
+        const double x2 = rxCount * (0.5 + 0.3 * qCos(phase * 1.7));
+        const double y2 = txCount * (0.5 + 0.3 * qSin(phase * 1.3));
+        for (int tx = 0; tx < txCount; ++tx) {
+            for (int rx = 0; rx < rxCount; ++rx) {
+                double d1 = (rx - x1) * (rx - x1) + (tx - y1) * (tx - y1);
+                double d2 = (rx - x2) * (rx - x2) + (tx - y2) * (tx - y2);
+                double touch = 600.0 * qExp(-d1 / 4.0) + 450.0 * qExp(-d2 / 3.0);
+                int index = tx * rxCount + rx;
+                frame[index] = qint16(baseline[index] - int(touch) + (index * 13 + f * 7) % 9 - 4);
+            }
+        }
+    }
+}
+
+// 与页面无关地计算期望的显示内容：base-raw 信号 -> ROI 裁剪 -> 按块取最大值
+void expectedView(const qint16 *frame, const QVector<qint16> &baseline, int rxCount, const QRect &region,
+                  int factor, QVector<qint16> &cropped, QVector<qint16> &pooled)
+{
+    cropped.resize(region.width() * region.height());
+    for (int y = 0; y < region.height(); ++y) {
+        for (int x = 0; x < region.width(); ++x) {
+            const int node = (region.top() + y) * rxCount + region.left() + x;
+            cropped[y * region.width() + x] = qint16(quint16(baseline[node]) - quint16(frame[node]));
+        }
+    }
+
+    const int pooledRx = (region.width() + factor - 1) / factor;
+    const int pooledTx = (region.height() + factor - 1) / factor;
+    pooled.fill(qint16(-32768), pooledRx * pooledTx);
+    for (int y = 0; y < region.height(); ++y) {
+        for (int x = 0; x < region.width(); ++x) {
+            qint16 &cell = pooled[(y / factor) * pooledRx + x / factor];
+            cell = qMax(cell, cropped[y * region.width() + x]);
+        }
+    }
+}
+
+} // namespace
+
+int PlaybackSelfCheck::runFromCommandLine()
+{
+    // FunctionPage 在工作目录读写 config.json，自检期间切换到临时目录，页面使用默认设置
+    QTemporaryDir directory;
+    if (!directory.isValid()) {
+        std::fprintf(stderr, "playback self-check: cannot create a temporary directory\n");
+        return 1;
+    }
+    const QString previousDirectory = QDir::currentPath();
+    QDir::setCurrent(directory.path());
+    PerfDebug::setEnabled(false);
+
+    // 数据不一致时页面会弹出模态对话框，自检中立即关闭并计为不一致
+    QTimer dismisser;
+    dismisser.setInterval(1);
+    QObject::connect(&dismisser, &QTimer::timeout, []() {
+        if (QWidget *modal = QApplication::activeModalWidget()) {
+            modal->close();
+        }
+    });
+    dismisser.start();
+
+    bool passed = true;
+    for (const DisplayCase &c : kCases) {
+        FrameStore frames;
+        QVector<qint16> baseline;
+        buildFrames(c.rxCount, c.txCount, frames, baseline);
+
+        FunctionPage page;
+        page.resize(1400, 900);
+        page.show();
+        QApplication::processEvents();
+
+        Ui::FunctionPage *ui = page.ui;
+        ui->rxSpinBox->setValue(c.rxCount);
+        ui->txSpinBox->setValue(c.txCount);
+        ui->signalCalcComboBox->setCurrentIndex(0);
+        ui->commonModeComboBox->setCurrentIndex(0);
+        ui->medianComboBox->setCurrentIndex(0);
+        ui->iirComboBox->setCurrentIndex(0);
+        ui->smoothCheckBox->setChecked(false);
+        ui->overviewComboBox->setCurrentIndex(c.overview);
+        ui->poolingComboBox->setCurrentIndex(0);
+        ui->lineStatsComboBox->setCurrentIndex(c.lineStats);
+        ui->reverseRxCheckBox->setChecked(c.reverseRx);
+        ui->heatmapButton->setChecked(c.heatmap);
+
+        // 直接注入帧和基线，与读取文件后的状态相同
+        page.touchFrames() = frames;
+        page.session->setPrimaryFile(QString());
+        page.baselineData = baseline;
+        page.invalidateProcessing();
+        page.setRoi(c.roi);
+        page.currentFrame = 0;
+        page.onSignalDataButtonClicked();
+        QApplication::processEvents();
+
+        const QRect region = page.activeRoi();
+        const int factor = c.overview >= 2 ? 1 << (c.overview - 1) : 1;
+        const int pooledRx = (region.width() + factor - 1) / factor;
+        QVector<qint16> cropped;
+        QVector<qint16> pooled;
+
+        quint64 allocations = 0;
+        int allocatingFrames = 0;
+        int mismatchedFrames = 0;
+        for (int f = 0; f < frames.frameCount(); ++f) {
+            page.currentFrame = f;
+            quint64 frameAllocations;
+            {
+                AllocationScope scope;
+                page.displayCurrentFrame();
+                frameAllocations = scope.allocations();
+            }
+            if (f >= kWarmupFrames && frameAllocations > 0) {
+                allocations += frameAllocations;
+                ++allocatingFrames;
+            }
+
+            expectedView(frames.frame(f), baseline, c.rxCount, region, factor, cropped, pooled);
+            bool ok = page.viewFactor == factor;
+
+            // 表格：模型中每个格子的文本（反转 RX 由模型处理）
+            if (!c.heatmap) {
+                const FrameTableModel *model = page.tableModel;
+                ok = ok && model->columnCount() == pooledRx && model->rowCount() * pooledRx == pooled.size();
+                for (int row = 0; ok && row < model->rowCount(); ++row) {
+                    for (int column = 0; ok && column < model->columnCount(); ++column) {
+                        const int x = c.reverseRx ? pooledRx - 1 - column : column;
+                        ok = model->data(model->index(row, column)).toString().toInt() == pooled[row * pooledRx + x];
+                    }
+                }
+            }
+
+            // 热力图概览：峰值标在所在的格子上
+            if (c.heatmap && factor > 1) {
+                const QVector<QPoint> &peaks = page.peakDetector.peaks();
+                ok = ok && page.pooledPeaks.size() == peaks.size();
+                for (int i = 0; ok && i < peaks.size(); ++i) {
+                    ok = page.pooledPeaks[i] == QPoint(peaks[i].x() / factor, peaks[i].y() / factor);
+                }
+            }
+
+            // 行列统计按 ROI 内逐节点的信号计算，与概览无关
+            if (c.lineStats > 0) {
+                const QVector<qint32> &rows = page.lineReducer.rowValues();
+                const QVector<qint32> &columns = page.lineReducer.columnValues();
+                ok = ok && !page.rowStrip->isHidden()
+                     && rows.size() == region.height() && columns.size() == region.width();
+                for (int y = 0; ok && c.lineStats == 3 && y < region.height(); ++y) {
+                    qint32 sum = 0;
+                    for (int x = 0; x < region.width(); ++x) {
+                        sum += cropped[y * region.width() + x];
+                    }
+                    ok = rows[y] == sum;
+                }
+            }
+
+            if (!ok) {
+                ++mismatchedFrames;
+            }
+        }
+
+        if (AllocationCounter::isEnabled()) {
+            std::fprintf(stderr, "playback self-check: %-32s frames=%d mismatched=%d "
+                         "allocating frames=%d allocations=%llu\n",
+                         c.name, frames.frameCount(), mismatchedFrames, allocatingFrames,
+                         static_cast<unsigned long long>(allocations));
+        } else {
+            std::fprintf(stderr, "playback self-check: %-32s frames=%d mismatched=%d "
+                         "(allocations not counted, build with RGD_COUNT_ALLOCATIONS)\n",
+                         c.name, frames.frameCount(), mismatchedFrames);
+        }
+        passed = passed && mismatchedFrames == 0 && allocatingFrames == 0;
+    }
+
+    dismisser.stop();
+    QDir::setCurrent(previousDirectory);
+    return passed ? 0 : 1;
+}
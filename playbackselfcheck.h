@@ -0,0 +1,14 @@
+#ifndef PLAYBACKSELFCHECK_H
+#define PLAYBACKSELFCHECK_H
+
+// 播放显示路径自检：创建真实的 FunctionPage，注入合成帧后逐帧调用 displayCurrentFrame，
+// 覆盖信号计算、ROI 裁剪、概览合并、峰值标记、行列统计、表格模型和热力图；
+// 检查表格显示的值、概览的峰值格子和行列统计与独立计算的结果一致，
+// 以 RGD_COUNT_ALLOCATIONS 构建时还要求预热之后每帧零堆分配（包括 Qt 视图的刷新通知）
+class PlaybackSelfCheck
+{
+public:
+    static int runFromCommandLine();     // 返回进程退出码，需已创建 QApplication
+};
+
+#endif // PLAYBACKSELFCHECK_H
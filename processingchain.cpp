@@ -0,0 +1,274 @@
+#include "processingchain.h"
+#include "simdkernels.h"
+#include <cstring>
+
+// 缓存保留的配置数量（每个配置占用与原始数据相同的内存）
+static const int kMaxCachedConfigs = 3;
+
+QString ProcessingConfig::key() const
+{
+    // 共模关闭时阈值不影响结果，不计入配置
+    return QString("cmf%1/%2,med%3,iir%4,sm%5")
+        .arg(commonMode).arg(commonMode != 0 ? commonModeLimit : 0)
+        .arg(medianFrames).arg(iirShift).arg(spatialSmooth ? 1 : 0);
+}
+
+namespace {
+
+// 共模去除：按行/按列减去未触摸格子的平均值
+class CommonModeStage : public FrameStage
+{
+public:
+    CommonModeStage(bool rows, bool columns, int limit)
+        : byRow(rows), byColumn(columns), limit(qint16(qBound(0, limit, 32767))) {}
+
+    void reset() override {}
+
+    void process(qint16 *frame, int width, int height) override
+    {
+        if (byRow) {
+            for (int y = 0; y < height; ++y) {
+                qint16 *row = frame + y * width;
+                qint32 sum = 0;
+                qint32 included = 0;
+                SimdKernels::sumWithinLimit(row, width, limit, sum, included);
+                if (included > 0) {
+                    SimdKernels::offsetSaturate(row, width, roundedMean(sum, included));
+                }
+            }
+        }
+
+        if (byColumn) {
+            if (sums.size() != width) {
+                sums.resize(width);
+                counts.resize(width);
+                means.resize(width);
+            }
+            std::memset(sums.data(), 0, sizeof(qint32) * size_t(width));
+            std::memset(counts.data(), 0, sizeof(qint32) * size_t(width));
+            for (int y = 0; y < height; ++y) {
+                SimdKernels::accumulateWithinLimit(frame + y * width, width, limit, sums.data(), counts.data());
+            }
+            for (int x = 0; x < width; ++x) {
+                means[x] = counts[x] > 0 ? roundedMean(sums[x], counts[x]) : qint16(0);
+            }
+            for (int y = 0; y < height; ++y) {
+                qint16 *row = frame + y * width;
+                SimdKernels::subtractSaturate(row, means.constData(), row, width);
+            }
+        }
+    }
+
+private:
+    static qint16 roundedMean(qint32 sum, qint32 count)
+    {
+        qint32 half = count / 2;
+        return qint16(sum >= 0 ? (sum + half) / count : (sum - half) / count);
+    }
+
+    bool byRow;
+    bool byColumn;
+    qint16 limit;
+    QVector<qint32> sums;
+    QVector<qint32> counts;
+    QVector<qint16> means;
+};
+
+// 时域中值：最近 N 帧逐点取中值，不足 N 帧时原样输出
+class TemporalMedianStage : public FrameStage
+{
+public:
+    explicit TemporalMedianStage(int frames) : depth(frames == 5 ? 5 : 3) {}
+
+    void reset() override { filled = 0; next = 0; }
+
+    void process(qint16 *frame, int width, int height) override
+    {
+        const int count = width * height;
+        if (history.size() != depth * count) {
+            history.resize(depth * count);
+            reset();
+        }
+
+        // 环形保存原始输入；中值与帧顺序无关，直接对各槽位取值
+        std::memcpy(history.data() + next * count, frame, sizeof(qint16) * size_t(count));
+        next = (next + 1) % depth;
+        if (filled < depth) {
+            ++filled;
+            if (filled < depth) {
+                return;
+            }
+        }
+
+        const qint16 *h = history.constData();
+        if (depth == 3) {
+            SimdKernels::median3(h, h + count, h + 2 * count, frame, count);
+        } else {
+            SimdKernels::median5(h, h + count, h + 2 * count, h + 3 * count, h + 4 * count, frame, count);
+        }
+    }
+
+private:
+    int depth;
+    int filled = 0;
+    int next = 0;
+    QVector<qint16> history;
+};
+
+// 一阶 IIR：y += (x - y) / 2^shift，第一帧直接作为初始状态
+class TemporalIirStage : public FrameStage
+{
+public:
+    explicit TemporalIirStage(int shift) : shift(qBound(1, shift, 8)) {}
+
+    void reset() override { primed = false; }
+
+    void process(qint16 *frame, int width, int height) override
+    {
+        const int count = width * height;
+        if (!primed || state.size() != count) {
+            state.resize(count);
+            std::memcpy(state.data(), frame, sizeof(qint16) * size_t(count));
+            primed = true;
+            return;
+        }
+        SimdKernels::iirStep(frame, state.data(), count, shift);
+    }
+
+private:
+    int shift;
+    bool primed = false;
+    QVector<qint16> state;
+};
+
+// 3x3 空间平滑
+class SpatialSmoothStage : public FrameStage
+{
+public:
+    void reset() override {}
+
+    void process(qint16 *frame, int width, int height) override
+    {
+        if (scratch.size() != width * height) {
+            scratch.resize(width * height);
+        }
+        SimdKernels::smooth3x3(frame, width, height, scratch.data());
+    }
+
+private:
+    QVector<qint16> scratch;
+};
+
+} // namespace
+
+ProcessingChain::ProcessingChain(const ProcessingConfig &config)
+{
+    if (config.commonMode != 0) {
+        addStage(new CommonModeStage(config.commonMode & 1, config.commonMode & 2, config.commonModeLimit));
+    }
+    if (config.medianFrames != 0) {
+        addStage(new TemporalMedianStage(config.medianFrames));
+    }
+    if (config.iirShift != 0) {
+        addStage(new TemporalIirStage(config.iirShift));
+    }
+    if (config.spatialSmooth) {
+        addStage(new SpatialSmoothStage);
+    }
+}
+
+ProcessingChain::~ProcessingChain()
+{
+    qDeleteAll(stages);
+}
+
+void ProcessingChain::addStage(FrameStage *stage)
+{
+    stages.append(stage);
+}
+
+void ProcessingChain::reset()
+{
+    for (FrameStage *stage : stages) {
+        stage->reset();
+    }
+}
+
+void ProcessingChain::process(qint16 *frame, int width, int height)
+{
+    for (FrameStage *stage : stages) {
+        stage->process(frame, width, height);
+    }
+}
+
+FrameStore ProcessingChain::processAll(const ProcessingConfig &config, const FrameStore &frames,
+                                       const QVector<qint16> &baseline, bool baseMinusRaw,
+                                       int width, int height)
+{
+    FrameStore out;
+    const int frameSize = frames.frameSize();
+    if (frameSize != width * height || baseline.size() != frameSize) {
+        return out;
+    }
+
+    ProcessingChain chain(config);
+    out.reset(frameSize);
+    for (int f = 0; f < frames.frameCount(); ++f) {
+        qint16 *slot = out.appendFrame();
+        if (baseMinusRaw) {
+            SimdKernels::subtractWrap(baseline.constData(), frames.frame(f), slot, frameSize);
+        } else {
+            SimdKernels::subtractWrap(frames.frame(f), baseline.constData(), slot, frameSize);
+        }
+        chain.process(slot, width, height);
+    }
+    out.squeeze();
+    return out;
+}
+
+bool ProcessedFrameCache::find(const QString &key, FrameStore &frames)
+{
+    for (int i = 0; i < entries.size(); ++i) {
+        if (entries[i].first == key) {
+            if (i > 0) {
+                entries.move(i, 0);
+            }
+            frames = entries[0].second;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ProcessedFrameCache::insert(const QString &key, const FrameStore &frames)
+{
+    for (int i = 0; i < entries.size(); ++i) {
+        if (entries[i].first == key) {
+            entries.remove(i);
+            break;
+        }
+    }
+    entries.prepend(qMakePair(key, frames));
+    while (entries.size() > kMaxCachedConfigs) {
+        entries.removeLast();
+    }
+}
+
+qint64 ProcessedFrameCache::memoryUsage() const
+{
+    qint64 bytes = 0;
+    for (const QPair<QString, FrameStore> &entry : entries) {
+        bytes += entry.second.memoryUsage();
+    }
+    return bytes;
+}
+
+qint64 ProcessedFrameCache::evict(qint64 bytes)
+{
+    qint64 freed = 0;
+    while (entries.size() > 1 && freed < bytes) {
+        freed += entries.last().second.memoryUsage();
+        entries.removeLast();
+    }
+    return freed;
+}
@@ -0,0 +1,72 @@
+#ifndef PROCESSINGCHAIN_H
+#define PROCESSINGCHAIN_H
+
+#include <QPair>
+#include <QString>
+#include <QVector>
+#include "framestore.h"
+
+// 信号处理链配置（界面选项），各阶段按 共模去除 -> 时域中值 -> 时域 IIR -> 空间平滑 的顺序执行，
+// 与固件中常见的处理顺序一致
+struct ProcessingConfig
+{
+    int commonMode = 0;          // 0=关闭, 1=按行, 2=按列, 3=行和列
+    int commonModeLimit = 150;   // |值| 超过该值的格子视为触摸，不计入共模
+    int medianFrames = 0;        // 0=关闭, 3 或 5
+    int iirShift = 0;            // 0=关闭，否则系数为 1 / 2^iirShift
+    bool spatialSmooth = false;  // [1 2 1] x [1 2 1] 平滑
+
+    bool isEnabled() const { return commonMode != 0 || medianFrames != 0 || iirShift != 0 || spatialSmooth; }
+    QString key() const;         // 区分缓存结果的配置字符串
+};
+
+// 处理阶段：原位处理一帧（按 height 行、width 列排列）
+// 时域阶段在两次 reset() 之间保留历史，因此帧必须按顺序送入
+class FrameStage
+{
+public:
+    virtual ~FrameStage() = default;
+
+    virtual void reset() = 0;
+    virtual void process(qint16 *frame, int width, int height) = 0;
+};
+
+class ProcessingChain
+{
+public:
+    explicit ProcessingChain(const ProcessingConfig &config);
+    ~ProcessingChain();
+
+    void addStage(FrameStage *stage);          // 接管所有权，按添加顺序执行
+    bool isEmpty() const { return stages.isEmpty(); }
+    void reset();
+    void process(qint16 *frame, int width, int height);
+
+    // 整段信号数据（base-raw 或 raw-base）逐帧经过处理链写入 out，可在工作线程中调用
+    static FrameStore processAll(const ProcessingConfig &config, const FrameStore &frames,
+                                 const QVector<qint16> &baseline, bool baseMinusRaw,
+                                 int width, int height);
+
+private:
+    Q_DISABLE_COPY(ProcessingChain)
+
+    QVector<FrameStage *> stages;
+};
+
+// 按处理链配置缓存整段处理结果，保留最近使用的几个配置（FrameStore 隐式共享，取出只复制引用）
+class ProcessedFrameCache
+{
+public:
+    bool find(const QString &key, FrameStore &frames);
+    void insert(const QString &key, const FrameStore &frames);
+    void clear() { entries.clear(); }
+
+    qint64 memoryUsage() const;
+    // 从最久未用的配置开始丢弃，最近使用的一个（当前显示的结果）保留；返回释放的字节数
+    qint64 evict(qint64 bytes);
+
+private:
+    QVector<QPair<QString, FrameStore>> entries;    // 最近使用的在前
+};
+
+#endif // PROCESSINGCHAIN_H
@@ -0,0 +1,366 @@
+#include "processingselfcheck.h"
+#include "analysispluginhost.h"
+#include "baselinebuilder.h"
+#include "memorybudget.h"
+#include "processingchain.h"
+#include "noisespectrum.h"
+#include "simdkernels.h"
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const int kIterations = 2000;
+const int kBenchRx = 40;
+const int kBenchTx = 70;
+const int kBenchFrames = 20000;
+const int kSpectrumFrames = 4096;
+const int kSpillRounds = 4;
+const int kSpillRoundFrames = 2000;
+const double kSpectrumRateHz = 240.0;
+
+qint16 randomValue(QRandomGenerator &rng, bool small)
+{
+    return small ? qint16(rng.bounded(601) - 300) : qint16(rng.bounded(65536) - 32768);
+}
+
+int clamp16(int value)
+{
+    return qBound(-32768, value, 32767);
+}
+
+// 逐点参考写法，返回不一致的项数
+int checkKernels(QRandomGenerator &rng)
+{
+    int mismatches = 0;
+    for (int iteration = 0; iteration < kIterations; ++iteration) {
+        const bool small = iteration & 1;
+        const int count = 1 + rng.bounded(100);
+        QVector<qint16> a(count), b(count), c(count), d(count), e(count), out(count);
+        for (int i = 0; i < count; ++i) {
+            a[i] = randomValue(rng, small);
+            b[i] = randomValue(rng, small);
+            c[i] = randomValue(rng, false);
+            d[i] = randomValue(rng, true);
+            e[i] = randomValue(rng, false);
+        }
+
+        SimdKernels::median3(a.constData(), b.constData(), c.constData(), out.data(), count);
+        for (int i = 0; i < count; ++i) {
+            qint16 v[3] = {a[i], b[i], c[i]};
+            std::sort(v, v + 3);
+            mismatches += (v[1] != out[i]);
+        }
+
+        SimdKernels::median5(a.constData(), b.constData(), c.constData(), d.constData(), e.constData(),
+                             out.data(), count);
+        for (int i = 0; i < count; ++i) {
+            qint16 v[5] = {a[i], b[i], c[i], d[i], e[i]};
+            std::sort(v, v + 5);
+            mismatches += (v[2] != out[i]);
+        }
+
+        const int shift = 1 + rng.bounded(4);
+        QVector<qint16> frame = a;
+        QVector<qint16> state = b;
+        SimdKernels::iirStep(frame.data(), state.data(), count, shift);
+        for (int i = 0; i < count; ++i) {
+            int expected = clamp16(b[i] + (clamp16(a[i] - b[i]) >> shift));
+            mismatches += (state[i] != expected || frame[i] != expected);
+        }
+
+        QVector<qint16> shifted = a;
+        SimdKernels::offsetSaturate(shifted.data(), count, c[0]);
+        for (int i = 0; i < count; ++i) {
+            mismatches += (shifted[i] != clamp16(a[i] - c[0]));
+        }
+
+        const qint16 limit = qint16(rng.bounded(400));
+        qint32 sum = 0;
+        qint32 included = 0;
+        SimdKernels::sumWithinLimit(a.constData(), count, limit, sum, included);
+        QVector<qint32> sums(count, 5);
+        QVector<qint32> counts(count, 3);
+        SimdKernels::accumulateWithinLimit(a.constData(), count, limit, sums.data(), counts.data());
+        qint32 expectedSum = 0;
+        qint32 expectedIncluded = 0;
+        for (int i = 0; i < count; ++i) {
+            bool inside = std::abs(int(a[i])) <= limit;
+            expectedSum += inside ? a[i] : 0;
+            expectedIncluded += inside ? 1 : 0;
+            mismatches += (sums[i] != 5 + (inside ? a[i] : 0) || counts[i] != 3 + (inside ? 1 : 0));
+        }
+        mismatches += (sum != expectedSum || included != expectedIncluded);
+
+        // 平滑与完整的加权求和相比误差不超过 1
+        const int width = 1 + rng.bounded(21);
+        const int height = 1 + rng.bounded(9);
+        QVector<qint16> image(width * height), scratch(width * height);
+        for (qint16 &value : image) {
+            value = qint16(randomValue(rng, false) / 2);
+        }
+        const QVector<qint16> original = image;
+
+        // 行/列求和
+        QVector<qint32> rowTotals(height), columnTotals(width);
+        SimdKernels::rowSums(original.constData(), width, height, rowTotals.data());
+        SimdKernels::columnSums(original.constData(), width, height, columnTotals.data());
+        for (int y = 0; y < height; ++y) {
+            qint32 total = 0;
+            for (int x = 0; x < width; ++x) {
+                total += original[y * width + x];
+            }
+            mismatches += (rowTotals[y] != total);
+        }
+        for (int x = 0; x < width; ++x) {
+            qint32 total = 0;
+            for (int y = 0; y < height; ++y) {
+                total += original[y * width + x];
+            }
+            mismatches += (columnTotals[x] != total);
+        }
+
+        SimdKernels::smooth3x3(image.data(), width, height, scratch.data());
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                int total = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        int yy = qBound(0, y + dy, height - 1);
+                        int xx = qBound(0, x + dx, width - 1);
+                        total += original[yy * width + xx] * (dy ? 1 : 2) * (dx ? 1 : 2);
+                    }
+                }
+                mismatches += (std::abs(image[y * width + x] * 16 - total) > 24);
+            }
+        }
+    }
+    return mismatches;
+}
+
+// 合成信号：基线噪声 + 行共模 + 一个移动的触摸点
+void buildFrames(FrameStore &frames, QVector<qint16> &baseline, QRandomGenerator &rng)
+{
+    const int frameSize = kBenchRx * kBenchTx;
+    baseline.resize(frameSize);
+    for (int i = 0; i < frameSize; ++i) {
+        baseline[i] = qint16(2000 + rng.bounded(50));
+    }
+
+    frames.reset(frameSize);
+    for (int f = 0; f < kBenchFrames; ++f) {
+        qint16 *frame = frames.appendFrame();
+        const int touchRx = f % kBenchRx;
+        const int touchTx = (f / 3) % kBenchTx;
+        for (int tx = 0; tx < kBenchTx; ++tx) {
+            const int commonMode = rng.bounded(41) - 20;
+            for (int rx = 0; rx < kBenchRx; ++rx) {
+                int index = tx * kBenchRx + rx;
+                int touch = (qAbs(rx - touchRx) <= 1 && qAbs(tx - touchTx) <= 1) ? 500 : 0;
+                frame[index] = qint16(baseline[index] - touch - commonMode + rng.bounded(9) - 4);
+            }
+        }
+    }
+}
+
+// 频谱自检数据：每个节点叠加一个已知频率（5 ~ 100 Hz，随节点变化）的正弦噪声
+void buildSpectrumFrames(FrameStore &frames, QRandomGenerator &rng)
+{
+    const int frameSize = kBenchRx * kBenchTx;
+    frames.reset(frameSize);
+    for (int f = 0; f < kSpectrumFrames; ++f) {
+        qint16 *frame = frames.appendFrame();
+        for (int node = 0; node < frameSize; ++node) {
+            const double frequency = 5.0 + node % 96;
+            const double phase = 2.0 * 3.14159265358979323846 * frequency * f / kSpectrumRateHz;
+            frame[node] = qint16(2000 + 20.0 * std::sin(phase + node) + rng.bounded(9) - 4);
+        }
+    }
+}
+
+// 主噪声频率偏离注入频率超过一个频点的节点数
+int checkSpectrum(const NoiseSpectrumResult &result)
+{
+    if (!result.isValid()) {
+        return kBenchRx * kBenchTx;
+    }
+    int wrong = 0;
+    for (int node = 0; node < result.nodeCount; ++node) {
+        const double expected = 5.0 + node % 96;
+        wrong += (std::fabs(result.binFrequency(result.dominantBins[node]) - expected) > result.binFrequency(1));
+    }
+    return wrong;
+}
+
+// 内置分析插件的并行结果与逐帧的参考写法对照（base-raw，阈值 100）
+int checkAnalysis(const AnalysisRunResult &result, const FrameStore &frames, const QVector<qint16> &baseline)
+{
+    if (!result.isValid() || result.frameCount != frames.frameCount() || result.metrics.size() != 4) {
+        return frames.frameCount();
+    }
+    int wrong = 0;
+    for (int f = 0; f < frames.frameCount(); ++f) {
+        const qint16 *frame = frames.frame(f);
+        int high = -32768;
+        int above = 0;
+        for (int i = 0; i < frames.frameSize(); ++i) {
+            const int value = qint16(baseline[i] - frame[i]);
+            high = qMax(high, value);
+            above += (value > 100);
+        }
+        wrong += (result.value(f, 0) != high || result.value(f, 2) != above);
+    }
+    return wrong;
+}
+
+// 多帧基线：在触摸点移动、带共模噪声的前 64 帧中插入一帧整体跳变，中值基线应仍接近真实基线
+// （直接平均时毛刺帧会让每个节点偏移约 16）
+int checkBaseline(const FrameStore &frames, const QVector<qint16> &baseline, qint64 &elapsedMs)
+{
+    const int frameCount = 64;
+    FrameStore glitched;
+    glitched.reset(frames.frameSize());
+    for (int f = 0; f < frameCount; ++f) {
+        glitched.appendFrame(frames.frame(f));
+    }
+    glitched.detachForWrite();
+    qint16 *spike = glitched.mutableFrame(frameCount / 2);
+    for (int i = 0; i < glitched.frameSize(); ++i) {
+        spike[i] = qint16(spike[i] + 1000);
+    }
+
+    int wrong = 0;
+    for (int method = BaselineBuilder::Median; method <= BaselineBuilder::RobustMean; ++method) {
+        const BaselineResult result = BaselineBuilder::build(glitched, 0, frameCount, BaselineBuilder::Method(method));
+        elapsedMs += result.elapsedMs;
+        if (!result.isValid()) {
+            return glitched.frameSize();
+        }
+        for (int i = 0; i < glitched.frameSize(); ++i) {
+            wrong += (std::abs(result.baseline[i] - baseline[i]) > 12);
+        }
+    }
+    return wrong;
+}
+
+// 内存预算：上限只比当前用量多 4MB 时复制整段帧，超出部分应放入换出文件；
+// 再把一份全在堆上的副本中离中间帧较远的块换出，两份的内容都应与原数据一致；
+// 最后分几轮各换出一段帧，前几轮的区域仍在映射中，每一轮换出的总量都应继续增长
+int checkSpill(const FrameStore &frames, qint64 &spilledBytes, qint64 &elapsedMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 savedLimit = MemoryBudget::limit();
+    const int frameBytes = frames.frameSize() * int(sizeof(qint16));
+
+    FrameStore limited;
+    limited.reset(frames.frameSize());
+    MemoryBudget::setLimit(MemoryBudget::heapBytes() + 4 * 1024 * 1024);
+    for (int f = 0; f < frames.frameCount(); ++f) {
+        limited.appendFrame(frames.frame(f));
+    }
+    MemoryBudget::setLimit(savedLimit);
+
+    FrameStore evicted;
+    evicted.reset(frames.frameSize());
+    for (int f = 0; f < frames.frameCount(); ++f) {
+        evicted.appendFrame(frames.frame(f));
+    }
+    const qint64 heapBefore = evicted.memoryUsage();
+    evicted.spillColdChunks(heapBefore, frames.frameCount() / 2);
+    spilledBytes = limited.spilledBytes() + evicted.spilledBytes();
+
+    int wrong = (limited.spilledBytes() == 0) + (evicted.spilledBytes() == 0) + (evicted.memoryUsage() == 0);
+    for (int f = 0; f < frames.frameCount(); ++f) {
+        wrong += (std::memcmp(limited.frame(f), frames.frame(f), size_t(frameBytes)) != 0);
+        wrong += (std::memcmp(evicted.frame(f), frames.frame(f), size_t(frameBytes)) != 0);
+    }
+
+    QVector<FrameStore> rounds(kSpillRounds);
+    const int roundFrames = qMin(kSpillRoundFrames, frames.frameCount());
+    for (FrameStore &round : rounds) {
+        round.reset(frames.frameSize());
+        for (int f = 0; f < roundFrames; ++f) {
+            round.appendFrame(frames.frame(f));
+        }
+        const qint64 before = MemoryBudget::spilledBytes();
+        round.spillColdChunks(round.memoryUsage(), 0);
+        wrong += (MemoryBudget::spilledBytes() <= before) + (round.spilledBytes() == 0);
+        spilledBytes += round.spilledBytes();
+    }
+    for (const FrameStore &round : rounds) {
+        for (int f = 0; f < roundFrames; ++f) {
+            wrong += (std::memcmp(round.frame(f), frames.frame(f), size_t(frameBytes)) != 0);
+        }
+    }
+    elapsedMs = timer.elapsed();
+    return wrong;
+}
+
+} // namespace
+
+int ProcessingSelfCheck::runFromCommandLine()
+{
+    QRandomGenerator rng(20240607);
+    const int mismatches = checkKernels(rng);
+
+    FrameStore frames;
+    QVector<qint16> baseline;
+    buildFrames(frames, baseline, rng);
+
+    ProcessingConfig config;
+    config.commonMode = 3;
+    config.medianFrames = 5;
+    config.iirShift = 2;
+    config.spatialSmooth = true;
+
+    QElapsedTimer timer;
+    timer.start();
+    FrameStore processed = ProcessingChain::processAll(config, frames, baseline, true, kBenchRx, kBenchTx);
+    const qint64 elapsedNs = qMax<qint64>(1, timer.nsecsElapsed());
+    const double framesPerSecond = processed.frameCount() * 1e9 / double(elapsedNs);
+
+    FrameStore spectrumFrames;
+    buildSpectrumFrames(spectrumFrames, rng);
+    NoiseSpectrumResult spectrum = NoiseSpectrum::analyze(spectrumFrames, 0, kSpectrumFrames, kSpectrumRateHz);
+    const int spectrumErrors = checkSpectrum(spectrum);
+
+    AnalysisPluginHost analysisHost;
+    AnalysisContext context;
+    context.rxCount = kBenchRx;
+    context.txCount = kBenchTx;
+    context.frameCount = frames.frameCount();
+    context.baseline = baseline.constData();
+    context.signalCalcMode = 0;
+    context.parameters.insert(QStringLiteral("signal_threshold"), 100);
+    const AnalysisRunResult analysis = AnalysisPluginHost::run(*analysisHost.plugin(0), frames, context);
+    const int analysisErrors = checkAnalysis(analysis, frames, baseline);
+
+    qint64 baselineMs = 0;
+    const int baselineErrors = checkBaseline(frames, baseline, baselineMs);
+
+    qint64 spilledBytes = 0;
+    qint64 spillMs = 0;
+    const int spillErrors = checkSpill(frames, spilledBytes, spillMs);
+
+    std::fprintf(stderr, "processing self-check: kernel mismatches=%d chain=%dx%d frames=%d %.0f frames/s (target 10000)\n",
+                 mismatches, kBenchRx, kBenchTx, processed.frameCount(), framesPerSecond);
+    std::fprintf(stderr, "noise spectrum: %dx%d nodes x %d frames wrong=%d %lld ms (target 1000)\n",
+                 kBenchRx, kBenchTx, kSpectrumFrames, spectrumErrors, static_cast<long long>(spectrum.elapsedMs));
+    std::fprintf(stderr, "analysis plugin: %s frames=%d wrong=%d %lld ms\n",
+                 qPrintable(analysis.pluginName), analysis.frameCount, analysisErrors,
+                 static_cast<long long>(analysis.elapsedMs));
+    std::fprintf(stderr, "baseline builder: 64 frames with one glitch, nodes off=%d %lld ms\n",
+                 baselineErrors, static_cast<long long>(baselineMs));
+    std::fprintf(stderr, "memory budget: spilled %lld MB wrong=%d %lld ms\n",
+                 static_cast<long long>(spilledBytes / (1024 * 1024)), spillErrors, static_cast<long long>(spillMs));
+    return (mismatches == 0 && processed.frameCount() == frames.frameCount() && spectrumErrors == 0
+            && analysisErrors == 0 && baselineErrors == 0
+            && spillErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,15 @@
+#ifndef PROCESSINGSELFCHECK_H
+#define PROCESSINGSELFCHECK_H
+
+// 信号处理链自检：处理链和行/列统计用到的向量化核函数与逐点的参考写法对照（随机数据，含边界尺寸），
+// 并在 40x70 的合成数据上测量完整处理链的吞吐量（目标 10000 帧/秒以上，只报告不判定）；
+// 噪声频谱对注入了已知频率的 4096 帧检查每个节点的主频，并报告耗时（目标 1 秒以内）；
+// 内置分析插件的并行结果与逐帧计算对照；多帧基线在有毛刺帧时检查与真实基线的偏差；
+// 帧存储在内存预算不足和主动换出后检查换出文件中的数据，并确认分多轮换出时换出文件能继续增长
+class ProcessingSelfCheck
+{
+public:
+    static int runFromCommandLine();     // 返回进程退出码
+};
+
+#endif // PROCESSINGSELFCHECK_H
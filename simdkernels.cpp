@@ -0,0 +1,476 @@
+#include "simdkernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define RGD_SIMD_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define RGD_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+namespace SimdKernels {
+
+void subtractSaturate(const qint16 *a, const qint16 *b, qint16 *out, int count)
+{
+    int i = 0;
+#if defined(RGD_SIMD_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_subs_epi16(va, vb));
+    }
+#elif defined(RGD_SIMD_NEON)
+    for (; i + 8 <= count; i += 8) {
+        vst1q_s16(out + i, vqsubq_s16(vld1q_s16(a + i), vld1q_s16(b + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        int value = int(a[i]) - int(b[i]);
+        out[i] = qint16(qBound(-32768, value, 32767));
+    }
+}
+
+void subtractWrap(const qint16 *a, const qint16 *b, qint16 *out, int count)
+{
+    int i = 0;
+#if defined(RGD_SIMD_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_sub_epi16(va, vb));
+    }
+#elif defined(RGD_SIMD_NEON)
+    for (; i + 8 <= count; i += 8) {
+        vst1q_s16(out + i, vsubq_s16(vld1q_s16(a + i), vld1q_s16(b + i)));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = qint16(quint16(quint16(a[i]) - quint16(b[i])));
+    }
+}
+
+void minMax(const qint16 *data, int count, qint16 &minValue, qint16 &maxValue)
+{
+    int i = 0;
+    qint16 lo = data[0];
+    qint16 hi = data[0];
+#if defined(RGD_SIMD_SSE2)
+    if (count >= 8) {
+        __m128i vmin = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        __m128i vmax = vmin;
+        for (i = 8; i + 8 <= count; i += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            vmin = _mm_min_epi16(vmin, v);
+            vmax = _mm_max_epi16(vmax, v);
+        }
+        alignas(16) qint16 mins[8];
+        alignas(16) qint16 maxs[8];
+        _mm_store_si128(reinterpret_cast<__m128i *>(mins), vmin);
+        _mm_store_si128(reinterpret_cast<__m128i *>(maxs), vmax);
+        for (int k = 0; k < 8; ++k) {
+            lo = qMin(lo, mins[k]);
+            hi = qMax(hi, maxs[k]);
+        }
+    }
+#elif defined(RGD_SIMD_NEON)
+    if (count >= 8) {
+        int16x8_t vmin = vld1q_s16(data);
+        int16x8_t vmax = vmin;
+        for (i = 8; i + 8 <= count; i += 8) {
+            int16x8_t v = vld1q_s16(data + i);
+            vmin = vminq_s16(vmin, v);
+            vmax = vmaxq_s16(vmax, v);
+        }
+        qint16 mins[8];
+        qint16 maxs[8];
+        vst1q_s16(mins, vmin);
+        vst1q_s16(maxs, vmax);
+        for (int k = 0; k < 8; ++k) {
+            lo = qMin(lo, mins[k]);
+            hi = qMax(hi, maxs[k]);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        lo = qMin(lo, data[i]);
+        hi = qMax(hi, data[i]);
+    }
+    minValue = lo;
+    maxValue = hi;
+}
+
+void lookupClamped(const qint16 *data, int count, qint16 low, qint16 high,
+                   const quint32 *lut, quint32 *out)
+{
+    // 向量化部分负责钳位和求索引，查表本身是逐项读取（SSE2/NEON 没有 gather）
+    int i = 0;
+#if defined(RGD_SIMD_SSE2)
+    const __m128i vlow = _mm_set1_epi16(low);
+    const __m128i vhigh = _mm_set1_epi16(high);
+    alignas(16) quint16 index[8];
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        v = _mm_sub_epi16(_mm_min_epi16(_mm_max_epi16(v, vlow), vhigh), vlow);
+        _mm_store_si128(reinterpret_cast<__m128i *>(index), v);
+        out[i + 0] = lut[index[0]];
+        out[i + 1] = lut[index[1]];
+        out[i + 2] = lut[index[2]];
+        out[i + 3] = lut[index[3]];
+        out[i + 4] = lut[index[4]];
+        out[i + 5] = lut[index[5]];
+        out[i + 6] = lut[index[6]];
+        out[i + 7] = lut[index[7]];
+    }
+#elif defined(RGD_SIMD_NEON)
+    const int16x8_t vlow = vdupq_n_s16(low);
+    const int16x8_t vhigh = vdupq_n_s16(high);
+    quint16 index[8];
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vminq_s16(vmaxq_s16(vld1q_s16(data + i), vlow), vhigh);
+        vst1q_u16(index, vreinterpretq_u16_s16(vsubq_s16(v, vlow)));
+        for (int k = 0; k < 8; ++k) {
+            out[i + k] = lut[index[k]];
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        qint16 v = qBound(low, data[i], high);
+        out[i] = lut[quint16(v - low)];
+    }
+}
+
+void offsetSaturate(qint16 *data, int count, qint16 offset)
+{
+    int i = 0;
+#if defined(RGD_SIMD_SSE2)
+    const __m128i voffset = _mm_set1_epi16(offset);
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(data + i), _mm_subs_epi16(v, voffset));
+    }
+#elif defined(RGD_SIMD_NEON)
+    const int16x8_t voffset = vdupq_n_s16(offset);
+    for (; i + 8 <= count; i += 8) {
+        vst1q_s16(data + i, vqsubq_s16(vld1q_s16(data + i), voffset));
+    }
+#endif
+    for (; i < count; ++i) {
+        data[i] = qint16(qBound(-32768, int(data[i]) - int(offset), 32767));
+    }
+}
+
+void iirStep(qint16 *frame, qint16 *state, int count, int shift)
+{
+    int i = 0;
+#if defined(RGD_SIMD_SSE2)
+    const __m128i vshift = _mm_cvtsi32_si128(shift);
+    for (; i + 8 <= count; i += 8) {
+        __m128i vf = _mm_loadu_si128(reinterpret_cast<const __m128i *>(frame + i));
+        __m128i vs = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + i));
+        vs = _mm_adds_epi16(vs, _mm_sra_epi16(_mm_subs_epi16(vf, vs), vshift));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(state + i), vs);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(frame + i), vs);
+    }
+#elif defined(RGD_SIMD_NEON)
+    const int16x8_t vshift = vdupq_n_s16(qint16(-shift));
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t vs = vld1q_s16(state + i);
+        vs = vqaddq_s16(vs, vshlq_s16(vqsubq_s16(vld1q_s16(frame + i), vs), vshift));
+        vst1q_s16(state + i, vs);
+        vst1q_s16(frame + i, vs);
+    }
+#endif
+    for (; i < count; ++i) {
+        int diff = qBound(-32768, int(frame[i]) - int(state[i]), 32767);
+        state[i] = qint16(qBound(-32768, int(state[i]) + (diff >> shift), 32767));
+        frame[i] = state[i];
+    }
+}
+
+void median3(const qint16 *a, const qint16 *b, const qint16 *c, qint16 *out, int count)
+{
+    // med3 = max(min(a, b), min(max(a, b), c))
+    int i = 0;
+#if defined(RGD_SIMD_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        __m128i vc = _mm_loadu_si128(reinterpret_cast<const __m128i *>(c + i));
+        __m128i m = _mm_max_epi16(_mm_min_epi16(va, vb), _mm_min_epi16(_mm_max_epi16(va, vb), vc));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), m);
+    }
+#elif defined(RGD_SIMD_NEON)
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        int16x8_t vc = vld1q_s16(c + i);
+        vst1q_s16(out + i, vmaxq_s16(vminq_s16(va, vb), vminq_s16(vmaxq_s16(va, vb), vc)));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = qMax(qMin(a[i], b[i]), qMin(qMax(a[i], b[i]), c[i]));
+    }
+}
+
+void median5(const qint16 *a, const qint16 *b, const qint16 *c, const qint16 *d, const qint16 *e,
+             qint16 *out, int count)
+{
+    // 先排除 (a, b)、(c, d) 中各自的较小者里更小的一个和较大者里更大的一个，
+    // 剩下的两个与 e 取中值即为五个数的中值
+    int i = 0;
+#if defined(RGD_SIMD_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        __m128i vc = _mm_loadu_si128(reinterpret_cast<const __m128i *>(c + i));
+        __m128i vd = _mm_loadu_si128(reinterpret_cast<const __m128i *>(d + i));
+        __m128i ve = _mm_loadu_si128(reinterpret_cast<const __m128i *>(e + i));
+        __m128i lo = _mm_max_epi16(_mm_min_epi16(va, vb), _mm_min_epi16(vc, vd));
+        __m128i hi = _mm_min_epi16(_mm_max_epi16(va, vb), _mm_max_epi16(vc, vd));
+        __m128i m = _mm_max_epi16(_mm_min_epi16(lo, hi), _mm_min_epi16(_mm_max_epi16(lo, hi), ve));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), m);
+    }
+#elif defined(RGD_SIMD_NEON)
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t va = vld1q_s16(a + i);
+        int16x8_t vb = vld1q_s16(b + i);
+        int16x8_t vc = vld1q_s16(c + i);
+        int16x8_t vd = vld1q_s16(d + i);
+        int16x8_t lo = vmaxq_s16(vminq_s16(va, vb), vminq_s16(vc, vd));
+        int16x8_t hi = vminq_s16(vmaxq_s16(va, vb), vmaxq_s16(vc, vd));
+        vst1q_s16(out + i, vmaxq_s16(vminq_s16(lo, hi), vminq_s16(vmaxq_s16(lo, hi), vld1q_s16(e + i))));
+    }
+#endif
+    for (; i < count; ++i) {
+        qint16 lo = qMax(qMin(a[i], b[i]), qMin(c[i], d[i]));
+        qint16 hi = qMin(qMax(a[i], b[i]), qMax(c[i], d[i]));
+        out[i] = qMax(qMin(lo, hi), qMin(qMax(lo, hi), e[i]));
+    }
+}
+
+namespace {
+
+// (a + b + 1) >> 1，不会溢出
+inline qint16 roundedHalfAdd(qint16 a, qint16 b)
+{
+    return qint16((int(a) + int(b) + 1) >> 1);
+}
+
+// out[i] = rhadd(rhadd(a[i], c[i]), b[i])，即 (a + 2b + c) / 4
+void blend121(const qint16 *a, const qint16 *b, const qint16 *c, qint16 *out, int count)
+{
+    int i = 0;
+#if defined(RGD_SIMD_SSE2)
+    // SSE2 只有无符号的 avg，翻转符号位后与有符号的 (a + b + 1) >> 1 完全等价
+    const __m128i bias = _mm_set1_epi16(qint16(0x8000));
+    for (; i + 8 <= count; i += 8) {
+        __m128i va = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i)), bias);
+        __m128i vb = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i)), bias);
+        __m128i vc = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(c + i)), bias);
+        __m128i v = _mm_avg_epu16(_mm_avg_epu16(va, vc), vb);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_xor_si128(v, bias));
+    }
+#elif defined(RGD_SIMD_NEON)
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vrhaddq_s16(vrhaddq_s16(vld1q_s16(a + i), vld1q_s16(c + i)), vld1q_s16(b + i));
+        vst1q_s16(out + i, v);
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = roundedHalfAdd(roundedHalfAdd(a[i], c[i]), b[i]);
+    }
+}
+
+} // namespace
+
+void smooth3x3(qint16 *frame, int width, int height, qint16 *scratch)
+{
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    // 纵向：整行一起处理，首尾行的越界邻居取自身
+    for (int y = 0; y < height; ++y) {
+        const qint16 *up = frame + qMax(0, y - 1) * width;
+        const qint16 *down = frame + qMin(height - 1, y + 1) * width;
+        blend121(up, frame + y * width, down, scratch + y * width, width);
+    }
+
+    // 横向：内部列用错开一列的指针整段处理，首尾列单独计算
+    for (int y = 0; y < height; ++y) {
+        const qint16 *row = scratch + y * width;
+        qint16 *out = frame + y * width;
+        if (width == 1) {
+            out[0] = row[0];
+            continue;
+        }
+        if (width > 2) {
+            blend121(row, row + 1, row + 2, out + 1, width - 2);
+        }
+        out[0] = roundedHalfAdd(roundedHalfAdd(row[0], row[1]), row[0]);
+        out[width - 1] = roundedHalfAdd(roundedHalfAdd(row[width - 2], row[width - 1]), row[width - 1]);
+    }
+}
+
+void sumWithinLimit(const qint16 *data, int count, qint16 limit, qint32 &sum, qint32 &included)
+{
+    int i = 0;
+    qint32 total = 0;
+    qint32 n = 0;
+#if defined(RGD_SIMD_SSE2)
+    const __m128i vlimit = _mm_set1_epi16(limit);
+    const __m128i vnegLimit = _mm_set1_epi16(qint16(-limit));
+    const __m128i ones = _mm_set1_epi16(1);
+    __m128i vsum = _mm_setzero_si128();
+    __m128i vcount = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        __m128i outside = _mm_or_si128(_mm_cmpgt_epi16(v, vlimit), _mm_cmplt_epi16(v, vnegLimit));
+        __m128i inside = _mm_andnot_si128(outside, ones);
+        vsum = _mm_add_epi32(vsum, _mm_madd_epi16(_mm_andnot_si128(outside, v), ones));
+        vcount = _mm_add_epi32(vcount, _mm_madd_epi16(inside, ones));
+    }
+    alignas(16) qint32 sums[4];
+    alignas(16) qint32 counts[4];
+    _mm_store_si128(reinterpret_cast<__m128i *>(sums), vsum);
+    _mm_store_si128(reinterpret_cast<__m128i *>(counts), vcount);
+    total = sums[0] + sums[1] + sums[2] + sums[3];
+    n = counts[0] + counts[1] + counts[2] + counts[3];
+#elif defined(RGD_SIMD_NEON)
+    const int16x8_t vlimit = vdupq_n_s16(limit);
+    const int16x8_t vnegLimit = vdupq_n_s16(qint16(-limit));
+    const uint16x8_t ones = vdupq_n_u16(1);
+    int32x4_t vsum = vdupq_n_s32(0);
+    uint32x4_t vcount = vdupq_n_u32(0);
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vld1q_s16(data + i);
+        uint16x8_t inside = vandq_u16(vcleq_s16(v, vlimit), vcgeq_s16(v, vnegLimit));
+        vsum = vpadalq_s16(vsum, vandq_s16(v, vreinterpretq_s16_u16(inside)));
+        vcount = vpadalq_u16(vcount, vandq_u16(inside, ones));
+    }
+    qint32 sums[4];
+    quint32 counts[4];
+    vst1q_s32(sums, vsum);
+    vst1q_u32(counts, vcount);
+    total = sums[0] + sums[1] + sums[2] + sums[3];
+    n = qint32(counts[0] + counts[1] + counts[2] + counts[3]);
+#endif
+    for (; i < count; ++i) {
+        if (data[i] <= limit && data[i] >= -limit) {
+            total += data[i];
+            ++n;
+        }
+    }
+    sum = total;
+    included = n;
+}
+
+void accumulateWithinLimit(const qint16 *row, int count, qint16 limit, qint32 *sums, qint32 *counts)
+{
+    int i = 0;
+#if defined(RGD_SIMD_SSE2)
+    const __m128i vlimit = _mm_set1_epi16(limit);
+    const __m128i vnegLimit = _mm_set1_epi16(qint16(-limit));
+    for (; i + 8 <= count; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        __m128i outside = _mm_or_si128(_mm_cmpgt_epi16(v, vlimit), _mm_cmplt_epi16(v, vnegLimit));
+        __m128i masked = _mm_andnot_si128(outside, v);
+        // 符号扩展到 32 位：高 16 位复制后算术右移
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(masked, masked), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(masked, masked), 16);
+        // 掩码为 0 或 -1，计数时取反后逐项减去
+        __m128i inside = _mm_xor_si128(outside, _mm_set1_epi16(-1));
+        __m128i insideLo = _mm_srai_epi32(_mm_unpacklo_epi16(inside, inside), 16);
+        __m128i insideHi = _mm_srai_epi32(_mm_unpackhi_epi16(inside, inside), 16);
+        __m128i *s = reinterpret_cast<__m128i *>(sums + i);
+        __m128i *c = reinterpret_cast<__m128i *>(counts + i);
+        _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(s), lo));
+        _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), hi));
+        _mm_storeu_si128(c, _mm_sub_epi32(_mm_loadu_si128(c), insideLo));
+        _mm_storeu_si128(c + 1, _mm_sub_epi32(_mm_loadu_si128(c + 1), insideHi));
+    }
+#elif defined(RGD_SIMD_NEON)
+    const int16x8_t vlimit = vdupq_n_s16(limit);
+    const int16x8_t vnegLimit = vdupq_n_s16(qint16(-limit));
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t v = vld1q_s16(row + i);
+        uint16x8_t inside = vandq_u16(vcleq_s16(v, vlimit), vcgeq_s16(v, vnegLimit));
+        int16x8_t masked = vandq_s16(v, vreinterpretq_s16_u16(inside));
+        int16x8_t ones = vandq_s16(vreinterpretq_s16_u16(inside), vdupq_n_s16(1));
+        vst1q_s32(sums + i, vaddw_s16(vld1q_s32(sums + i), vget_low_s16(masked)));
+        vst1q_s32(sums + i + 4, vaddw_s16(vld1q_s32(sums + i + 4), vget_high_s16(masked)));
+        vst1q_s32(counts + i, vaddw_s16(vld1q_s32(counts + i), vget_low_s16(ones)));
+        vst1q_s32(counts + i + 4, vaddw_s16(vld1q_s32(counts + i + 4), vget_high_s16(ones)));
+    }
+#endif
+    for (; i < count; ++i) {
+        if (row[i] <= limit && row[i] >= -limit) {
+            sums[i] += row[i];
+            counts[i] += 1;
+        }
+    }
+}
+
+void rowSums(const qint16 *data, int width, int height, qint32 *sums)
+{
+    for (int y = 0; y < height; ++y) {
+        const qint16 *row = data + y * width;
+        int i = 0;
+        qint32 total = 0;
+#if defined(RGD_SIMD_SSE2)
+        const __m128i ones = _mm_set1_epi16(1);
+        __m128i vsum = _mm_setzero_si128();
+        for (; i + 8 <= width; i += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+            vsum = _mm_add_epi32(vsum, _mm_madd_epi16(v, ones));
+        }
+        alignas(16) qint32 lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), vsum);
+        total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(RGD_SIMD_NEON)
+        int32x4_t vsum = vdupq_n_s32(0);
+        for (; i + 8 <= width; i += 8) {
+            vsum = vpadalq_s16(vsum, vld1q_s16(row + i));
+        }
+        qint32 lanes[4];
+        vst1q_s32(lanes, vsum);
+        total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+        for (; i < width; ++i) {
+            total += row[i];
+        }
+        sums[y] = total;
+    }
+}
+
+void columnSums(const qint16 *data, int width, int height, qint32 *sums)
+{
+    for (int x = 0; x < width; ++x) {
+        sums[x] = 0;
+    }
+    for (int y = 0; y < height; ++y) {
+        const qint16 *row = data + y * width;
+        int i = 0;
+#if defined(RGD_SIMD_SSE2)
+        for (; i + 8 <= width; i += 8) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+            __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+            __m128i *s = reinterpret_cast<__m128i *>(sums + i);
+            _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(s), lo));
+            _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), hi));
+        }
+#elif defined(RGD_SIMD_NEON)
+        for (; i + 8 <= width; i += 8) {
+            int16x8_t v = vld1q_s16(row + i);
+            vst1q_s32(sums + i, vaddw_s16(vld1q_s32(sums + i), vget_low_s16(v)));
+            vst1q_s32(sums + i + 4, vaddw_s16(vld1q_s32(sums + i + 4), vget_high_s16(v)));
+        }
+#endif
+        for (; i < width; ++i) {
+            sums[i] += row[i];
+        }
+    }
+}
+
+} // namespace SimdKernels
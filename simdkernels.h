@@ -0,0 +1,49 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include <QtGlobal>
+
+// 逐帧数据的向量化计算（SSE2 / NEON，其余平台退回标量实现）
+namespace SimdKernels {
+
+// out[i] = a[i] - b[i]，结果饱和到 qint16 范围
+void subtractSaturate(const qint16 *a, const qint16 *b, qint16 *out, int count);
+
+// out[i] = a[i] - b[i]，按 16 位回绕（与 int 结果截断为 qint16 相同）
+void subtractWrap(const qint16 *a, const qint16 *b, qint16 *out, int count);
+
+// 求 data 的最小值/最大值，count 必须大于 0
+void minMax(const qint16 *data, int count, qint16 &minValue, qint16 &maxValue);
+
+// out[i] = lut[clamp(data[i], low, high) - low]，lut 至少有 high - low + 1 项
+void lookupClamped(const qint16 *data, int count, qint16 low, qint16 high,
+                   const quint32 *lut, quint32 *out);
+
+// data[i] = data[i] - offset，结果饱和到 qint16 范围
+void offsetSaturate(qint16 *data, int count, qint16 offset);
+
+// 一阶 IIR：state += (frame - state) >> shift，然后 frame = state（差值和结果都饱和）
+void iirStep(qint16 *frame, qint16 *state, int count, int shift);
+
+// 逐点取 3 帧 / 5 帧的中值
+void median3(const qint16 *a, const qint16 *b, const qint16 *c, qint16 *out, int count);
+void median5(const qint16 *a, const qint16 *b, const qint16 *c, const qint16 *d, const qint16 *e,
+             qint16 *out, int count);
+
+// [1 2 1] x [1 2 1] / 16 平滑（边界按复制处理），frame 按 height 行、width 列排列
+// 用两次舍入的对半平均实现，与完整求和相比误差不超过 1；scratch 至少 width * height 项
+void smooth3x3(qint16 *frame, int width, int height, qint16 *scratch);
+
+// 对 |data[i]| <= limit 的项求和并计数（超过 limit 的视为触摸，不计入共模）
+void sumWithinLimit(const qint16 *data, int count, qint16 limit, qint32 &sum, qint32 &included);
+
+// 按列累加一行中 |row[i]| <= limit 的项：sums[i] += row[i]，counts[i] += 1
+void accumulateWithinLimit(const qint16 *row, int count, qint16 limit, qint32 *sums, qint32 *counts);
+
+// 按 height 行、width 列排列的数据求每行之和（height 项）和每列之和（width 项）
+void rowSums(const qint16 *data, int width, int height, qint32 *sums);
+void columnSums(const qint16 *data, int width, int height, qint32 *sums);
+
+} // namespace SimdKernels
+
+#endif // SIMDKERNELS_H
@@ -0,0 +1,177 @@
+#include "spectrumplot.h"
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPolygonF>
+#include <algorithm>
+
+// 坐标轴文字所占的留白
+static const int kLeftMargin = 56;
+static const int kBottomMargin = 22;
+static const int kTopMargin = 22;
+static const int kRightMargin = 12;
+
+SpectrumPlot::SpectrumPlot(QWidget *parent)
+    : QWidget(parent)
+    , binWidth(0.0)
+    , selectedBin(-1)
+{
+    setMinimumSize(320, 200);
+}
+
+QSize SpectrumPlot::sizeHint() const
+{
+    return QSize(640, 320);
+}
+
+void SpectrumPlot::setSpectra(const float *mean, const float *node, int binCount, double binWidthHz)
+{
+    meanValues.resize(binCount);
+    std::copy(mean, mean + binCount, meanValues.begin());
+    if (node) {
+        nodeValues.resize(binCount);
+        std::copy(node, node + binCount, nodeValues.begin());
+    } else {
+        nodeValues.clear();
+    }
+    binWidth = binWidthHz;
+    if (selectedBin >= binCount) {
+        selectedBin = -1;
+    }
+    update();
+}
+
+void SpectrumPlot::setNodeLabel(const QString &text)
+{
+    nodeLabel = text;
+    update();
+}
+
+void SpectrumPlot::setSelectedBin(int bin)
+{
+    selectedBin = bin;
+    update();
+}
+
+void SpectrumPlot::clearSpectra()
+{
+    meanValues.clear();
+    nodeValues.clear();
+    selectedBin = -1;
+    update();
+}
+
+QRect SpectrumPlot::plotRect() const
+{
+    return QRect(kLeftMargin, kTopMargin, width() - kLeftMargin - kRightMargin,
+                 height() - kTopMargin - kBottomMargin);
+}
+
+int SpectrumPlot::binAt(int x) const
+{
+    const QRect area = plotRect();
+    if (meanValues.size() < 2 || area.width() <= 0) {
+        return -1;
+    }
+    const double position = double(x - area.left()) / area.width();
+    return qBound(0, int(position * (meanValues.size() - 1) + 0.5), meanValues.size() - 1);
+}
+
+void SpectrumPlot::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton || !plotRect().contains(event->pos())) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+    const int bin = binAt(event->pos().x());
+    if (bin >= 0) {
+        setSelectedBin(bin);
+        emit binSelected(bin);
+    }
+}
+
+void SpectrumPlot::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#FFFFFF"));
+    const QRect area = plotRect();
+    painter.setPen(QColor("#66CCFF"));
+    painter.drawRect(area.adjusted(0, 0, -1, -1));
+
+    painter.setPen(QColor("#003D7A"));
+    if (meanValues.size() < 2 || area.width() <= 0 || area.height() <= 0) {
+        painter.drawText(rect(), Qt::AlignCenter, tr("无数据"));
+        return;
+    }
+
+    // 直流已在分析时去除，满刻度按其余频点的最大值
+    const int binCount = meanValues.size();
+    float peak = 0.0f;
+    for (int k = 1; k < binCount; ++k) {
+        peak = qMax(peak, meanValues[k]);
+        if (!nodeValues.isEmpty()) {
+            peak = qMax(peak, nodeValues[k]);
+        }
+    }
+    if (peak <= 0.0f) {
+        peak = 1.0f;
+    }
+
+    // 每个像素列取该列覆盖频点中的最大值
+    auto curve = [&](const QVector<float> &values) {
+        QPolygonF points;
+        points.reserve(area.width());
+        for (int x = 0; x < area.width(); ++x) {
+            const int first = int(qint64(x) * (binCount - 1) / area.width());
+            const int last = qMax(first, int(qint64(x + 1) * (binCount - 1) / area.width()));
+            float value = values[first];
+            for (int k = first + 1; k <= last; ++k) {
+                value = qMax(value, values[k]);
+            }
+            const double y = area.bottom() - double(value) / peak * (area.height() - 1);
+            points.append(QPointF(area.left() + x, qMax(double(area.top()), y)));
+        }
+        return points;
+    };
+
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setPen(QPen(QColor("#A0A0A0"), 1));
+    painter.drawPolyline(curve(meanValues));
+    if (!nodeValues.isEmpty()) {
+        painter.setPen(QPen(QColor("#0078D4"), 1.5));
+        painter.drawPolyline(curve(nodeValues));
+    }
+    painter.setRenderHint(QPainter::Antialiasing, false);
+
+    // 坐标轴刻度：频率 0、1/4、1/2、3/4、奈奎斯特，幅度只标满刻度
+    const int textHeight = fontMetrics().height();
+    painter.setPen(QColor("#003D7A"));
+    const double nyquist = binWidth * (binCount - 1);
+    for (int i = 0; i <= 4; ++i) {
+        const int x = area.left() + area.width() * i / 4;
+        QRect labelRect(x - 40, area.bottom() + 2, 80, textHeight);
+        painter.drawText(labelRect, Qt::AlignHCenter | Qt::AlignTop, tr("%1 Hz").arg(nyquist * i / 4, 0, 'f', 1));
+    }
+    painter.drawText(QRect(0, area.top(), kLeftMargin - 4, textHeight), Qt::AlignRight | Qt::AlignTop,
+                     QString::number(peak, 'f', peak < 10.0f ? 2 : 0));
+    painter.drawText(QRect(0, area.bottom() - textHeight, kLeftMargin - 4, textHeight),
+                     Qt::AlignRight | Qt::AlignBottom, QStringLiteral("0"));
+
+    QString legend = tr("灰: 全部节点平均");
+    if (!nodeValues.isEmpty() && !nodeLabel.isEmpty()) {
+        legend += tr("  蓝: %1").arg(nodeLabel);
+    }
+    painter.drawText(QRect(area.left(), 0, area.width(), kTopMargin), Qt::AlignLeft | Qt::AlignVCenter, legend);
+
+    // 选中频点
+    if (selectedBin >= 0 && selectedBin < binCount) {
+        const double x = area.left() + double(selectedBin) / (binCount - 1) * (area.width() - 1);
+        painter.setPen(QPen(QColor("#FA78E0"), 1, Qt::DashLine));
+        painter.drawLine(QPointF(x, area.top()), QPointF(x, area.bottom()));
+        const float value = nodeValues.isEmpty() ? meanValues[selectedBin] : nodeValues[selectedBin];
+        painter.setPen(QColor("#003D7A"));
+        painter.drawText(QRect(area.left(), 0, area.width(), kTopMargin), Qt::AlignRight | Qt::AlignVCenter,
+                         tr("%1 Hz  幅度 %2").arg(selectedBin * binWidth, 0, 'f', 2).arg(value, 0, 'f', 2));
+    }
+}
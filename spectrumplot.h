@@ -0,0 +1,41 @@
+#ifndef SPECTRUMPLOT_H
+#define SPECTRUMPLOT_H
+
+#include <QWidget>
+#include <QVector>
+
+// 幅度谱折线图：所有节点的平均谱（灰）和选中节点的谱（蓝），点击选择频点
+// 频点多于像素时每列取最大值绘制，窄峰不会被抽样漏掉
+class SpectrumPlot : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SpectrumPlot(QWidget *parent = nullptr);
+
+    void setSpectra(const float *mean, const float *node, int binCount, double binWidthHz);
+    void setNodeLabel(const QString &text);
+    void setSelectedBin(int bin);
+    void clearSpectra();
+
+    QSize sizeHint() const override;
+
+signals:
+    void binSelected(int bin);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+
+private:
+    QRect plotRect() const;
+    int binAt(int x) const;
+
+    QVector<float> meanValues;
+    QVector<float> nodeValues;
+    double binWidth;                 // 每个频点的宽度（Hz）
+    int selectedBin;                 // -1 表示未选择
+    QString nodeLabel;
+};
+
+#endif // SPECTRUMPLOT_H
@@ -0,0 +1,425 @@
+#include "syntheticcapture.h"
+#include "framearchive.h"
+#include "framestore.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QRandomGenerator>
+#include <QtMath>
+#include <cstdio>
+
+namespace {
+
+const int kWriteBufferBytes = 1024 * 1024;
+const quint32 kCorruptionSeed = 0x9E3779B9u;     // 损坏记录使用独立的随机序列，不影响有效帧的内容
+
+// 高斯随机数（Box-Muller，每次生成一对）
+class GaussianSource
+{
+public:
+    explicit GaussianSource(quint32 seed) : rng(seed), hasSpare(false), spare(0.0) {}
+
+    double next()
+    {
+        if (hasSpare) {
+            hasSpare = false;
+            return spare;
+        }
+        double u = 0.0;
+        while (u <= 0.0) {
+            u = rng.generateDouble();
+        }
+        const double radius = qSqrt(-2.0 * qLn(u));
+        const double angle = 2.0 * M_PI * rng.generateDouble();
+        spare = radius * qSin(angle);
+        hasSpare = true;
+        return radius * qCos(angle);
+    }
+
+    QRandomGenerator rng;
+
+private:
+    bool hasSpare;
+    double spare;
+};
+
+// 按配置逐帧生成原始值
+class FrameSynthesizer
+{
+public:
+    explicit FrameSynthesizer(const SyntheticCaptureConfig &config)
+        : config(config)
+        , noise(config.seed)
+        , frame(0)
+    {
+        const int frameSize = config.rxCount * config.txCount;
+        base.resize(frameSize);
+        for (int i = 0; i < frameSize; ++i) {
+            base[i] = qint16(quint16(qBound(0, config.baselineLevel
+                + (config.baselineSpread > 0 ? int(noise.rng.bounded(config.baselineSpread)) : 0), 65535)));
+        }
+        touch.resize(frameSize);
+    }
+
+    const QVector<qint16> &baseline() const { return base; }
+
+    void nextFrame(qint16 *out)
+    {
+        const int rx = config.rxCount;
+        const int tx = config.txCount;
+        touch.fill(0.0);
+
+        // 各触摸点的轨迹频率不同，长时间播放时位置不会重复得太快；只计算高斯核 4 倍半径内的节点
+        const double phase = frame * 0.02;
+        const double sigma2 = 2.0 * config.touchRadius * config.touchRadius;
+        const int reach = qMax(1, qCeil(4.0 * config.touchRadius));
+        for (int k = 0; k < config.touchCount && sigma2 > 0.0; ++k) {
+            const double cx = (rx - 1) * (0.5 + 0.4 * qSin(phase * (1.0 + 0.31 * k) + k));
+            const double cy = (tx - 1) * (0.5 + 0.4 * qCos(phase * (0.7 + 0.23 * k) + 2.0 * k));
+            const int x0 = qMax(0, int(cx) - reach), x1 = qMin(rx - 1, int(cx) + reach);
+            const int y0 = qMax(0, int(cy) - reach), y1 = qMin(tx - 1, int(cy) + reach);
+            for (int y = y0; y <= y1; ++y) {
+                for (int x = x0; x <= x1; ++x) {
+                    const double d2 = (x - cx) * (x - cx) + (y - cy) * (y - cy);
+                    touch[y * rx + x] += config.touchAmplitude * qExp(-d2 / sigma2);
+                }
+            }
+        }
+
+        const double periodic = config.periodicAmplitude * qSin(2.0 * M_PI * config.periodicCycles * frame);
+        for (int y = 0; y < tx; ++y) {
+            const double commonMode = config.commonModeSigma > 0.0 ? config.commonModeSigma * noise.next() : 0.0;
+            for (int x = 0; x < rx; ++x) {
+                const int index = y * rx + x;
+                double value = quint16(base[index]) - touch[index] + commonMode + periodic;
+                if (config.noiseSigma > 0.0) {
+                    value += config.noiseSigma * noise.next();
+                }
+                out[index] = qint16(quint16(qBound(qint64(0), qRound64(value), qint64(65535))));
+            }
+        }
+        ++frame;
+    }
+
+private:
+    const SyntheticCaptureConfig &config;
+    GaussianSource noise;
+    QVector<qint16> base;
+    QVector<double> touch;
+    int frame;
+};
+
+void putValue(uchar *out, quint64 value, int bytes, bool bigEndian)
+{
+    for (int i = 0; i < bytes; ++i) {
+        const int shift = 8 * (bigEndian ? bytes - 1 - i : i);
+        out[i] = uchar((value >> shift) & 0xFF);
+    }
+}
+
+// 一条记录的字节：填充、帧头、时间戳、帧序号、数据
+void encodeRecord(const SyntheticCaptureConfig &config, const qint16 *frame, int index, QByteArray &record)
+{
+    const int frameSize = config.rxCount * config.txCount;
+    record.fill('\0', config.rawDataPos() + frameSize * 2);
+    uchar *bytes = reinterpret_cast<uchar *>(record.data());
+    for (int i = 0; i < config.header.size(); ++i) {
+        bytes[config.filterStartPos + i] = config.header[i];
+    }
+    if (config.timestamps) {
+        putValue(bytes + config.timestampPos(), quint64(index) * quint64(config.frameIntervalUs) & 0xFFFFFFFFu, 4,
+                 config.isBigEndian);
+    }
+    if (config.sequences) {
+        putValue(bytes + config.sequencePos(), quint64(index) & 0xFFFF, 2, config.isBigEndian);
+    }
+    uchar *data = bytes + config.rawDataPos();
+    for (int i = 0; i < frameSize; ++i) {
+        putValue(data + i * 2, quint16(frame[i]), 2, config.isBigEndian);
+    }
+}
+
+void appendCsvLine(const QByteArray &record, int length, QByteArray &buffer)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    for (int i = 0; i < length; ++i) {
+        const uchar value = uchar(record[i]);
+        if (i > 0) {
+            buffer.append(',');
+        }
+        buffer.append(digits[value >> 4]);
+        buffer.append(digits[value & 0xF]);
+    }
+    buffer.append('\n');
+}
+
+// 损坏的记录：文本截断到帧头之后的某处或把一个数据字段换成非法字符，二进制破坏帧头
+void appendMalformed(const SyntheticCaptureConfig &config, const QByteArray &record, QRandomGenerator &rng,
+                     QByteArray &buffer)
+{
+    if (config.format == SyntheticCaptureConfig::BinaryFormat) {
+        QByteArray broken = record;
+        broken[config.filterStartPos] = char(~config.header[0]);
+        buffer.append(broken);
+        return;
+    }
+
+    const int headerEnd = config.filterStartPos + config.header.size();
+    if (rng.bounded(2) == 0) {
+        appendCsvLine(record, headerEnd + rng.bounded(record.size() - headerEnd), buffer);
+    } else {
+        const int lineStart = buffer.size();
+        appendCsvLine(record, record.size(), buffer);
+        const int field = config.rawDataPos() + rng.bounded(record.size() - config.rawDataPos());
+        buffer[lineStart + field * 3] = 'G';
+    }
+}
+
+bool parseHeader(const QString &text, QVector<quint8> &header)
+{
+    QString digits = text;
+    digits.remove(',').remove(' ');
+    if (digits.isEmpty() || digits.size() % 2 != 0) {
+        return false;
+    }
+    header.clear();
+    for (int i = 0; i < digits.size(); i += 2) {
+        bool ok = false;
+        const uint value = digits.mid(i, 2).toUInt(&ok, 16);
+        if (!ok) {
+            return false;
+        }
+        header.append(quint8(value));
+    }
+    return true;
+}
+
+} // namespace
+
+QString SyntheticCaptureConfig::suffix() const
+{
+    switch (format) {
+    case BinaryFormat:
+        return QStringLiteral("bin");
+    case ArchiveFormat:
+        return QString::fromLatin1(FrameArchive::suffix());
+    default:
+        return QStringLiteral("csv");
+    }
+}
+
+ParseSettings SyntheticCaptureConfig::parseSettings() const
+{
+    ParseSettings settings;
+    settings.rxCount = rxCount;
+    settings.txCount = txCount;
+    settings.rawDataPos = rawDataPos();
+    settings.filterStartPos = filterStartPos;
+    settings.filterMode = 0;
+    settings.isBigEndian = isBigEndian;
+    settings.maxRows = 0;
+    for (quint8 value : header) {
+        settings.pattern.append(QString::number(value, 16).rightJustified(2, '0').toUpper());
+    }
+    settings.inputFormat = (format == BinaryFormat) ? ParseSettings::BinaryFormat : ParseSettings::TextFormat;
+    settings.timestampPos = timestampPos();
+    settings.timestampBytes = 4;
+    settings.timestampUnitUs = 1;
+    settings.sequencePos = sequencePos();
+    settings.sequenceBytes = 2;
+    return settings;
+}
+
+void SyntheticCapture::generate(const SyntheticCaptureConfig &config, FrameStore &frames, QVector<qint16> &baseline)
+{
+    FrameSynthesizer synthesizer(config);
+    frames.reset(config.rxCount * config.txCount);
+    for (int f = 0; f < config.frameCount; ++f) {
+        synthesizer.nextFrame(frames.appendFrame());
+    }
+    frames.squeeze();
+    baseline = synthesizer.baseline();
+}
+
+int SyntheticCapture::write(const QString &filePath, const SyntheticCaptureConfig &config, QString *error)
+{
+    if (config.rxCount <= 0 || config.txCount <= 0 || config.frameCount <= 0 || config.header.isEmpty()) {
+        if (error) {
+            *error = QStringLiteral("rx/tx/frames must be positive and header must not be empty");
+        }
+        return -1;
+    }
+
+    if (config.format == SyntheticCaptureConfig::ArchiveFormat) {
+        FrameStore frames;
+        QVector<qint16> baseline;
+        generate(config, frames, baseline);
+        if (!FrameArchive::write(filePath, frames, config.rxCount, config.txCount, baseline)) {
+            if (error) {
+                *error = QStringLiteral("cannot write %1").arg(filePath);
+            }
+            return -1;
+        }
+        return frames.frameCount();
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) {
+            *error = QStringLiteral("cannot open %1").arg(filePath);
+        }
+        return -1;
+    }
+
+    // 逐帧生成并写出，大文件不需要把所有帧放在内存中
+    FrameSynthesizer synthesizer(config);
+    QRandomGenerator corruption(config.seed ^ kCorruptionSeed);
+    QVector<qint16> frame(config.rxCount * config.txCount);
+    QByteArray record;
+    QByteArray buffer;
+    buffer.reserve(kWriteBufferBytes + 8 * config.rxCount * config.txCount);
+    const bool binary = (config.format == SyntheticCaptureConfig::BinaryFormat);
+    for (int f = 0; f < config.frameCount; ++f) {
+        synthesizer.nextFrame(frame.data());
+        encodeRecord(config, frame.constData(), f, record);
+        if (config.malformedRate > 0.0 && corruption.generateDouble() < config.malformedRate) {
+            appendMalformed(config, record, corruption, buffer);
+        }
+        if (binary) {
+            buffer.append(record);
+        } else {
+            appendCsvLine(record, record.size(), buffer);
+        }
+        if (buffer.size() >= kWriteBufferBytes || f == config.frameCount - 1) {
+            if (file.write(buffer) != buffer.size()) {
+                if (error) {
+                    *error = QStringLiteral("write failed: %1").arg(file.errorString());
+                }
+                return -1;
+            }
+            buffer.clear();
+        }
+    }
+    return config.frameCount;
+}
+
+bool SyntheticCapture::parseArguments(const QStringList &arguments, SyntheticCaptureConfig &config, QString &error)
+{
+    for (const QString &argument : arguments) {
+        const int split = argument.indexOf('=');
+        const QString key = argument.left(split).trimmed().toLower();
+        const QString value = argument.mid(split + 1).trimmed();
+        if (split <= 0) {
+            error = QStringLiteral("expected key=value: %1").arg(argument);
+            return false;
+        }
+
+        bool ok = true;
+        if (key == "rx") {
+            config.rxCount = value.toInt(&ok);
+        } else if (key == "tx") {
+            config.txCount = value.toInt(&ok);
+        } else if (key == "frames") {
+            config.frameCount = value.toInt(&ok);
+        } else if (key == "seed") {
+            config.seed = value.toUInt(&ok);
+        } else if (key == "format") {
+            ok = (value == "csv" || value == "binary" || value == "rgdf");
+            config.format = value == "binary" ? SyntheticCaptureConfig::BinaryFormat
+                            : value == "rgdf" ? SyntheticCaptureConfig::ArchiveFormat
+                                              : SyntheticCaptureConfig::CsvFormat;
+        } else if (key == "baseline") {
+            config.baselineLevel = value.toInt(&ok);
+        } else if (key == "spread") {
+            config.baselineSpread = value.toInt(&ok);
+        } else if (key == "noise") {
+            config.noiseSigma = value.toDouble(&ok);
+        } else if (key == "common") {
+            config.commonModeSigma = value.toDouble(&ok);
+        } else if (key == "periodic") {
+            config.periodicAmplitude = value.toDouble(&ok);
+        } else if (key == "cycles") {
+            config.periodicCycles = value.toDouble(&ok);
+        } else if (key == "touches") {
+            config.touchCount = value.toInt(&ok);
+        } else if (key == "amplitude") {
+            config.touchAmplitude = value.toInt(&ok);
+        } else if (key == "radius") {
+            config.touchRadius = value.toDouble(&ok);
+        } else if (key == "header") {
+            ok = parseHeader(value, config.header);
+        } else if (key == "filter-start") {
+            config.filterStartPos = value.toInt(&ok);
+        } else if (key == "endian") {
+            ok = (value == "big" || value == "little");
+            config.isBigEndian = (value != "little");
+        } else if (key == "timestamps") {
+            config.timestamps = (value.toInt(&ok) != 0);
+        } else if (key == "interval-us") {
+            config.frameIntervalUs = value.toInt(&ok);
+        } else if (key == "sequences") {
+            config.sequences = (value.toInt(&ok) != 0);
+        } else if (key == "malformed") {
+            config.malformedRate = value.toDouble(&ok);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            error = QStringLiteral("invalid argument: %1").arg(argument);
+            return false;
+        }
+    }
+    return true;
+}
+
+int SyntheticCapture::runFromCommandLine(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s --generate <file> [rx=40 tx=70 frames=5000 seed=1 format=csv|binary|rgdf\n"
+                             "       noise=3 common=0 periodic=0 cycles=0.1 touches=2 amplitude=600 radius=1.5\n"
+                             "       header=AA55 filter-start=0 endian=big|little timestamps=0 interval-us=8333\n"
+                             "       sequences=0 malformed=0 baseline=2000 spread=50]\n", argv[0]);
+        return 2;
+    }
+
+    // 没有指定格式时按扩展名判断
+    const QString filePath = QString::fromLocal8Bit(argv[2]);
+    SyntheticCaptureConfig config;
+    const QString suffix = QFileInfo(filePath).suffix().toLower();
+    if (suffix == "bin") {
+        config.format = SyntheticCaptureConfig::BinaryFormat;
+    } else if (suffix == QLatin1String(FrameArchive::suffix())) {
+        config.format = SyntheticCaptureConfig::ArchiveFormat;
+    }
+
+    QStringList arguments;
+    for (int i = 3; i < argc; ++i) {
+        arguments << QString::fromLocal8Bit(argv[i]);
+    }
+    QString error;
+    if (!parseArguments(arguments, config, error)) {
+        std::fprintf(stderr, "generate: %s\n", qPrintable(error));
+        return 2;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const int frames = write(filePath, config, &error);
+    if (frames < 0) {
+        std::fprintf(stderr, "generate: %s\n", qPrintable(error));
+        return 1;
+    }
+
+    const ParseSettings settings = config.parseSettings();
+    QStringList header;
+    for (const QString &value : settings.pattern) {
+        header << value;
+    }
+    std::fprintf(stderr, "generated %d frames %dx%d (%s, %s endian) -> %s in %lld ms\n"
+                         "read with: raw data pos=%d filter start=%d header=%s timestamp pos=%d sequence pos=%d\n",
+                 frames, config.rxCount, config.txCount, qPrintable(config.suffix()),
+                 config.isBigEndian ? "big" : "little", qPrintable(filePath), static_cast<long long>(timer.elapsed()),
+                 settings.rawDataPos, settings.filterStartPos, qPrintable(header.join(' ')),
+                 settings.timestampPos, settings.sequencePos);
+    return 0;
+}
@@ -0,0 +1,74 @@
+#ifndef SYNTHETICCAPTURE_H
+#define SYNTHETICCAPTURE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "touchdataparser.h"
+
+class FrameStore;
+
+// 合成采集的参数：面板尺寸、噪声模型、模拟触摸和记录格式
+// 每条记录依次为 filterStartPos 个填充字节、帧头、可选的时间戳（4 字节）和帧序号（2 字节）、rx*tx*2 字节数据
+struct SyntheticCaptureConfig
+{
+    enum Format {
+        CsvFormat,                 // 逗号分隔的十六进制文本，一条记录一行
+        BinaryFormat,              // 定长二进制记录首尾相接
+        ArchiveFormat              // .rgdf 归档（同时保存基线）
+    };
+
+    int rxCount = 40;
+    int txCount = 70;
+    int frameCount = 5000;
+    quint32 seed = 1;
+    Format format = CsvFormat;
+
+    // 噪声模型：节点基线 + 白噪声 + 每行（tx）的共模噪声 + 正弦周期干扰
+    int baselineLevel = 2000;
+    int baselineSpread = 50;       // 节点之间基线的差异范围
+    double noiseSigma = 3.0;       // 每个采样的高斯白噪声
+    double commonModeSigma = 0.0;  // 每帧每行的共模噪声
+    double periodicAmplitude = 0.0;
+    double periodicCycles = 0.1;   // 周期干扰每帧前进的周期数（干扰频率 / 帧率）
+
+    // 模拟触摸：每个触摸点沿各自的轨迹移动，信号为高斯形状（原始值低于基线）
+    int touchCount = 2;
+    int touchAmplitude = 600;
+    double touchRadius = 1.5;      // 高斯半径（节点）
+
+    // 记录格式
+    QVector<quint8> header = {0xAA, 0x55};
+    int filterStartPos = 0;        // 帧头所在的列（字节）
+    bool isBigEndian = true;
+    bool timestamps = false;       // 帧头后写 4 字节时间戳（微秒）
+    int frameIntervalUs = 8333;
+    bool sequences = false;        // 时间戳后写 2 字节帧序号
+    double malformedRate = 0.0;    // 损坏记录的比例：文本截断或写入非法字符，二进制破坏帧头
+
+    int timestampPos() const { return timestamps ? filterStartPos + header.size() : -1; }
+    int sequencePos() const { return sequences ? filterStartPos + header.size() + (timestamps ? 4 : 0) : -1; }
+    int rawDataPos() const { return filterStartPos + header.size() + (timestamps ? 4 : 0) + (sequences ? 2 : 0); }
+    QString suffix() const;
+    ParseSettings parseSettings() const;    // 读取生成的文件所用的解析参数
+};
+
+// 合成采集生成器：可复现慢速场景而不必传递客户的日志
+// 同样的配置和种子总是生成同样的文件；损坏的记录不计入有效帧
+class SyntheticCapture
+{
+public:
+    // 只生成有效帧（不含损坏的记录）；baseline 为无噪声、无触摸的节点基线
+    static void generate(const SyntheticCaptureConfig &config, FrameStore &frames, QVector<qint16> &baseline);
+
+    // 写入文件，返回有效帧数；失败时返回 -1 并在 error 中说明原因
+    static int write(const QString &filePath, const SyntheticCaptureConfig &config, QString *error = nullptr);
+
+    // 解析 key=value 形式的参数，如 rx=40 tx=70 frames=5000 format=binary header=AA55 endian=little
+    static bool parseArguments(const QStringList &arguments, SyntheticCaptureConfig &config, QString &error);
+
+    // 命令行：RGD_FAE --generate <文件> [key=value ...]，返回进程退出码
+    static int runFromCommandLine(int argc, char *argv[]);
+};
+
+#endif // SYNTHETICCAPTURE_H
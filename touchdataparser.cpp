@@ -0,0 +1,427 @@
+#include "touchdataparser.h"
+#include "framestore.h"
+#include "touchinputreader.h"
+#include <QFile>
+#include <cstring>
+
+namespace {
+
+inline bool isAsciiSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline char asciiUpper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? char(c - 'a' + 'A') : c;
+}
+
+inline int hexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+inline void trimField(const char *&b, const char *&e)
+{
+    while (b < e && isAsciiSpace(*b)) ++b;
+    while (e > b && isAsciiSpace(*(e - 1))) --e;
+}
+
+// 与 QString::toUInt(&ok, 16) 一致：可选 '+'、可选 0x 前缀、至少一位十六进制数、不超过 32 位
+inline bool parseHexField(const char *b, const char *e, quint8 &byte)
+{
+    trimField(b, e);
+    // 旧版解析会先去掉一次 0x 前缀，再交给 toUInt（toUInt 本身也接受 0x）
+    if (e - b >= 2 && b[0] == '0' && (b[1] == 'x' || b[1] == 'X')) {
+        b += 2;
+    }
+    if (b < e && *b == '+') {
+        ++b;
+    }
+    if (e - b >= 2 && b[0] == '0' && (b[1] == 'x' || b[1] == 'X')) {
+        b += 2;
+    }
+    if (b == e) {
+        return false;
+    }
+
+    quint64 value = 0;
+    for (; b < e; ++b) {
+        int digit = hexDigitValue(*b);
+        if (digit < 0) {
+            return false;
+        }
+        value = (value << 4) | quint64(digit);
+        if (value > 0xFFFFFFFFull) {
+            return false;
+        }
+    }
+    byte = quint8(value);
+    return true;
+}
+
+// 与 matchFilterPattern 的规范化一致：去空白、转大写、去 0X 前缀、左侧补 0 到两位
+inline bool fieldEquals(const char *b, const char *e, const QByteArray &pattern)
+{
+    trimField(b, e);
+    if (e - b >= 2 && b[0] == '0' && asciiUpper(b[1]) == 'X') {
+        b += 2;
+    }
+
+    int length = int(e - b);
+    int padding = length < 2 ? 2 - length : 0;
+    if (length + padding != pattern.size()) {
+        return false;
+    }
+
+    const char *p = pattern.constData();
+    for (int i = 0; i < padding; ++i) {
+        if (p[i] != '0') {
+            return false;
+        }
+    }
+    for (int i = 0; i < length; ++i) {
+        if (asciiUpper(b[i]) != p[padding + i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 逐列遍历一行 CSV；next() 在列不存在时返回 false
+class FieldCursor
+{
+public:
+    FieldCursor(const char *begin, const char *end) : p(begin), limit(end), exhausted(false) {}
+
+    bool next(const char *&fieldBegin, const char *&fieldEnd)
+    {
+        if (exhausted) {
+            return false;
+        }
+        const void *comma = std::memchr(p, ',', size_t(limit - p));
+        fieldBegin = p;
+        if (comma) {
+            fieldEnd = static_cast<const char *>(comma);
+            p = fieldEnd + 1;
+        } else {
+            fieldEnd = limit;
+            exhausted = true;
+        }
+        return true;
+    }
+
+    bool skip(int fields)
+    {
+        const char *b;
+        const char *e;
+        for (int i = 0; i < fields; ++i) {
+            if (!next(b, e)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    const char *p;
+    const char *limit;
+    bool exhausted;
+};
+
+// 将整个文件映射到内存；映射失败时退回一次性读取
+class MappedFile
+{
+public:
+    explicit MappedFile(const QString &filePath) : file(filePath), mapped(nullptr) {}
+
+    bool open()
+    {
+        if (!file.open(QIODevice::ReadOnly)) {
+            return false;
+        }
+        if (file.size() > 0) {
+            mapped = file.map(0, file.size());
+        }
+        if (!mapped) {
+            buffer = file.readAll();
+        }
+        return true;
+    }
+
+    const char *begin() const { return mapped ? reinterpret_cast<const char *>(mapped) : buffer.constData(); }
+    const char *end() const { return begin() + (mapped ? file.size() : buffer.size()); }
+
+private:
+    QFile file;
+    uchar *mapped;
+    QByteArray buffer;
+};
+
+} // namespace
+
+QVector<QByteArray> TouchDataParser::normalizePattern(const QVector<QString> &pattern)
+{
+    QVector<QByteArray> normalized;
+    normalized.reserve(pattern.size());
+    for (const QString &value : pattern) {
+        QString patternValue = value.toUpper();
+        if (patternValue.startsWith("0X")) {
+            patternValue = patternValue.mid(2);
+        }
+        while (patternValue.length() < 2) patternValue = "0" + patternValue;
+        normalized.append(patternValue.toUtf8());
+    }
+    return normalized;
+}
+
+bool TouchDataParser::matchLine(const char *begin, const char *end, int startPos, const QVector<QByteArray> &pattern)
+{
+    // 列数需至少为 startPos + pattern.size()
+    FieldCursor cursor(begin, end);
+    if (!cursor.skip(startPos)) {
+        return false;
+    }
+
+    const char *fieldBegin;
+    const char *fieldEnd;
+    for (const QByteArray &value : pattern) {
+        if (!cursor.next(fieldBegin, fieldEnd) || !fieldEquals(fieldBegin, fieldEnd, value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int TouchDataParser::decodeLine(const char *begin, const char *end, int startPos, int count,
+                                bool isBigEndian, qint16 *out)
+{
+    // 列数不足 startPos + count 时与旧版一样返回空结果
+    FieldCursor cursor(begin, end);
+    if (count <= 0 || !cursor.skip(startPos)) {
+        return 0;
+    }
+
+    int decoded = 0;
+    const char *b1;
+    const char *e1;
+    const char *b2;
+    const char *e2;
+    for (int i = 0; i < count; i += 2) {
+        if (!cursor.next(b1, e1) || !cursor.next(b2, e2)) {
+            return 0;
+        }
+
+        // 无效的十六进制数会被跳过（与旧版一致），调用方据此丢弃整帧
+        quint8 byte1, byte2;
+        if (parseHexField(b1, e1, byte1) && parseHexField(b2, e2, byte2)) {
+            out[decoded++] = isBigEndian ? qint16((byte1 << 8) | byte2)
+                                         : qint16((byte2 << 8) | byte1);
+        }
+    }
+    return decoded;
+}
+
+bool TouchDataParser::decodeField(const char *begin, const char *end, int startPos, int byteCount,
+                                  bool isBigEndian, quint64 &value)
+{
+    FieldCursor cursor(begin, end);
+    if (byteCount <= 0 || byteCount > 8 || !cursor.skip(startPos)) {
+        return false;
+    }
+
+    value = 0;
+    const char *b;
+    const char *e;
+    for (int i = 0; i < byteCount; ++i) {
+        quint8 byte;
+        if (!cursor.next(b, e) || !parseHexField(b, e, byte)) {
+            return false;
+        }
+        if (isBigEndian) {
+            value = (value << 8) | byte;
+        } else {
+            value |= quint64(byte) << (8 * i);
+        }
+    }
+    return true;
+}
+
+ParseDiagnostics::Reason TouchDataParser::diagnoseLine(const char *begin, const char *end, int startPos, int count,
+                                                       int &column)
+{
+    // 去掉行尾的 '\r' 后仍为空的行单独归类
+    const char *trimmedEnd = end;
+    if (trimmedEnd > begin && *(trimmedEnd - 1) == '\r') {
+        --trimmedEnd;
+    }
+    column = 0;
+    if (trimmedEnd == begin) {
+        return ParseDiagnostics::EmptyLine;
+    }
+
+    FieldCursor cursor(begin, end);
+    const char *b;
+    const char *e;
+    for (column = 0; column < startPos + count; ++column) {
+        if (!cursor.next(b, e)) {
+            return ParseDiagnostics::TooFewColumns;
+        }
+        quint8 byte;
+        if (column >= startPos && !parseHexField(b, e, byte)) {
+            return ParseDiagnostics::BadHex;
+        }
+    }
+    column = 0;
+    return ParseDiagnostics::None;
+}
+
+TouchDataParser::Status TouchDataParser::readFrames(const QString &filePath, const ParseSettings &settings,
+                                                    FrameStore &store, ParseDiagnostics *diagnostics,
+                                                    const QAtomicInt *cancel)
+{
+    return readStreams(filePath, settings, QVector<QVector<QString>>{settings.pattern}, QVector<FrameStore *>{&store},
+                       diagnostics, cancel);
+}
+
+TouchDataParser::Status TouchDataParser::readStreams(const QString &filePath, const ParseSettings &settings,
+                                                     const QVector<QVector<QString>> &patterns,
+                                                     const QVector<FrameStore *> &stores,
+                                                     ParseDiagnostics *diagnostics, const QAtomicInt *cancel)
+{
+    if (diagnostics) {
+        diagnostics->clear();
+    }
+
+    MappedFile file(filePath);
+    if (!file.open()) {
+        return OpenFailed;
+    }
+
+    const int streamCount = qMin(patterns.size(), stores.size());
+    for (int i = 0; i < streamCount; ++i) {
+        stores[i]->reset(settings.frameSize());
+        stores[i]->enableMetadata(settings.hasTimestamp(), settings.hasSequence() ? settings.sequenceBytes : 0);
+    }
+
+    // 帧头匹配和解码由文件格式对应的读取器完成
+    TouchInputReader::select(settings, file.begin(), file.end())
+        .readStreams(file.begin(), file.end(), settings, patterns, stores, diagnostics, cancel);
+
+    bool anyFrames = false;
+    for (int i = 0; i < streamCount; ++i) {
+        stores[i]->squeeze();
+        anyFrames = anyFrames || !stores[i]->isEmpty();
+    }
+    return anyFrames ? Ok : NoMatch;
+}
+
+TouchDataParser::Status TouchDataParser::readFirstFrame(const QString &filePath, const ParseSettings &settings,
+                                                        QVector<qint16> &frame, int *decodedCount)
+{
+    if (decodedCount) {
+        *decodedCount = 0;
+    }
+
+    MappedFile file(filePath);
+    if (!file.open()) {
+        return OpenFailed;
+    }
+
+    return TouchInputReader::select(settings, file.begin(), file.end())
+        .readFirstFrame(file.begin(), file.end(), settings, frame, decodedCount);
+}
+
+bool TouchDataParser::matchFilterPattern(const QStringList &data, int startPos, const QVector<QString> &pattern)
+{
+    // 检查是否有足够的数据进行匹配
+    if (startPos + pattern.size() > data.size()) {
+        return false;
+    }
+
+    // 逐个匹配
+    for (int i = 0; i < pattern.size(); ++i) {
+        QString dataValue = data[startPos + i].trimmed().toUpper();
+        QString patternValue = pattern[i].toUpper();
+
+        // 移除可能的0x前缀
+        if (dataValue.startsWith("0X")) {
+            dataValue = dataValue.mid(2);
+        }
+        if (patternValue.startsWith("0X")) {
+            patternValue = patternValue.mid(2);
+        }
+
+        // 确保是2位十六进制数
+        while (dataValue.length() < 2) dataValue = "0" + dataValue;
+        while (patternValue.length() < 2) patternValue = "0" + patternValue;
+
+        if (dataValue != patternValue) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QVector<qint16> TouchDataParser::parseCSVLine(const QString &line, int startPos, int count, bool isBigEndian)
+{
+    QVector<qint16> result;
+
+    // 分割CSV行
+    QStringList data = line.split(',');
+
+    // 移除所有数据的空白字符
+    for (QString &item : data) {
+        item = item.trimmed();
+    }
+
+    // 检查是否有足够的数据
+    if (startPos >= data.size() || startPos + count > data.size()) {
+        return result;
+    }
+
+    // 每两个8位数据组成一个16位数据
+    for (int i = 0; i < count; i += 2) {
+        if (startPos + i + 1 >= data.size()) {
+            break;
+        }
+
+        // 读取两个8位十六进制数
+        bool ok1, ok2;
+        QString hex1 = data[startPos + i].trimmed();
+        QString hex2 = data[startPos + i + 1].trimmed();
+
+        // 移除可能的0x前缀
+        if (hex1.startsWith("0x", Qt::CaseInsensitive)) {
+            hex1 = hex1.mid(2);
+        }
+        if (hex2.startsWith("0x", Qt::CaseInsensitive)) {
+            hex2 = hex2.mid(2);
+        }
+
+        quint8 byte1 = hex1.toUInt(&ok1, 16);
+        quint8 byte2 = hex2.toUInt(&ok2, 16);
+
+        if (!ok1 || !ok2) {
+            continue;
+        }
+
+        // 根据字节序组合
+        qint16 value;
+        if (isBigEndian) {
+            // 大端：第一个字节是高字节
+            value = (byte1 << 8) | byte2;
+        } else {
+            // 小端：第一个字节是低字节
+            value = (byte2 << 8) | byte1;
+        }
+
+        result.append(value);
+    }
+
+    return result;
+}
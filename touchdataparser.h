@@ -0,0 +1,93 @@
+#ifndef TOUCHDATAPARSER_H
+#define TOUCHDATAPARSER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QByteArray>
+#include <QAtomicInt>
+#include "parsediagnostics.h"
+
+class FrameStore;
+
+// 解析参数（从界面读取一次后传给工作线程，解析过程中不再访问界面）
+// 文本格式中各"列"指逗号分隔的列；二进制格式中指相对帧头所在记录起点的字节偏移
+struct ParseSettings
+{
+    enum InputFormat {
+        AutoFormat = 0,            // 按文件内容自动识别
+        TextFormat,                // 逗号分隔的十六进制文本（CSV）
+        BinaryFormat               // 二进制帧：定长记录，帧头字节 + 数据
+    };
+
+    int rxCount = 0;
+    int txCount = 0;
+    int rawDataPos = 0;            // 原始数据起始列
+    int filterStartPos = 0;        // 过滤起始列
+    int filterMode = 0;            // 0=本行, 1=下一行
+    bool isBigEndian = true;
+    int maxRows = 0;               // 最多读取的帧数，0 表示不限制
+    QVector<QString> pattern;      // 过滤字节（十六进制字符串）
+    int inputFormat = AutoFormat;  // InputFormat
+
+    // 帧附带信息（从数据行读取，字节按 isBigEndian 组合）；列号为 -1 表示不提取
+    int timestampPos = -1;         // 时间戳起始列
+    int timestampBytes = 4;        // 时间戳字节数（1-8，计数回绕时自动展开）
+    int timestampUnitUs = 1;       // 时间戳每个单位的微秒数（1=μs, 1000=ms）
+    int sequencePos = -1;          // 帧序号起始列
+    int sequenceBytes = 2;         // 帧序号字节数（1-4）
+
+    int frameSize() const { return rxCount * txCount; }
+    bool hasTimestamp() const { return timestampPos >= 0 && timestampBytes > 0; }
+    bool hasSequence() const { return sequencePos >= 0 && sequenceBytes > 0; }
+};
+
+class TouchDataParser
+{
+public:
+    enum Status {
+        Ok,
+        OpenFailed,        // 文件无法打开
+        NoMatch,           // 没有符合筛选条件的行
+        EmptyLine,         // 要读取的数据行为空
+        SizeMismatch       // 解析的数据量与 rx*tx 不符
+    };
+
+    // 读取所有匹配帧到 store（线程安全，可在工作线程中调用）
+    // 文件按 settings.inputFormat 交给文本或二进制读取器（见 TouchInputReader），以下读取函数相同
+    // diagnostics 非空时记录匹配了帧头但被丢弃的行（位置和原因）
+    // cancel 非空时每读一批行检查一次，置位后提前返回（已读出的帧保留，结果不完整）
+    static Status readFrames(const QString &filePath, const ParseSettings &settings, FrameStore &store,
+                             ParseDiagnostics *diagnostics = nullptr, const QAtomicInt *cancel = nullptr);
+
+    // 单遍分流：同一日志中交织的多种扫描类型按帧头分别存放，stores[i] 对应 patterns[i]
+    // 每行按顺序匹配，命中第一个帧头即归入该类型；settings.pattern 不使用，maxRows 对每种类型分别计数
+    // 任一类型读到帧即返回 Ok
+    static Status readStreams(const QString &filePath, const ParseSettings &settings,
+                              const QVector<QVector<QString>> &patterns, const QVector<FrameStore *> &stores,
+                              ParseDiagnostics *diagnostics = nullptr, const QAtomicInt *cancel = nullptr);
+
+    // 读取第一条匹配帧（基线），decodedCount 返回实际解析出的数据量
+    static Status readFirstFrame(const QString &filePath, const ParseSettings &settings,
+                                 QVector<qint16> &frame, int *decodedCount = nullptr);
+
+    // 快速路径：直接在字节上匹配/解析一行，不做任何堆分配
+    // pattern 需先经 normalizePattern() 处理
+    static QVector<QByteArray> normalizePattern(const QVector<QString> &pattern);
+    static bool matchLine(const char *begin, const char *end, int startPos, const QVector<QByteArray> &pattern);
+    static int decodeLine(const char *begin, const char *end, int startPos, int count, bool isBigEndian, qint16 *out);
+    // 从 startPos 列起读取 byteCount 个字节组成一个无符号整数（最多 8 字节）
+    static bool decodeField(const char *begin, const char *end, int startPos, int byteCount,
+                            bool isBigEndian, quint64 &value);
+
+    // 慢路径：找出 [startPos, startPos + count) 中第一个出错的列（column），只在解析失败后调用
+    // 返回 None 表示这些列都能解析（与 decodeLine 解析出 count / 2 个数据等价）
+    static ParseDiagnostics::Reason diagnoseLine(const char *begin, const char *end, int startPos, int count,
+                                                 int &column);
+
+    // 参考实现：保持最初 QString 版本的解析语义，供对照使用
+    static QVector<qint16> parseCSVLine(const QString &line, int startPos, int count, bool isBigEndian);
+    static bool matchFilterPattern(const QStringList &data, int startPos, const QVector<QString> &pattern);
+};
+
+#endif // TOUCHDATAPARSER_H
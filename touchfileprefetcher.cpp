@@ -0,0 +1,107 @@
+#include "touchfileprefetcher.h"
+#include <QDateTime>
+#include <QFileInfo>
+#include <QStringList>
+#include <QtConcurrent>
+
+TouchFilePrefetcher::~TouchFilePrefetcher()
+{
+    // 解析在下一批行处停止，退出前等待工作线程结束
+    if (cancel) {
+        cancel->storeRelaxed(1);
+    }
+    future.waitForFinished();
+}
+
+QString TouchFilePrefetcher::sourceKey(const QString &filePath, const ParseSettings &settings,
+                                       const QVector<QVector<QString>> &patterns)
+{
+    QFileInfo info(filePath);
+    if (!info.isFile()) {
+        return QString();
+    }
+
+    QStringList parts;
+    parts << info.absoluteFilePath()
+          << QString::number(info.size())
+          << QString::number(info.lastModified().toMSecsSinceEpoch())
+          << QString::number(settings.rxCount) << QString::number(settings.txCount)
+          << QString::number(settings.rawDataPos) << QString::number(settings.filterStartPos)
+          << QString::number(settings.filterMode) << QString::number(settings.isBigEndian)
+          << QString::number(settings.maxRows) << QString::number(settings.inputFormat)
+          << QString::number(settings.timestampPos) << QString::number(settings.timestampBytes)
+          << QString::number(settings.timestampUnitUs)
+          << QString::number(settings.sequencePos) << QString::number(settings.sequenceBytes);
+    for (const QVector<QString> &pattern : patterns) {
+        QStringList bytes;
+        for (const QString &byte : pattern) {
+            bytes << byte;
+        }
+        parts << bytes.join(' ');
+    }
+    return parts.join('|');
+}
+
+void TouchFilePrefetcher::start(const QString &filePath, const ParseSettings &settings,
+                                const QVector<QVector<QString>> &patterns)
+{
+    discard();
+    key = sourceKey(filePath, settings, patterns);
+    if (key.isEmpty() || patterns.isEmpty()) {
+        key.clear();
+        return;
+    }
+
+    cancel.reset(new QAtomicInt(0));
+    const QSharedPointer<QAtomicInt> stop = cancel;
+    future = QtConcurrent::run([filePath, settings, patterns, stop]() {
+        Result result;
+        result.streams.resize(qMax(1, patterns.size()));
+        if (patterns.size() > 1) {
+            QVector<FrameStore *> stores;
+            for (FrameStore &store : result.streams) {
+                stores.append(&store);
+            }
+            result.status = TouchDataParser::readStreams(filePath, settings, patterns, stores,
+                                                         &result.diagnostics, stop.data());
+        } else {
+            result.status = TouchDataParser::readFrames(filePath, settings, result.streams[0], &result.diagnostics,
+                                                        stop.data());
+        }
+        return result;
+    });
+}
+
+bool TouchFilePrefetcher::take(const QString &filePath, const ParseSettings &settings,
+                               const QVector<QVector<QString>> &patterns,
+                               TouchDataParser::Status &status, QVector<FrameStore> &streams,
+                               ParseDiagnostics &diagnostics)
+{
+    if (key.isEmpty()) {
+        return false;
+    }
+    if (key != sourceKey(filePath, settings, patterns)) {
+        discard();
+        return false;
+    }
+
+    // 预读只用一次，之后的读取按正常流程重新解析
+    Result result = future.result();
+    discard();
+    status = result.status;
+    streams = result.streams;
+    diagnostics = result.diagnostics;
+    return true;
+}
+
+void TouchFilePrefetcher::discard()
+{
+    // 仍在解析时不等待：置位后工作线程在下一批行处返回，不完整的结果随最后一个 future 引用释放；
+    // 任务持有参数和取消标志的副本，不引用预读器本身
+    if (cancel) {
+        cancel->storeRelaxed(1);
+        cancel.reset();
+    }
+    key.clear();
+    future = QFuture<Result>();
+}
@@ -0,0 +1,46 @@
+#ifndef TOUCHFILEPREFETCHER_H
+#define TOUCHFILEPREFETCHER_H
+
+#include <QAtomicInt>
+#include <QFuture>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+#include "framestore.h"
+#include "touchdataparser.h"
+
+// 上次使用的触摸数据文件的后台预读：按当前解析参数在工作线程中解析一遍，
+// 点击"读取"时文件（路径、大小、修改时间）和参数都没有变化就直接取用结果
+class TouchFilePrefetcher
+{
+public:
+    ~TouchFilePrefetcher();
+
+    // patterns 只有一组时按 settings.pattern 读取，多组时分流读取（与 FunctionPage::readTouchData 相同）
+    void start(const QString &filePath, const ParseSettings &settings, const QVector<QVector<QString>> &patterns);
+
+    // 与预读时一致则取出结果（仍在解析时等待完成）并返回 true，streams 每种扫描类型一项；
+    // diagnostics 同时取出预读时的解析诊断；不一致时丢弃预读结果并返回 false
+    bool take(const QString &filePath, const ParseSettings &settings, const QVector<QVector<QString>> &patterns,
+              TouchDataParser::Status &status, QVector<FrameStore> &streams, ParseDiagnostics &diagnostics);
+
+    // 仍在解析时通知工作线程停止（不等待），之后的同步解析不会与过期的预读同时扫描文件
+    void discard();
+
+private:
+    struct Result
+    {
+        TouchDataParser::Status status = TouchDataParser::OpenFailed;
+        QVector<FrameStore> streams;
+        ParseDiagnostics diagnostics;
+    };
+
+    static QString sourceKey(const QString &filePath, const ParseSettings &settings,
+                             const QVector<QVector<QString>> &patterns);
+
+    QFuture<Result> future;
+    QSharedPointer<QAtomicInt> cancel;   // 与工作线程共享，丢弃预读时置位
+    QString key;                 // 空表示没有预读
+};
+
+#endif // TOUCHFILEPREFETCHER_H
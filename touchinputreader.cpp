@@ -0,0 +1,35 @@
+#include "touchinputreader.h"
+#include "csvinputreader.h"
+#include "binaryinputreader.h"
+
+// 自动识别时检查的文件开头字节数
+static const int kSniffBytes = 4096;
+
+const TouchInputReader &TouchInputReader::select(const ParseSettings &settings, const char *begin, const char *end)
+{
+    // 读取器没有状态，各格式共用一个实例
+    static const CsvInputReader csvReader;
+    static const BinaryInputReader binaryReader;
+
+    int format = settings.inputFormat;
+    if (format != ParseSettings::TextFormat && format != ParseSettings::BinaryFormat) {
+        format = detectFormat(begin, end);
+    }
+    if (format == ParseSettings::BinaryFormat) {
+        return binaryReader;
+    }
+    return csvReader;
+}
+
+ParseSettings::InputFormat TouchInputReader::detectFormat(const char *begin, const char *end)
+{
+    // 十六进制文本只含可打印字符和空白，出现其他控制字节（含 0）即视为二进制
+    const char *limit = begin + qMin<qint64>(end - begin, kSniffBytes);
+    for (const char *p = begin; p < limit; ++p) {
+        const uchar c = uchar(*p);
+        if (c < 0x20 && c != '\t' && c != '\n' && c != '\r' && c != '\v' && c != '\f') {
+            return ParseSettings::BinaryFormat;
+        }
+    }
+    return ParseSettings::TextFormat;
+}
@@ -0,0 +1,62 @@
+#ifndef TOUCHINPUTREADER_H
+#define TOUCHINPUTREADER_H
+
+#include <QVector>
+#include <QString>
+#include "touchdataparser.h"
+
+class FrameStore;
+
+// 触摸数据文件格式的读取器：TouchDataParser 负责打开文件（内存映射）、准备帧存储，
+// 帧头匹配和数据解码交给对应格式的读取器，读取器直接在映射的字节上工作，不复制文件内容
+class TouchInputReader
+{
+public:
+    virtual ~TouchInputReader() {}
+
+    // 单遍分流读取，语义与 TouchDataParser::readStreams 相同；stores 已按 settings 重置
+    virtual void readStreams(const char *begin, const char *end, const ParseSettings &settings,
+                             const QVector<QVector<QString>> &patterns, const QVector<FrameStore *> &stores,
+                             ParseDiagnostics *diagnostics, const QAtomicInt *cancel) const = 0;
+
+    // 读取第一条匹配帧，语义与 TouchDataParser::readFirstFrame 相同
+    virtual TouchDataParser::Status readFirstFrame(const char *begin, const char *end, const ParseSettings &settings,
+                                                   QVector<qint16> &frame, int *decodedCount) const = 0;
+
+    // 按 settings.inputFormat 选择读取器；自动识别时由 detectFormat 根据文件开头判断
+    static const TouchInputReader &select(const ParseSettings &settings, const char *begin, const char *end);
+    static ParseSettings::InputFormat detectFormat(const char *begin, const char *end);
+
+protected:
+    // 每读 kCancelCheckRows 行（记录）检查一次取消标志，读原子量的开销分摊到整批行上
+    static const quint32 kCancelCheckRows = 4096;
+    static bool isCancelled(const QAtomicInt *cancel, quint32 row)
+    {
+        return cancel && row % kCancelCheckRows == 0 && cancel->loadRelaxed();
+    }
+};
+
+// 时间戳计数器回绕时累加一个周期，保证时间戳单调不减（各格式共用）
+class TimestampUnwrapper
+{
+public:
+    explicit TimestampUnwrapper(int timestampBytes = 8)
+        : bits(8 * qBound(1, timestampBytes, 8)), last(0), epoch(0) {}
+
+    // hasPrevious 为 false 时（该类型还没有存下的帧）不判断回绕
+    quint64 unwrap(quint64 value, bool hasPrevious)
+    {
+        if (hasPrevious && bits < 64 && value < last) {
+            epoch += quint64(1) << bits;
+        }
+        last = value;
+        return epoch + value;
+    }
+
+private:
+    int bits;
+    quint64 last;
+    quint64 epoch;
+};
+
+#endif // TOUCHINPUTREADER_H
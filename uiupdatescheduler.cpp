@@ -0,0 +1,66 @@
+#include "uiupdatescheduler.h"
+#include <QWidget>
+#include <QWindow>
+#include <QScreen>
+#include <QGuiApplication>
+
+UiUpdateScheduler::UiUpdateScheduler(QWidget *owner)
+    : QObject(owner)
+    , owner(owner)
+    , lastFlush(-1)
+{
+    timer.setSingleShot(true);
+    timer.setTimerType(Qt::PreciseTimer);
+    connect(&timer, &QTimer::timeout, this, &UiUpdateScheduler::flushNow);
+    clock.start();
+}
+
+void UiUpdateScheduler::request(Parts parts)
+{
+    pending |= parts;
+    if (timer.isActive()) {
+        return;
+    }
+
+    // 距上次刷新不足一个刷新周期时，推迟到下一个周期；空闲后的首次请求在下一轮事件循环执行
+    const qint64 interval = refreshIntervalMs();
+    const qint64 sinceLast = lastFlush < 0 ? interval : clock.elapsed() - lastFlush;
+    timer.start(int(qMax<qint64>(0, interval - sinceLast)));
+}
+
+void UiUpdateScheduler::flushNow()
+{
+    timer.stop();
+    if (!pending) {
+        return;
+    }
+
+    Parts parts = pending;
+    pending = Parts();
+    lastFlush = clock.elapsed();
+    emit flushRequested(parts);
+}
+
+void UiUpdateScheduler::cancel()
+{
+    timer.stop();
+    pending = Parts();
+}
+
+int UiUpdateScheduler::refreshIntervalMs() const
+{
+    // 以控件当前所在屏幕的刷新率为准，取不到时按 60Hz
+    QScreen *screen = nullptr;
+    if (QWindow *window = owner->window()->windowHandle()) {
+        screen = window->screen();
+    }
+    if (!screen) {
+        screen = QGuiApplication::primaryScreen();
+    }
+
+    qreal rate = screen ? screen->refreshRate() : 60.0;
+    if (rate < 1.0) {
+        rate = 60.0;
+    }
+    return qMax(1, int(1000.0 / rate));
+}
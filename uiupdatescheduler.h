@@ -0,0 +1,46 @@
+#ifndef UIUPDATESCHEDULER_H
+#define UIUPDATESCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class QWidget;
+
+// 界面刷新合并：各处只标记哪些部分需要更新，每个屏幕刷新周期最多刷新一次
+// 播放速度再快，控件更新次数也不会超过显示器刷新率
+class UiUpdateScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Part {
+        FramePart = 0x1,        // 数据区（表格/热力图）
+        ButtonsPart = 0x2,      // 播放控制按钮
+        ProgressPart = 0x4,     // 进度条和帧号
+        AllParts = FramePart | ButtonsPart | ProgressPart
+    };
+    Q_DECLARE_FLAGS(Parts, Part)
+
+    explicit UiUpdateScheduler(QWidget *owner);
+
+    void request(Parts parts);
+    void flushNow();            // 立即执行挂起的更新（例如停止播放时）
+    void cancel();
+
+signals:
+    void flushRequested(UiUpdateScheduler::Parts parts);
+
+private:
+    int refreshIntervalMs() const;
+
+    QWidget *owner;
+    QTimer timer;
+    QElapsedTimer clock;
+    qint64 lastFlush;
+    Parts pending;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(UiUpdateScheduler::Parts)
+
+#endif // UIUPDATESCHEDULER_H